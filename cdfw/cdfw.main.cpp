@@ -16,47 +16,100 @@
 #include <lvgl.h>
 
 // C++ Standard Library Headers
+#include <cstddef>
 #include <cstdint>
+#include <ctime>
 #include <iostream>
 #include <memory>
 
 namespace cdfw {
-// Hawdware.
+// Built screens kept in the LVGL heap (LV_MEM_SIZE) at once. Screens beyond it
+// are deleted, least recently shown first, and rebuilt when next shown.
+constexpr std::size_t kScreenCacheBudget = 48 * 1024;
+
+// Bytes in use in the heaps that boot allocates from: LVGL's, once it is
+// initialized, and on the device the system heap.
+std::size_t HeapUsage() {
+  std::size_t used = 0;
+  if (lv_is_initialized()) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    used += mon.total_size - mon.free_size;
+  }
+#ifdef ARDUINO
+  used += ESP.getHeapSize() - ESP.getFreeHeap();
+#endif // ARDUINO
+  return used;
+}
+
+// Boot. The display comes up on the UI loop while the I/O worker, on the other
+// core, mounts and loads the card; each side is timed by its own profiler.
+std::unique_ptr<BootProfiler> boot_profiler = BootProfiler::Create(
+    []() { return static_cast<std::uint32_t>(micros()); }, HeapUsage);
+std::unique_ptr<BootProfiler> storage_profiler = BootProfiler::Create(
+    []() { return static_cast<std::uint32_t>(micros()); }, HeapUsage);
+std::uint32_t first_pixel_us = 0;
+std::uint32_t interactive_us = 0;
+
+// Hawdware. The card is mounted by a job on the I/O worker; `sd` and
+// `write_back` are only read on the UI loop once `storage_ready`.
 std::unique_ptr<hal::Touchscreen> touchscreen = nullptr;
 std::shared_ptr<vfs::Volume> sd = nullptr;
+std::shared_ptr<vfs::WriteBackVolume> write_back = nullptr;
+
+// Storage. Once the GUI is up, the routine store, run log and run stats are
+// only touched by jobs on the I/O worker.
+bool storage_ready = false;
+std::shared_ptr<IoWorker> io_worker = nullptr;
+std::shared_ptr<RoutineStore> routine_store = nullptr;
+std::shared_ptr<RunLog> run_log = nullptr;
+std::shared_ptr<RunStats> run_stats = nullptr;
+std::unique_ptr<VolumeStatsSampler> volume_stats = nullptr;
+
+// Models.
+std::unique_ptr<core::ui::RunStatsModel> run_stats_model = nullptr;
 
 // Presenters.
 std::unique_ptr<core::ui::AppPresenter> app_presenter = nullptr;
 
-void InitHardware() {
+// Brings up the display and shows the boot screen.
+void InitDisplay() {
   Serial.begin(115200);
 
   // Initialise LVGL.
+  boot_profiler->Begin("lvgl");
   lv_init();
   // mem_report();
 
-  // Hardware is initialized on creation.
+  // Hardware is initialized on creation. This also creates the display.
+  boot_profiler->Begin("touch");
   touchscreen = hal::Touchscreen::Create();
-  sd = hal::SD::CreateVolume();
-
-  // Initialize app directories.
-  // sd->RemoveAll("/sd/"); // TEMP: Clear the SD card.
-  DirManager(sd).CreateDirs(sd->MountPoint());
-
-  // Playing around with SD card functionality.
-  // Note: This section is temporary.
-  sd->PrintInfo();
-  sd->Walk();
-}
 
-void InitGUI() {
-  // The boot screen is shown as soon as it is initialized. After that, we have
-  // no use for the wrapping classes, so we let them destruct after use.
+  // The boot screen is drawn straight away rather than on the first loop().
+  // After that, we have no use for the wrapping classes, so we let them
+  // destruct after use.
+  boot_profiler->Begin("boot_view");
   core::ui::BootPresenter::Create(gui::screen::BootView::Create(),
                                   core::ui::BootModel::Create())
       ->Init();
+  lv_refr_now(nullptr);
+  boot_profiler->End();
+  first_pixel_us = boot_profiler->Mark("first_pixel");
+}
+
+// Builds the GUI and shows the home screen. Runs from the I/O worker's Poll()
+// once the stores it needs are loaded; the card housekeeping queued behind
+// them may still be running.
+void InitGUI(const BootStorage &storage) {
+  boot_profiler->Begin("home_view");
+  routine_store = storage.routine_store;
+  run_log = storage.run_log;
+  run_stats = storage.run_stats;
+  storage_ready = true;
+
+  // Card usage for the UI, sampled in the background.
+  volume_stats = VolumeStatsSampler::Create(sd, io_worker);
 
-  // Initialize the other GUI components.
   auto settings_model = core::ui::SettingsModel::Create();
   app_presenter = core::ui::AppPresenter::Create(
       core::ui::HomePresenter::Create(
@@ -64,14 +117,89 @@ void InitGUI() {
           core::ui::HomeModel::Create(settings_model)),
       core::ui::CleanPresenter::Create(gui::screen::CleanView::Create(),
                                        core::ui::CleanModel::Create()),
-      core::ui::RoutinesPresenter::Create(gui::screen::RoutinesView::Create(),
-                                          core::ui::RoutinesModel::Create()),
+      core::ui::RoutinesPresenter::Create(
+          gui::screen::RoutinesView::Create(),
+          core::ui::RoutinesModel::Create(routine_store, io_worker)),
       core::ui::SettingsPresenter::Create(gui::screen::SettingsView::Create(),
-                                          settings_model));
+                                          settings_model),
+      core::ui::ScreenCache::Create(kScreenCacheBudget, []() {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return static_cast<std::size_t>(mon.total_size - mon.free_size);
+      }));
+  // Only the home screen is built now; the others wait until they are shown.
   app_presenter->Init();
 
-  // Initialization for the home screen queues a delayed show.
-  app_presenter->ShowHomeDelayed();
+  // Finished runs are recorded through the run stats model.
+  run_stats_model =
+      core::ui::RunStatsModel::Create(run_log, run_stats, io_worker);
+
+  // The boot screen has been up while the card was read, so home is shown as
+  // soon as it is ready. The boot screen is the display's default screen and
+  // is not shown again, so it is deleted to give its memory back to LVGL.
+  lv_obj_t *boot_scr = lv_screen_active();
+  app_presenter->ShowHome();
+  lv_obj_delete(boot_scr);
+  lv_refr_now(nullptr);
+  boot_profiler->End();
+  interactive_us = boot_profiler->Mark("interactive");
+
+  // Run log segments past the retention policy are dropped once home is up.
+  // It is queued here rather than beside the sd_info job because `run_log` is
+  // only set on this thread.
+  const auto now = static_cast<std::uint32_t>(std::time(nullptr));
+  io_worker->Submit([now]() {
+    run_log->Compact(now);
+    return true;
+  });
+}
+
+// Reports where boot time went, on Serial and in the data dir. Runs on the UI
+// loop once the storage phases are done, so the card is written from a job.
+// Nothing touches the profiler after boot, so the job may read it.
+void ReportBoot() {
+  boot_profiler->Merge(*storage_profiler);
+  boot_profiler->Print();
+  Serial.printf("Time to first pixel %lu us, to interactive home %lu us\n",
+                static_cast<unsigned long>(first_pixel_us),
+                static_cast<unsigned long>(interactive_us));
+  const auto wall_time = static_cast<std::uint32_t>(std::time(nullptr));
+  io_worker->Submit([wall_time]() {
+    return boot_profiler->Append(
+        *sd, DirLayout(sd->MountPoint()).data_dir / "boot.bin", wall_time);
+  });
+}
+
+// Starts the card work on the I/O worker, off the UI loop. The card and the
+// display are on separate SPI buses, so neither waits on the other.
+void InitStorage() {
+  boot_profiler->Begin("io_worker");
+  io_worker = IoWorker::Create();
+
+  SubmitBootStorage(
+      *io_worker,
+      []() {
+        // Small writes are held in RAM and reach the card in batches.
+        write_back = vfs::WriteBackVolume::Create(hal::SD::CreateVolume());
+        sd = write_back;
+        // sd->RemoveAll("/sd/"); // TEMP: Clear the SD card.
+        return sd;
+      },
+      *storage_profiler, InitGUI);
+
+  // Playing around with SD card functionality. Nothing waits on it, so it is
+  // queued behind the stores and the boot report follows it.
+  // Note: This section is temporary.
+  io_worker->Submit(
+      []() {
+        storage_profiler->Begin("sd_info");
+        sd->PrintInfo();
+        sd->Walk();
+        storage_profiler->End();
+        return true;
+      },
+      [](bool, const IoLatency &) { ReportBoot(); });
+  boot_profiler->End();
 }
 } // namespace cdfw
 
@@ -85,6 +213,21 @@ void loop() {
   // Update the UI.
   lv_timer_handler();
 
+  // Deliver the results of finished background I/O, then queue more. Until
+  // boot has loaded the card, it is only touched by the worker.
+  cdfw::io_worker->Poll();
+  if (cdfw::storage_ready) {
+    cdfw::volume_stats->Tick(millis());
+
+    // Write out cached writes once they have aged.
+    static bool flush_queued = false;
+    if (!flush_queued && cdfw::write_back->FlushDue()) {
+      flush_queued = cdfw::io_worker->Submit(
+          []() { return cdfw::write_back->Flush(); },
+          [](bool, const cdfw::IoLatency &) { flush_queued = false; });
+    }
+  }
+
   // Delay seems to be suggested by others online, but I'm not sure on its
   // purpose/implications. Therefore, I'm currently not able to make a judgement
   // call on the delay time.
@@ -97,8 +240,9 @@ void setup() {
 int main() {
 #endif // ARDUINO
 
-  cdfw::InitHardware();
-  cdfw::InitGUI();
+  // The GUI follows from loop(), once the card is loaded.
+  cdfw::InitDisplay();
+  cdfw::InitStorage();
 
 #ifndef ARDUINO
   while (true) {
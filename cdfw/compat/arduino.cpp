@@ -23,6 +23,13 @@ SimulatedSerial Serial;
 
 unsigned long millis() { return SDL_GetTicks(); }
 
+unsigned long micros() {
+  static const std::uint64_t freq = SDL_GetPerformanceFrequency();
+  const std::uint64_t ticks = SDL_GetPerformanceCounter();
+  // Split the conversion so that the multiplication cannot overflow.
+  return (ticks / freq) * 1000000 + (ticks % freq) * 1000000 / freq;
+}
+
 void delay(std::uint32_t ms) { SDL_Delay(ms); }
 
 void SimulatedSerial::begin(unsigned long) { return; }
@@ -20,6 +20,7 @@
 // FREE FUNCTIONS
 
 unsigned long millis();
+unsigned long micros();
 void delay(std::uint32_t ms);
 
 // CLASSES
@@ -0,0 +1,247 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/boot_profiler.h"
+#include "cdfw/compat/arduino.h"
+#include "cdfw/core/crc32.h"
+#include "cdfw/core/span.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace cdfw {
+namespace {
+// Record layout (all integers little-endian):
+//   [ 0,  4) magic, "CDBT"
+//   [ 4,  5) format version
+//   [ 5,  6) phase count, n
+//   [ 6,  8) reserved, zero
+//   [ 8, 12) wall time
+//   [12, 16) total time, us
+//   [16, 16 + 24n) phases:
+//     [ 0, 12) name, NUL padded
+//     [12, 16) start, us
+//     [16, 20) duration, us
+//     [20, 24) heap delta, bytes
+//   [16 + 24n, 20 + 24n) CRC-32 of the bytes before it
+constexpr std::uint8_t kMagic[4] = {'C', 'D', 'B', 'T'};
+constexpr std::uint8_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 16;
+constexpr std::size_t kPhaseSize = 24;
+constexpr std::size_t kNameSize = 12;
+constexpr std::size_t kCrcSize = 4;
+constexpr std::size_t kMaxRecordSize =
+    kHeaderSize + BootProfiler::kMaxPhases * kPhaseSize + kCrcSize;
+static_assert(BootPhase::kMaxNameLength < kNameSize,
+              "Names must leave room for a NUL.");
+static_assert(BootProfiler::kMaxPhases <= 0xff,
+              "The phase count must fit a byte.");
+
+void PutU32(std::uint8_t *p, std::uint32_t v) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+  }
+}
+
+std::uint32_t GetU32(const std::uint8_t *p) {
+  std::uint32_t v = 0;
+  for (std::size_t i = 0; i < 4; ++i) {
+    v |= std::uint32_t{p[i]} << (8 * i);
+  }
+  return v;
+}
+
+std::size_t RecordSize(std::size_t phases) {
+  return kHeaderSize + phases * kPhaseSize + kCrcSize;
+}
+
+class BootProfilerImpl : public BootProfiler {
+public:
+  BootProfilerImpl(Clock clock, HeapUsage heap_usage)
+      : clock_(clock), heap_usage_(heap_usage), running_(false),
+        origin_us_(clock_()), start_heap_(0) {
+    phases_.reserve(kMaxPhases);
+  }
+  virtual ~BootProfilerImpl() = default;
+
+  virtual void Begin(const char *name) override final {
+    // Out of room, so the running phase carries on.
+    if (running_ && phases_.size() + 1 >= kMaxPhases) {
+      return;
+    }
+    End();
+
+    current_ = BootPhase{};
+    current_.name = name;
+    current_.start_us = clock_() - origin_us_;
+    start_heap_ = heap_usage_();
+    running_ = true;
+  }
+
+  virtual void End() override final {
+    if (!running_) {
+      return;
+    }
+    const std::uint32_t now_us = clock_();
+    const std::int64_t delta = static_cast<std::int64_t>(heap_usage_()) -
+                               static_cast<std::int64_t>(start_heap_);
+    current_.duration_us = now_us - origin_us_ - current_.start_us;
+    current_.heap_delta = static_cast<std::int32_t>(std::clamp<std::int64_t>(
+        delta, std::numeric_limits<std::int32_t>::min(),
+        std::numeric_limits<std::int32_t>::max()));
+    Add(current_);
+    running_ = false;
+  }
+
+  virtual std::uint32_t Mark(const char *name) override final {
+    BootPhase mark{};
+    mark.name = name;
+    mark.start_us = clock_() - origin_us_;
+    Add(mark);
+    return mark.start_us;
+  }
+
+  virtual void Merge(const BootProfiler &other) override final {
+    const std::uint32_t offset_us = other.OriginUs() - origin_us_;
+    for (BootPhase phase : other.Phases()) {
+      phase.start_us += offset_us;
+      Add(phase);
+    }
+  }
+
+  virtual const std::vector<BootPhase> &Phases() const override final {
+    return phases_;
+  }
+
+  virtual std::uint32_t TotalUs() const override final {
+    std::uint32_t total_us = 0;
+    for (const auto &phase : phases_) {
+      total_us = std::max(total_us, phase.start_us + phase.duration_us);
+    }
+    return total_us;
+  }
+
+  virtual std::uint32_t OriginUs() const override final { return origin_us_; }
+
+  virtual void Print() const override final {
+    Serial.printf("Boot took %lu us over %u phases\n",
+                  static_cast<unsigned long>(TotalUs()),
+                  static_cast<unsigned>(phases_.size()));
+    for (const auto &phase : phases_) {
+      Serial.printf("  %-11s at %9lu us took %9lu us heap %+ld B\n",
+                    phase.name.c_str(),
+                    static_cast<unsigned long>(phase.start_us),
+                    static_cast<unsigned long>(phase.duration_us),
+                    static_cast<long>(phase.heap_delta));
+    }
+  }
+
+  virtual bool Append(vfs::Volume &volume, const vfs::Path &path,
+                      std::uint32_t wall_time) const override final {
+    std::uint8_t record[kMaxRecordSize] = {};
+    const std::size_t size = RecordSize(phases_.size());
+    std::memcpy(record, kMagic, sizeof(kMagic));
+    record[4] = kVersion;
+    record[5] = static_cast<std::uint8_t>(phases_.size());
+    PutU32(record + 8, wall_time);
+    PutU32(record + 12, TotalUs());
+    std::uint8_t *p = record + kHeaderSize;
+    for (const auto &phase : phases_) {
+      std::memcpy(p, phase.name.c_str(), phase.name.size());
+      PutU32(p + 12, phase.start_us);
+      PutU32(p + 16, phase.duration_us);
+      PutU32(p + 20, static_cast<std::uint32_t>(phase.heap_delta));
+      p += kPhaseSize;
+    }
+    PutU32(p, Crc32(record, size - kCrcSize));
+
+    // Unbuffered, so the record goes to the backend as one write. A full file
+    // is started afresh.
+    auto file = volume.OpenAppend(path);
+    if (file.Size() + size > kMaxReportBytes) {
+      file.Close();
+      file = volume.OpenWrite(path);
+    }
+    bool ok = file.Write(ConstByteSpan(record, size)) == size && file.Sync();
+    return file.Close() && ok;
+  }
+
+private:
+  Clock clock_;
+  HeapUsage heap_usage_;
+  std::vector<BootPhase> phases_;
+  BootPhase current_;
+  bool running_;
+  const std::uint32_t origin_us_;
+  std::size_t start_heap_;
+
+  // Keeps the phases in start order. Phases past kMaxPhases are dropped.
+  void Add(const BootPhase &phase) {
+    if (phases_.size() == kMaxPhases) {
+      return;
+    }
+    auto it = std::upper_bound(
+        phases_.begin(), phases_.end(), phase,
+        [](const BootPhase &lhs, const BootPhase &rhs) {
+          return lhs.start_us < rhs.start_us;
+        });
+    phases_.insert(it, phase);
+  }
+};
+} // namespace
+
+std::unique_ptr<BootProfiler> BootProfiler::Create(Clock clock,
+                                                   HeapUsage heap_usage) {
+  return std::make_unique<BootProfilerImpl>(clock, heap_usage);
+}
+
+std::vector<BootReport> ReadBootReports(vfs::Volume &volume,
+                                        const vfs::Path &path) {
+  std::vector<BootReport> reports;
+  std::uint8_t buf[vfs::File::kSectorSize];
+  auto file = volume.OpenRead(path, ByteSpan(buf, sizeof(buf)));
+  std::uint8_t record[kMaxRecordSize];
+  while (file.Read(ByteSpan(record, kHeaderSize)) == kHeaderSize) {
+    // Without a header there is no telling where the next record starts.
+    const std::size_t phases = record[5];
+    if (std::memcmp(record, kMagic, sizeof(kMagic)) != 0 ||
+        record[4] != kVersion || phases > BootProfiler::kMaxPhases) {
+      break;
+    }
+    const std::size_t size = RecordSize(phases);
+    if (file.Read(ByteSpan(record + kHeaderSize, size - kHeaderSize)) !=
+        size - kHeaderSize) {
+      break;
+    }
+    if (GetU32(record + size - kCrcSize) != Crc32(record, size - kCrcSize)) {
+      continue;
+    }
+
+    BootReport report;
+    report.wall_time = GetU32(record + 8);
+    report.total_us = GetU32(record + 12);
+    const std::uint8_t *p = record + kHeaderSize;
+    for (std::size_t i = 0; i < phases; ++i, p += kPhaseSize) {
+      BootPhase phase;
+      std::string_view name(reinterpret_cast<const char *>(p), kNameSize);
+      phase.name = name.substr(0, name.find('\0'));
+      phase.start_us = GetU32(p + 12);
+      phase.duration_us = GetU32(p + 16);
+      phase.heap_delta = static_cast<std::int32_t>(GetU32(p + 20));
+      report.phases.push_back(phase);
+    }
+    reports.push_back(report);
+  }
+  return reports;
+}
+} // namespace cdfw
@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_BOOT_PROFILER_H
+#define CDFW_CORE_BOOT_PROFILER_H
+
+// Times the steps of boot.
+//
+// Boot is split into named phases. Begin() ends the running phase, if any, and
+// starts the next, so back to back phases need no End() between them. Each
+// phase records when it started, relative to the profiler's creation, how long
+// it took and how much the heap grew (or shrank) while it ran. Mark() records
+// a milestone, such as the first frame, as a phase that takes no time.
+//
+// A profiler is not thread-safe. Steps that run on another thread are timed by
+// a profiler of their own, which is merged in once they are done. The heap is
+// shared, so the heap deltas of phases that overlap include each other's
+// allocations.
+//
+// Once boot is done, Print() writes a summary to Serial and Append() adds a
+// compact record of the boot to a report file, which ReadBootReports() reads
+// back.
+
+// Local Headers
+#include "cdfw/core/inline_string.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+struct BootPhase {
+  static constexpr std::size_t kMaxNameLength = 11;
+
+  InlineString<kMaxNameLength> name; // Longer names are cut short.
+  std::uint32_t start_us;            // Since the profiler was created.
+  std::uint32_t duration_us;
+  std::int32_t heap_delta; // Bytes; negative if the phase freed memory.
+};
+
+// One boot, as read back from a report file.
+struct BootReport {
+  std::uint32_t wall_time; // Seconds since the Unix epoch, 0 if unknown.
+  std::uint32_t total_us;
+  std::vector<BootPhase> phases;
+};
+
+class BootProfiler {
+public:
+  static constexpr std::size_t kMaxPhases = 24;
+  // Report files are started afresh rather than grown past this.
+  static constexpr std::size_t kMaxReportBytes = 8 * 1024;
+
+  // Returns a monotonic time in microseconds, e.g. micros().
+  typedef std::function<std::uint32_t()> Clock;
+  // Returns the bytes in use in the heap.
+  typedef std::function<std::size_t()> HeapUsage;
+
+  // Factory method. Phases are timed from now.
+  static std::unique_ptr<BootProfiler> Create(Clock clock,
+                                              HeapUsage heap_usage);
+
+  // Virtual destructor.
+  virtual ~BootProfiler() = default;
+
+  // Ends the running phase and starts one called `name`. Phases past
+  // kMaxPhases are folded into the last one.
+  virtual void Begin(const char *name) = 0;
+
+  // Ends the running phase.
+  virtual void End() = 0;
+
+  // Records a milestone called `name`, without ending the running phase.
+  // Returns its time.
+  virtual std::uint32_t Mark(const char *name) = 0;
+
+  // Adds the finished phases of `other`, which must use the same clock.
+  virtual void Merge(const BootProfiler &other) = 0;
+
+  // The finished phases and milestones, in the order they started.
+  virtual const std::vector<BootPhase> &Phases() const = 0;
+
+  // From the profiler's creation to the end of the last finished phase.
+  virtual std::uint32_t TotalUs() const = 0;
+
+  // The clock reading that phases are timed from.
+  virtual std::uint32_t OriginUs() const = 0;
+
+  // Writes the finished phases to Serial.
+  virtual void Print() const = 0;
+
+  // Appends a record of the finished phases to the file at `path` as one
+  // write. `wall_time` is in seconds since the Unix epoch, 0 if unknown.
+  virtual bool Append(vfs::Volume &volume, const vfs::Path &path,
+                      std::uint32_t wall_time) const = 0;
+};
+
+// Reads the records written by BootProfiler::Append() to the file at `path`,
+// oldest first. Records torn by a power cut are skipped.
+std::vector<BootReport> ReadBootReports(vfs::Volume &volume,
+                                        const vfs::Path &path);
+} // namespace cdfw
+
+#endif // CDFW_CORE_BOOT_PROFILER_H
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/boot_storage.h"
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/dir_manager.h"
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/routine.h"
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace cdfw {
+BootStorage LoadBootStorage(std::shared_ptr<vfs::Volume> volume,
+                            BootProfiler &profiler) {
+  BootStorage storage;
+  const DirLayout layout(volume->MountPoint());
+
+  // Initialize app directories.
+  profiler.Begin("dirs");
+  DirManager(volume).CreateDirs(volume->MountPoint());
+
+  // Finish or roll back any save interrupted by a power cut.
+  profiler.Begin("recover");
+  volume->RecoverAtomicWrites();
+
+  // Build the routine index. A fresh card starts with the factory default.
+  profiler.Begin("routines");
+  storage.routine_store = RoutineStore::Create(volume, layout);
+  storage.routine_store->Load();
+  if (storage.routine_store->List().empty()) {
+    storage.routine_store->Put(Routine::GetDefault());
+  }
+
+  // Cleaning runs are recorded in the data dir. Compacting it writes to the
+  // card and nothing on screen needs it, so it is left to the caller.
+  profiler.Begin("run_log");
+  storage.run_log = RunLog::Create(volume, layout);
+  storage.run_log->Load();
+
+  // Per-routine statistics are kept up to date as runs are recorded, so only
+  // the totals are read at boot.
+  profiler.Begin("run_stats");
+  storage.run_stats = RunStats::Create(volume, layout);
+  storage.run_stats->Load();
+
+  profiler.End();
+  return storage;
+}
+
+bool SubmitBootStorage(IoWorker &worker, MountVolume mount,
+                       BootProfiler &profiler, BootStorageReady ready) {
+  // Handed from the job to its completion; the worker orders the two.
+  auto storage = std::make_shared<BootStorage>();
+  return worker.Submit(
+      [mount, &profiler, storage]() {
+        profiler.Begin("sd_mount");
+        auto volume = mount();
+        *storage = LoadBootStorage(volume, profiler);
+        return true;
+      },
+      [ready, storage](bool, const IoLatency &) { ready(*storage); });
+}
+} // namespace cdfw
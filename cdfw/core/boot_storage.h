@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_BOOT_STORAGE_H
+#define CDFW_CORE_BOOT_STORAGE_H
+
+// Local Headers
+#include "cdfw/core/boot_profiler.h"
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/routine_store.h"
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/run_stats.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace cdfw {
+// The stores read from the card at boot.
+struct BootStorage {
+  std::shared_ptr<RoutineStore> routine_store;
+  std::shared_ptr<RunLog> run_log;
+  std::shared_ptr<RunStats> run_stats;
+};
+
+// Runs the storage steps of boot on `volume`, each as a phase of `profiler`:
+// creating the app dirs, finishing interrupted saves, and loading the routine
+// index, run log and run stats. Only what the home screen needs is done here;
+// housekeeping such as RunLog::Compact() is left to later jobs.
+BootStorage LoadBootStorage(std::shared_ptr<vfs::Volume> volume,
+                            BootProfiler &profiler);
+
+// Mounts the card. Runs on the I/O worker.
+typedef std::function<std::shared_ptr<vfs::Volume>()> MountVolume;
+// Runs on the UI loop with the loaded stores.
+typedef std::function<void(const BootStorage &storage)> BootStorageReady;
+
+// Loads the storage off the UI loop, so that the display can come up while the
+// card is read. Queues a job on `worker` that runs `mount`, as the "sd_mount"
+// phase of `profiler`, then LoadBootStorage(). `ready` runs from the Poll()
+// that follows. Until then `profiler` and the mounted volume belong to the
+// job. Returns false if the job could not be queued.
+bool SubmitBootStorage(IoWorker &worker, MountVolume mount,
+                       BootProfiler &profiler, BootStorageReady ready);
+} // namespace cdfw
+
+#endif // CDFW_CORE_BOOT_STORAGE_H
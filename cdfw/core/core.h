@@ -6,11 +6,21 @@
 #define CDFW_CORE_CORE_H
 
 // Local Headers
+#include "cdfw/core/boot_profiler.h"
+#include "cdfw/core/boot_storage.h"
 #include "cdfw/core/debug.h"
 #include "cdfw/core/dir_layout.h"
 #include "cdfw/core/dir_manager.h"
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/path_buf.h"
+#include "cdfw/core/ram_volume.h"
+#include "cdfw/core/routine_store.h"
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/run_stats.h"
 #include "cdfw/core/version.h"
 #include "cdfw/core/vfs.h"
+#include "cdfw/core/volume_stats.h"
+#include "cdfw/core/write_back_volume.h"
 #include "cdfw/core/wifi.h"
 
 #include "cdfw/core/ui/app_presenter.h"
@@ -22,6 +32,8 @@
 #include "cdfw/core/ui/home_presenter.h"
 #include "cdfw/core/ui/routines_model.h"
 #include "cdfw/core/ui/routines_presenter.h"
+#include "cdfw/core/ui/run_stats_model.h"
+#include "cdfw/core/ui/screen_cache.h"
 #include "cdfw/core/ui/settings_model.h"
 #include "cdfw/core/ui/settings_presenter.h"
 
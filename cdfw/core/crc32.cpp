@@ -0,0 +1,41 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/crc32.h"
+
+// C++ Standard Library Headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cdfw {
+namespace {
+constexpr std::uint32_t kPolynomial = 0xEDB88320; // Reflected 0x04C11DB7.
+
+constexpr std::array<std::uint32_t, 256> MakeTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t c = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      c = (c & 1) ? (kPolynomial ^ (c >> 1)) : (c >> 1);
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+// Generated at compile time so that it lives in flash rather than RAM.
+constexpr std::array<std::uint32_t, 256> kTable = MakeTable();
+} // namespace
+
+std::uint32_t Crc32(const void *data, std::size_t size, std::uint32_t crc) {
+  auto bytes = static_cast<const std::uint8_t *>(data);
+  crc = ~crc;
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = kTable[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+} // namespace cdfw
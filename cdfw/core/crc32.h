@@ -0,0 +1,18 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_CRC32_H
+#define CDFW_CORE_CRC32_H
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+
+namespace cdfw {
+// Computes the CRC-32 (IEEE 802.3) checksum of the given bytes. A previous
+// result may be passed as `crc` to continue a checksum across several buffers.
+std::uint32_t Crc32(const void *data, std::size_t size, std::uint32_t crc = 0);
+} // namespace cdfw
+
+#endif // CDFW_CORE_CRC32_H
@@ -0,0 +1,81 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_INLINE_STRING_H
+#define CDFW_CORE_INLINE_STRING_H
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace cdfw {
+// Fixed-capacity, NUL-terminated string stored inline. Holds at most N
+// characters; longer input is truncated. Trivially copyable, so types built
+// from it can be copied with memcpy and never touch the heap.
+template <std::size_t N>
+class InlineString {
+public:
+  static constexpr std::size_t kCapacity = N;
+
+  // constructors
+  InlineString() noexcept : buf_{} {}
+  InlineString(const char *s) noexcept { assign(s); }
+  InlineString(std::string_view s) noexcept { assign(s); }
+  InlineString(const std::string &s) noexcept { assign(s); }
+
+  // modifiers
+  void assign(const char *s) noexcept {
+    assign(s ? std::string_view(s) : std::string_view());
+  }
+  void assign(std::string_view s) noexcept {
+    auto n = std::min(s.size(), N);
+    std::memcpy(buf_, s.data(), n);
+    std::memset(buf_ + n, 0, sizeof(buf_) - n);
+  }
+
+  // access
+  const char *c_str() const noexcept { return buf_; }
+  std::size_t size() const noexcept { return std::strlen(buf_); }
+  bool empty() const noexcept { return buf_[0] == '\0'; }
+  std::string_view view() const noexcept { return std::string_view(buf_); }
+
+  // comparators
+  friend bool operator==(const InlineString &lhs,
+                         const InlineString &rhs) noexcept {
+    return lhs.view() == rhs.view();
+  }
+  friend bool operator==(const InlineString &lhs, const char *rhs) noexcept {
+    return lhs.view() == std::string_view(rhs);
+  }
+  friend bool operator==(const InlineString &lhs,
+                         const std::string &rhs) noexcept {
+    return lhs.view() == rhs;
+  }
+  friend bool operator==(const char *lhs, const InlineString &rhs) noexcept {
+    return rhs == lhs;
+  }
+  friend bool operator==(const std::string &lhs,
+                         const InlineString &rhs) noexcept {
+    return rhs == lhs;
+  }
+  template <typename T>
+  friend bool operator!=(const InlineString &lhs, const T &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, const InlineString &s) {
+    return os << s.c_str();
+  }
+
+private:
+  char buf_[N + 1]; // Always NUL terminated; unused bytes are zero.
+};
+} // namespace cdfw
+
+#endif // CDFW_CORE_INLINE_STRING_H
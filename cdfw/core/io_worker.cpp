@@ -0,0 +1,218 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/io_worker.h"
+#include "cdfw/compat/arduino.h"
+
+// Third Party Headers
+#ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif // ARDUINO
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#ifndef ARDUINO
+#include <thread>
+#endif // ARDUINO
+
+namespace cdfw {
+namespace {
+#ifdef ARDUINO
+// The Arduino loop runs on core 1, so the worker gets core 0 to itself. The
+// stack has room for the SD driver and a FAT sector buffer.
+constexpr BaseType_t kTaskCore = 0;
+constexpr UBaseType_t kTaskPriority = 1;
+constexpr std::uint32_t kTaskStackSize = 8192;
+#endif // ARDUINO
+
+// Every request lives in one ring, in submission order. With monotonic
+// counters head_ <= run_ <= tail_:
+// - [head_, run_) have finished and wait for Poll() to run their completion.
+// - [run_, tail_) are queued; run_ is the one the worker is on, if any.
+// A slot is reused only once its completion has been taken, which is what
+// bounds the queue.
+class IoWorkerImpl : public IoWorker {
+public:
+  IoWorkerImpl(std::size_t capacity)
+      : ring_(std::max<std::size_t>(capacity, 1)), head_(0), run_(0),
+        tail_(0), stats_(), stop_(false), exited_(false) {
+#ifdef ARDUINO
+    xTaskCreatePinnedToCore(&IoWorkerImpl::TaskMain, "io_worker",
+                            kTaskStackSize, this, kTaskPriority, nullptr,
+                            kTaskCore);
+#else  // ARDUINO
+    thread_ = std::thread(&IoWorkerImpl::Run, this);
+#endif // ARDUINO
+  }
+
+  virtual ~IoWorkerImpl() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_cv_.notify_all();
+#ifdef ARDUINO
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return exited_; });
+#else  // ARDUINO
+    thread_.join();
+#endif // ARDUINO
+  }
+
+  virtual bool Submit(Job job, Completion done) override final {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (tail_ - head_ == ring_.size()) {
+        ++stats_.rejected;
+        return false;
+      }
+      Request &request = ring_[tail_ % ring_.size()];
+      request.job = std::move(job);
+      request.done = std::move(done);
+      request.submit_us = micros();
+      ++tail_;
+      ++stats_.submitted;
+    }
+    work_cv_.notify_one();
+    return true;
+  }
+
+  virtual std::size_t Poll() override final {
+    std::size_t count = 0;
+    Completion done;
+    bool ok = false;
+    IoLatency latency = {};
+
+    // Completions that land while polling wait for the next call, so that one
+    // Poll() is bounded by what had finished when it started.
+    std::size_t end;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      end = run_;
+    }
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (head_ == end) {
+          break;
+        }
+        Request &request = ring_[head_ % ring_.size()];
+        done = std::move(request.done);
+        request.done = nullptr;
+        ok = request.ok;
+        latency = request.latency;
+        ++head_;
+      }
+
+      // Run without the lock: completions may submit more work.
+      if (done) {
+        done(ok, latency);
+        done = nullptr;
+      }
+      ++count;
+    }
+    return count;
+  }
+
+  virtual void Drain() override final {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return run_ == tail_; });
+  }
+
+  virtual std::size_t Pending() const override final {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tail_ - head_;
+  }
+
+  virtual IoWorkerStats GetStats() const override final {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+private:
+  struct Request {
+    Job job;
+    Completion done;
+    std::uint32_t submit_us;
+    bool ok;
+    IoLatency latency;
+  };
+
+#ifdef ARDUINO
+  static void TaskMain(void *arg) {
+    static_cast<IoWorkerImpl *>(arg)->Run();
+    vTaskDelete(nullptr);
+  }
+#endif // ARDUINO
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      work_cv_.wait(lock, [this] { return stop_ || run_ != tail_; });
+      if (run_ == tail_) {
+        // Stopping, and everything queued has run.
+        break;
+      }
+
+      Request &request = ring_[run_ % ring_.size()];
+      Job job = std::move(request.job);
+      request.job = nullptr;
+      const std::uint32_t start_us = micros();
+      request.latency.wait_us = start_us - request.submit_us;
+
+      // Submit() never writes to this slot while it is queued, so the request
+      // can be updated after the lock is retaken.
+      lock.unlock();
+      const bool ok = job ? job() : true;
+      const std::uint32_t run_us = micros() - start_us;
+      lock.lock();
+
+      request.ok = ok;
+      request.latency.run_us = run_us;
+      ++run_;
+
+      ++stats_.completed;
+      stats_.max_wait_us = std::max(stats_.max_wait_us,
+                                    request.latency.wait_us);
+      stats_.max_run_us = std::max(stats_.max_run_us, run_us);
+      stats_.total_wait_us += request.latency.wait_us;
+      stats_.total_run_us += run_us;
+      idle_cv_.notify_all();
+    }
+
+    // Notify under the lock: once it is released the destructor may free
+    // the worker.
+    exited_ = true;
+    idle_cv_.notify_all();
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_cv_; // Signals the worker: work or stop.
+  std::condition_variable idle_cv_; // Signals waiters: a job finished.
+  std::vector<Request> ring_;
+  std::size_t head_;
+  std::size_t run_;
+  std::size_t tail_;
+  IoWorkerStats stats_;
+  bool stop_;
+  bool exited_;
+#ifndef ARDUINO
+  std::thread thread_;
+#endif // ARDUINO
+};
+} // namespace
+
+std::unique_ptr<IoWorker> IoWorker::Create(std::size_t capacity) {
+  return std::make_unique<IoWorkerImpl>(capacity);
+}
+} // namespace cdfw
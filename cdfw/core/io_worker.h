@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_IO_WORKER_H
+#define CDFW_CORE_IO_WORKER_H
+
+// The I/O worker runs storage jobs off the UI loop, so that a slow SD card
+// write never stalls lv_timer_handler().
+//
+// Jobs run one at a time, in submission order, on a dedicated thread (a
+// FreeRTOS task on the ESP32, a std::thread on native). Each job's completion
+// is handed back to the UI loop and runs inside Poll(), so completions may
+// touch LVGL objects and presenters freely.
+//
+// The queue is bounded: a request counts against the capacity from Submit()
+// until its completion has run. Submit() fails rather than block when the
+// queue is full.
+//
+// Anything a job touches (e.g., the RoutineStore) must only be touched from
+// jobs once the worker is in use.
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace cdfw {
+// Latency of the requests completed so far, in microseconds. `wait` is the
+// time spent queued before the job started, `run` the time the job took.
+struct IoWorkerStats {
+  std::uint32_t submitted;
+  std::uint32_t rejected;
+  std::uint32_t completed;
+  std::uint32_t max_wait_us;
+  std::uint32_t max_run_us;
+  std::uint64_t total_wait_us;
+  std::uint64_t total_run_us;
+};
+
+// Timing of a single request, handed to its completion.
+struct IoLatency {
+  std::uint32_t wait_us;
+  std::uint32_t run_us;
+};
+
+class IoWorker {
+public:
+  // Runs on the worker. Returns false on failure.
+  typedef std::function<bool()> Job;
+  // Runs on the UI loop, inside Poll(), with the job's result.
+  typedef std::function<void(bool ok, const IoLatency &latency)> Completion;
+
+  static constexpr std::size_t kDefaultCapacity = 8;
+
+  // Factory method. Starts the worker.
+  static std::unique_ptr<IoWorker> Create(std::size_t capacity =
+                                              kDefaultCapacity);
+
+  // Virtual destructor. Finishes the jobs already queued, then stops the
+  // worker. Completions not yet polled are dropped.
+  virtual ~IoWorker() = default;
+
+  // Queues `job`. `done` (if set) runs from a later Poll(). Returns false,
+  // without queueing, if the queue is full.
+  virtual bool Submit(Job job, Completion done = nullptr) = 0;
+
+  // Runs the completions of finished jobs. Call from the UI loop. Returns the
+  // number of completions run.
+  virtual std::size_t Poll() = 0;
+
+  // Blocks until every queued job has finished. Completions still need a
+  // Poll().
+  virtual void Drain() = 0;
+
+  // Requests submitted but whose completion has not run yet.
+  virtual std::size_t Pending() const = 0;
+
+  virtual IoWorkerStats GetStats() const = 0;
+};
+} // namespace cdfw
+
+#endif // CDFW_CORE_IO_WORKER_H
@@ -0,0 +1,128 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/json_arena.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace cdfw {
+namespace {
+constexpr std::size_t kAlign = alignof(std::max_align_t);
+
+constexpr std::size_t AlignUp(std::size_t n) {
+  return (n + kAlign - 1) & ~(kAlign - 1);
+}
+
+// Every block is preceded by a header holding its requested size, so that
+// reallocate() knows how much to copy when a block has to move.
+constexpr std::size_t kHeader = AlignUp(sizeof(std::size_t));
+
+std::size_t BlockSize(const std::uint8_t *block) {
+  std::size_t size;
+  std::memcpy(&size, block, sizeof(size));
+  return size;
+}
+
+void SetBlockSize(std::uint8_t *block, std::size_t size) {
+  std::memcpy(block, &size, sizeof(size));
+}
+
+class HeapAllocator : public ArduinoJson::Allocator {
+public:
+  void *allocate(std::size_t size) override { return std::malloc(size); }
+  void deallocate(void *ptr) override { std::free(ptr); }
+  void *reallocate(void *ptr, std::size_t new_size) override {
+    return std::realloc(ptr, new_size);
+  }
+};
+
+// Set by SetHeapAllocator(); null for HeapAllocator.
+ArduinoJson::Allocator *heap_allocator = nullptr;
+} // namespace
+
+JsonArena::JsonArena(void *buf, std::size_t size)
+    : buf_(static_cast<std::uint8_t *>(buf)), size_(size), top_(0),
+      last_(kNoBlock), high_water_(0), failures_(0) {
+  // Caller buffers need not be aligned; skip to the first aligned byte.
+  auto addr = reinterpret_cast<std::uintptr_t>(buf_);
+  std::size_t skip = AlignUp(addr) - addr;
+  skip = std::min(skip, size_);
+  buf_ += skip;
+  size_ -= skip;
+}
+
+void JsonArena::Reset() {
+  top_ = 0;
+  last_ = kNoBlock;
+}
+
+void *JsonArena::allocate(std::size_t size) {
+  std::size_t need = kHeader + AlignUp(size);
+  if (need < size || need > size_ - top_) {
+    ++failures_;
+    return nullptr;
+  }
+
+  std::uint8_t *block = buf_ + top_;
+  SetBlockSize(block, size);
+  last_ = top_;
+  top_ += need;
+  high_water_ = std::max(high_water_, top_);
+  return block + kHeader;
+}
+
+void JsonArena::deallocate(void *ptr) {
+  // Only the most recent block can be given back before Reset().
+  if (ptr != nullptr && last_ != kNoBlock && ptr == buf_ + last_ + kHeader) {
+    top_ = last_;
+    last_ = kNoBlock;
+  }
+}
+
+void *JsonArena::reallocate(void *ptr, std::size_t new_size) {
+  if (ptr == nullptr) {
+    return allocate(new_size);
+  }
+
+  auto *block = static_cast<std::uint8_t *>(ptr) - kHeader;
+  if (last_ != kNoBlock && block == buf_ + last_) {
+    // Most recent block: grow or shrink in place.
+    std::size_t need = kHeader + AlignUp(new_size);
+    if (need < new_size || need > size_ - last_) {
+      ++failures_;
+      return nullptr;
+    }
+    SetBlockSize(block, new_size);
+    top_ = last_ + need;
+    high_water_ = std::max(high_water_, top_);
+    return ptr;
+  }
+
+  std::size_t old_size = BlockSize(block);
+  void *moved = allocate(new_size);
+  if (moved != nullptr) {
+    std::memcpy(moved, ptr, std::min(old_size, new_size));
+  }
+  return moved;
+}
+
+ArduinoJson::Allocator *DocumentAllocator(JsonArena *arena) {
+  static HeapAllocator heap;
+  if (arena == nullptr) {
+    return heap_allocator != nullptr ? heap_allocator : &heap;
+  }
+  arena->Reset();
+  return arena;
+}
+
+void SetHeapAllocator(ArduinoJson::Allocator *allocator) {
+  heap_allocator = allocator;
+}
+} // namespace cdfw
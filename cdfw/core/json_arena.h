@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_JSON_ARENA_H
+#define CDFW_CORE_JSON_ARENA_H
+
+// Bump allocator for ArduinoJson documents.
+//
+// The serializers build one short-lived document per call. On the default
+// allocator each document costs a handful of general-heap allocations (slot
+// pools plus one block per string), which fragments the ESP32 heap when a
+// whole routine library is imported. A JsonArena serves those allocations
+// from a fixed buffer instead and is reset between documents, so the heap is
+// never touched.
+//
+// Allocation bumps a cursor; freeing or growing the most recent block (the
+// common case for ArduinoJson's string builder) is done in place. Any other
+// free is deferred until Reset(). When the buffer is exhausted allocation
+// fails and the document reports overflowed().
+
+// Third Party Headers
+#include <ArduinoJson.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+
+namespace cdfw {
+class JsonArena : public ArduinoJson::Allocator {
+public:
+  // Serves allocations from `buf`, which must outlive the arena.
+  JsonArena(void *buf, std::size_t size);
+  ~JsonArena() = default;
+  JsonArena(const JsonArena &) = delete;
+  JsonArena &operator=(const JsonArena &) = delete;
+
+  // Releases every allocation at once. Must only be called once no document
+  // built in the arena is alive.
+  void Reset();
+
+  std::size_t Capacity() const { return size_; }
+  std::size_t Used() const { return top_; }
+  // Largest Used() seen since construction; useful for sizing the buffer.
+  std::size_t HighWater() const { return high_water_; }
+  // Number of allocations refused because the arena was full.
+  std::size_t Failures() const { return failures_; }
+
+  // ArduinoJson::Allocator
+  void *allocate(std::size_t size) override;
+  void deallocate(void *ptr) override;
+  void *reallocate(void *ptr, std::size_t new_size) override;
+
+private:
+  static constexpr std::size_t kNoBlock = static_cast<std::size_t>(-1);
+
+  std::uint8_t *buf_;
+  std::size_t size_;
+  std::size_t top_;        // Offset of the first free byte.
+  std::size_t last_;       // Offset of the most recent block, or kNoBlock.
+  std::size_t high_water_;
+  std::size_t failures_;
+};
+
+// A JsonArena that owns its buffer, for use as a static or member.
+template <std::size_t N>
+class StaticJsonArena final : public JsonArena {
+public:
+  StaticJsonArena() : JsonArena(storage_, N) {}
+
+private:
+  alignas(std::max_align_t) std::uint8_t storage_[N];
+};
+
+// Returns the allocator for a new document: `arena`, after resetting it, or
+// the general heap if `arena` is null.
+ArduinoJson::Allocator *DocumentAllocator(JsonArena *arena);
+
+// Makes DocumentAllocator() return `allocator` in place of the general heap,
+// or the general heap again if `allocator` is null. For tests that count
+// allocations; call it before any document is built.
+void SetHeapAllocator(ArduinoJson::Allocator *allocator);
+} // namespace cdfw
+
+#endif // CDFW_CORE_JSON_ARENA_H
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_PATH_BUF_H
+#define CDFW_CORE_PATH_BUF_H
+
+// Local Headers
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+namespace cdfw {
+namespace vfs {
+// Long enough for every path the firmware builds on the card.
+constexpr std::size_t kMaxPathLength = 128;
+
+// Fixed-capacity path builder stored inline, for joining paths on hot routes
+// (e.g., a file name onto DirLayout::routines_dir) without touching the heap.
+// Converts implicitly to a PathView, so it can be handed straight to Volume.
+//
+// Appending past the capacity leaves the contents unchanged and marks the
+// path as failed. A failed path views as empty, which no volume will find or
+// open, so a chain of appends only needs checking once at the end (or not at
+// all).
+template <std::size_t N = kMaxPathLength>
+class PathBuf {
+public:
+  static constexpr std::size_t kCapacity = N;
+
+  // constructors
+  PathBuf() noexcept : len_(0), ok_(true) { buf_[0] = '\0'; }
+  explicit PathBuf(PathView path) noexcept : PathBuf() { *this += path; }
+
+  // append
+  // Appends `component` after a separator, unless either side already has
+  // one at the join.
+  PathBuf &operator/=(PathView component) noexcept {
+    auto s = component.native();
+    if (len_ > 0 && buf_[len_ - 1] != PathView::preferred_separator &&
+        (s.empty() || s.front() != PathView::preferred_separator)) {
+      if (!Fits(1 + s.size())) {
+        return *this;
+      }
+      buf_[len_++] = PathView::preferred_separator;
+    }
+    return *this += component;
+  }
+
+  // Appends `s` as is, e.g., an extension onto the last component.
+  PathBuf &operator+=(PathView s) noexcept {
+    auto v = s.native();
+    if (Fits(v.size())) {
+      std::memcpy(buf_ + len_, v.data(), v.size());
+      len_ += v.size();
+      buf_[len_] = '\0';
+    }
+    return *this;
+  }
+
+  // modifiers
+  void clear() noexcept {
+    len_ = 0;
+    ok_ = true;
+    buf_[0] = '\0';
+  }
+
+  // query
+  // False once an append did not fit.
+  bool ok() const noexcept { return ok_; }
+  bool empty() const noexcept { return view().empty(); }
+  std::size_t size() const noexcept { return view().size(); }
+
+  // native format
+  const char *c_str() const noexcept { return ok_ ? buf_ : ""; }
+  PathView view() const noexcept {
+    return ok_ ? PathView(std::string_view(buf_, len_)) : PathView();
+  }
+  operator PathView() const noexcept { return view(); }
+
+private:
+  char buf_[N + 1]; // NUL terminated.
+  std::size_t len_;
+  bool ok_;
+
+  bool Fits(std::size_t n) noexcept {
+    if (!ok_ || n > N - len_) {
+      ok_ = false;
+      return false;
+    }
+    return true;
+  }
+};
+} // namespace vfs
+} // namespace cdfw
+
+#endif // CDFW_CORE_PATH_BUF_H
@@ -0,0 +1,429 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/ram_volume.h"
+#include "cdfw/core/vfs.h"
+#include "cdfw/core/vfs_tree.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cdfw {
+namespace vfs {
+namespace {
+typedef std::vector<std::uint8_t> Bytes;
+
+struct Node {
+  bool is_dir;
+  // False once the node has been removed from the tree. Open files keep
+  // their node alive, but it no longer counts towards the volume's usage.
+  bool linked;
+  // Shared with mappings. Replaced, never modified, while they hold it.
+  std::shared_ptr<Bytes> bytes;
+};
+
+// Shared by the volume and the files opened from it, which may outlive it.
+struct Tree {
+  std::mutex mutex;
+  std::uint64_t capacity; // 0 for no limit.
+  std::uint64_t used;
+  // Every dir and file below the mount point, keyed by absolute path. A
+  // subtree is a contiguous range: all keys starting with "<dir>/".
+  std::map<std::string, std::shared_ptr<Node>> nodes;
+
+  std::uint64_t Free() const {
+    return capacity == 0 ? std::numeric_limits<std::uint64_t>::max() - used
+                         : capacity - used;
+  }
+
+  void Unlink(Node &node) {
+    node.linked = false;
+    if (!node.is_dir) {
+      used -= node.bytes->size();
+    }
+  }
+
+  // Returns the file's bytes, copied first if a mapping still holds them.
+  Bytes &Writable(Node &node) {
+    if (node.bytes.use_count() > 1) {
+      node.bytes = std::make_shared<Bytes>(*node.bytes);
+    }
+    return *node.bytes;
+  }
+};
+
+std::string Parent(const std::string &key) {
+  return key.substr(0, key.rfind('/'));
+}
+
+class RawFileImpl : public RawFile {
+public:
+  RawFileImpl(std::shared_ptr<Tree> tree, std::shared_ptr<Node> node)
+      : tree_(tree), node_(node) {}
+  virtual ~RawFileImpl() = default;
+
+  virtual std::size_t ReadAt(std::uint64_t offset,
+                             ByteSpan buf) override final {
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    const Bytes &bytes = *node_->bytes;
+    if (offset >= bytes.size()) {
+      return 0;
+    }
+    std::size_t n = std::min<std::uint64_t>(buf.size(), bytes.size() - offset);
+    std::memcpy(buf.data(), bytes.data() + offset, n);
+    return n;
+  }
+
+  virtual std::size_t WriteAt(std::uint64_t offset,
+                              ConstByteSpan data) override final {
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    Bytes &bytes = tree_->Writable(*node_);
+    std::uint64_t end = offset + data.size();
+    if (end > bytes.size() && node_->linked) {
+      // Growth is limited by the capacity; the write is cut short.
+      end = std::min(end, bytes.size() + tree_->Free());
+      if (end <= offset) {
+        return 0;
+      }
+      tree_->used += end - bytes.size();
+    }
+    if (end > bytes.size()) {
+      bytes.resize(end);
+    }
+    std::memcpy(bytes.data() + offset, data.data(), end - offset);
+    return end - offset;
+  }
+
+  virtual std::uint64_t Size() override final {
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    return node_->bytes->size();
+  }
+
+  virtual bool Sync() override final { return true; }
+
+private:
+  std::shared_ptr<Tree> tree_;
+  std::shared_ptr<Node> node_;
+};
+
+class RawMappingImpl : public RawMapping {
+public:
+  RawMappingImpl(std::shared_ptr<const Bytes> bytes) : bytes_(bytes) {}
+  virtual ~RawMappingImpl() = default;
+
+  virtual ConstByteSpan Data() override final {
+    return ConstByteSpan(bytes_->data(), bytes_->size());
+  }
+
+private:
+  std::shared_ptr<const Bytes> bytes_;
+};
+
+class RamVolumeImpl : public RamVolume {
+public:
+  RamVolumeImpl(const Path &mount_point, std::uint64_t capacity)
+      : mp_(Normalize(mount_point.native())),
+        tree_(std::make_shared<Tree>()) {
+    tree_->capacity = capacity;
+    tree_->used = 0;
+  }
+  virtual ~RamVolumeImpl() = default;
+
+  virtual std::uint64_t Capacity() override final {
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    return tree_->capacity == 0 ? std::numeric_limits<std::uint64_t>::max()
+                                : tree_->capacity;
+  }
+  virtual std::uint64_t Available() override final {
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    return tree_->Free();
+  }
+  virtual std::uint64_t Used() override final {
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    return tree_->used;
+  }
+  virtual Path MountPoint() override final { return mp_; }
+  virtual Path TempDir() override final { return MountPoint() / "tmp"; }
+  virtual bool Exists(PathView path) const override final {
+    std::string key;
+    if (!Key(path, key)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    return key == mp_ || tree_->nodes.count(key) > 0;
+  }
+  virtual bool List(const Path &dir,
+                    std::vector<DirEntry> &entries) override final {
+    entries.clear();
+    std::string key;
+    if (!Key(dir, key)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    if (!IsDir(key)) {
+      return false;
+    }
+    const std::string prefix = key + "/";
+    for (auto it = tree_->nodes.lower_bound(prefix);
+         it != tree_->nodes.end() && StartsWith(it->first, prefix); ++it) {
+      auto name = it->first.substr(prefix.size());
+      if (name.find('/') == std::string::npos) {
+        entries.push_back({name, it->second->is_dir});
+      }
+    }
+    return true;
+  }
+
+  virtual bool CreateDirs(const Path &path) override final {
+    std::string key;
+    if (!Key(path, key)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    if (key == mp_) {
+      return true;
+    }
+
+    // Walk down from the mount point, creating what is missing.
+    std::size_t end = mp_.size();
+    while (end != std::string::npos) {
+      end = key.find('/', end + 1);
+      auto prefix = key.substr(0, end);
+      auto it = tree_->nodes.find(prefix);
+      if (it == tree_->nodes.end()) {
+        auto dir = std::make_shared<Node>(Node{true, true, nullptr});
+        tree_->nodes.emplace(std::move(prefix), std::move(dir));
+      } else if (!it->second->is_dir) {
+        return false;
+      }
+    }
+    return true;
+  }
+  virtual bool Remove(const Path &path) override final {
+    std::string key;
+    if (!Key(path, key)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    auto it = tree_->nodes.find(key);
+    if (it == tree_->nodes.end() || HasChildren(key)) {
+      return false;
+    }
+    tree_->Unlink(*it->second);
+    tree_->nodes.erase(it);
+    return true;
+  }
+  virtual bool RemoveAll(const Path &path,
+                         const RemoveProgress &progress) override final {
+    std::string key;
+    if (!Key(path, key) || key == mp_) {
+      return false;
+    }
+
+    // Like RemoveTree(): children before their parents, progress after every
+    // batch of files and every dir, and the same depth cap. Unlike it, the
+    // depth is checked before anything is removed.
+    std::vector<std::string> victims;
+    {
+      std::lock_guard<std::mutex> lock(tree_->mutex);
+      if (tree_->nodes.count(key) == 0) {
+        return false;
+      }
+      const std::string prefix = key + "/";
+      for (auto it = tree_->nodes.lower_bound(prefix);
+           it != tree_->nodes.end() && StartsWith(it->first, prefix); ++it) {
+        auto depth = std::count(it->first.begin() + prefix.size(),
+                                it->first.end(), '/');
+        if (it->second->is_dir &&
+            static_cast<std::size_t>(depth) + 1 >= kMaxTreeDepth) {
+          return false;
+        }
+        victims.push_back(it->first);
+      }
+    }
+    victims.insert(victims.begin(), key);
+
+    RemoveStats stats{};
+    std::size_t batch = 0;
+    for (auto it = victims.rbegin(); it != victims.rend(); ++it) {
+      bool is_dir;
+      {
+        std::lock_guard<std::mutex> lock(tree_->mutex);
+        auto node = tree_->nodes.find(*it);
+        if (node == tree_->nodes.end()) {
+          continue;
+        }
+        is_dir = node->second->is_dir;
+        tree_->Unlink(*node->second);
+        tree_->nodes.erase(node);
+      }
+
+      // Report outside the lock: the callback may use the volume.
+      if (is_dir) {
+        ++stats.dirs;
+      } else {
+        ++stats.files;
+        ++batch;
+      }
+      const bool last = std::next(it) == victims.rend();
+      if (is_dir || batch == kRemoveBatchSize || last) {
+        batch = 0;
+        if (progress && !progress(stats)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  virtual bool Rename(const Path &from, const Path &to) override final {
+    std::string src, dst;
+    if (!Key(from, src) || !Key(to, dst) || src == mp_ || dst == mp_) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    auto it = tree_->nodes.find(src);
+    if (it == tree_->nodes.end() || !IsDir(Parent(dst))) {
+      return false;
+    } else if (src == dst) {
+      return true;
+    } else if (StartsWith(dst, src + "/")) {
+      // A dir cannot be moved inside itself.
+      return false;
+    }
+
+    // Like rename(2): a file replaces a file, a dir an empty dir.
+    auto target = tree_->nodes.find(dst);
+    if (target != tree_->nodes.end()) {
+      if (target->second->is_dir != it->second->is_dir || HasChildren(dst)) {
+        return false;
+      }
+      tree_->Unlink(*target->second);
+      tree_->nodes.erase(target);
+    }
+
+    // Move the node and, for a dir, its subtree.
+    std::vector<std::pair<std::string, std::shared_ptr<Node>>> moved;
+    moved.emplace_back(dst, tree_->nodes.extract(src).mapped());
+    const std::string prefix = src + "/";
+    for (auto child = tree_->nodes.lower_bound(prefix);
+         child != tree_->nodes.end() && StartsWith(child->first, prefix);) {
+      moved.emplace_back(dst + child->first.substr(src.size()),
+                         std::move(child->second));
+      child = tree_->nodes.erase(child);
+    }
+    for (auto &node : moved) {
+      tree_->nodes.emplace(std::move(node.first), std::move(node.second));
+    }
+    return true;
+  }
+
+  virtual bool Sync() override final { return true; }
+
+  virtual std::unique_ptr<RawFile> Open(PathView path,
+                                        OpenMode mode) override final {
+    std::string key;
+    if (!Key(path, key)) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    if (!IsDir(Parent(key))) {
+      return nullptr;
+    }
+
+    auto it = tree_->nodes.find(key);
+    if (it == tree_->nodes.end()) {
+      if (mode == OpenMode::kREAD) {
+        return nullptr;
+      }
+      auto file =
+          std::make_shared<Node>(Node{false, true, std::make_shared<Bytes>()});
+      it = tree_->nodes.emplace(key, std::move(file)).first;
+    } else if (it->second->is_dir) {
+      return nullptr;
+    } else if (mode == OpenMode::kTRUNCATE) {
+      // A fresh buffer: mappings keep the old one.
+      tree_->used -= it->second->bytes->size();
+      it->second->bytes = std::make_shared<Bytes>();
+    }
+    return std::make_unique<RawFileImpl>(tree_, it->second);
+  }
+
+  virtual std::unique_ptr<RawMapping>
+  MapFile(const Path &path) override final {
+    std::string key;
+    if (!Key(path, key)) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(tree_->mutex);
+    auto it = tree_->nodes.find(key);
+    if (it == tree_->nodes.end() || it->second->is_dir) {
+      return nullptr;
+    }
+    return std::make_unique<RawMappingImpl>(it->second->bytes);
+  }
+
+private:
+  std::string mp_;
+  std::shared_ptr<Tree> tree_;
+
+  static bool StartsWith(const std::string &s, const std::string &prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+  }
+
+  static std::string Normalize(std::string_view path) {
+    auto normal = stdfs::path(path).lexically_normal().native();
+    while (normal.size() > 1 && normal.back() == '/') {
+      normal.pop_back();
+    }
+    return normal;
+  }
+
+  // Normalizes `path` into `key`. Returns false if it is not on the volume.
+  bool Key(PathView path, std::string &key) const {
+    key = Normalize(path.native());
+    return key == mp_ || StartsWith(key, mp_ + "/");
+  }
+
+  // The helpers below expect the tree's mutex to be held.
+  bool IsDir(const std::string &key) const {
+    if (key == mp_) {
+      return true;
+    }
+    auto it = tree_->nodes.find(key);
+    return it != tree_->nodes.end() && it->second->is_dir;
+  }
+
+  bool HasChildren(const std::string &key) const {
+    const std::string prefix = key + "/";
+    auto it = tree_->nodes.lower_bound(prefix);
+    return it != tree_->nodes.end() && StartsWith(it->first, prefix);
+  }
+};
+} // namespace
+
+std::unique_ptr<RamVolume> RamVolume::Create(const Path &mount_point,
+                                             std::uint64_t capacity) {
+  return std::make_unique<RamVolumeImpl>(mount_point, capacity);
+}
+
+std::shared_ptr<Volume> RamVolume::CreateVolume(const Path &mount_point,
+                                                std::uint64_t capacity) {
+  return Volume::Create(RamVolume::Create(mount_point, capacity));
+}
+} // namespace vfs
+} // namespace cdfw
@@ -0,0 +1,48 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_RAM_VOLUME_H
+#define CDFW_CORE_RAM_VOLUME_H
+
+// A volume held entirely in RAM. Behaves like the SD backends (see
+// test/integration/test_hal/sd.test.cpp, which runs against both), so it can
+// stand in for the card in tests and benchmarks, or hold scratch files that
+// never need to reach the card.
+//
+// Nothing survives a reboot, and Sync() is a no-op. Map() is zero-copy: a
+// mapping keeps the contents it was opened with, later writes to the file
+// copy them first.
+
+// Local Headers
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <memory>
+
+namespace cdfw {
+namespace vfs {
+class RamVolume : public Volume {
+public:
+  static constexpr const char *kDefaultMountPoint = "/ram";
+
+  // Factory methods. `capacity` caps the bytes held in files; writes past it
+  // are cut short. 0 means no limit beyond the heap.
+  static std::unique_ptr<RamVolume>
+  Create(const Path &mount_point = kDefaultMountPoint,
+         std::uint64_t capacity = 0);
+  static std::shared_ptr<Volume>
+  CreateVolume(const Path &mount_point = kDefaultMountPoint,
+               std::uint64_t capacity = 0);
+
+  // Virtual destructor.
+  virtual ~RamVolume() = default;
+
+  // Shared implementations.
+  virtual bool IsSD() override final { return false; }
+};
+} // namespace vfs
+} // namespace cdfw
+
+#endif // CDFW_CORE_RAM_VOLUME_H
@@ -4,34 +4,184 @@
 
 // Local Headers
 #include "cdfw/core/routine.h"
+#include "cdfw/core/crc32.h"
+#include "cdfw/core/json_arena.h"
 #include "cdfw/core/station.h"
 
 // Third Party Headers
 #include <ArduinoJson.h>
 
 // C++ Standard Library Headers
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
 #include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace cdfw {
 namespace {
+constexpr std::uint8_t kRecordMagic[4] = {'C', 'D', 'R', 'T'};
+constexpr std::size_t kRecordNameOffset = 8;
+constexpr std::size_t kRecordWetOffset =
+    kRecordNameOffset + RoutineRecord::kNameSize;
+constexpr std::size_t kRecordDryOffset =
+    kRecordWetOffset + 4 * RoutineRecord::kStationSize;
+constexpr std::size_t kRecordCrcOffset = RoutineRecord::kSize - 4;
+static_assert(kRecordDryOffset + RoutineRecord::kStationSize <=
+                  kRecordCrcOffset,
+              "Routine record fields overlap the checksum.");
+
+void PutU16(std::uint8_t *p, std::uint16_t v) {
+  p[0] = static_cast<std::uint8_t>(v);
+  p[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+void PutU32(std::uint8_t *p, std::uint32_t v) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+  }
+}
+
+std::uint16_t GetU16(const std::uint8_t *p) {
+  return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::uint32_t GetU32(const std::uint8_t *p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+void PutName(std::uint8_t *p, const ConfigName &name) {
+  std::memcpy(p, name.c_str(), name.size());
+}
+
+std::string_view GetName(const std::uint8_t *p) {
+  auto c = reinterpret_cast<const char *>(p);
+  auto end = std::find(c, c + RoutineRecord::kMaxNameLength, '\0');
+  return std::string_view(c, end - c);
+}
+
+void PutStation(std::uint8_t *p, const Station &station, std::uint8_t mode) {
+  PutName(p, station.name);
+  PutU32(p + 32, station.time);
+  p[36] = station.enabled ? 1 : 0;
+  p[37] = mode;
+}
+
+// True if the station's time and mode are in range, so that the mode byte
+// can be cast to the enum. `max_mode` is the mode's last enumerator.
+bool StationInRange(const std::uint8_t *p, std::uint8_t max_mode) {
+  return GetU32(p + 32) <= Station::kMaxTime && p[37] <= max_mode;
+}
+
+WetStation GetWetStation(const std::uint8_t *p) {
+  if (!p[36]) {
+    return WetStation::GetDisabled();
+  }
+  return WetStation::GetConfigured(
+      GetName(p), GetU32(p + 32),
+      static_cast<WetStation::AgitationLevel>(p[37]));
+}
+
+DryStation GetDryStation(const std::uint8_t *p) {
+  if (!p[36]) {
+    return DryStation::GetDisabled();
+  }
+  return DryStation::GetConfigured(GetName(p), GetU32(p + 32),
+                                   static_cast<DryStation::SpinType>(p[37]));
+}
+
+// Document storage for batches on serializers built without an arena.
+typedef StaticJsonArena<RoutineJsonCodec::kArenaSize> BatchArena;
+
+// NDJSON lines longer than this cannot hold a routine. They are consumed
+// without being buffered and reported as too large.
+constexpr std::size_t kMaxLineLength = 2048;
+
+typedef std::char_traits<char> Traits;
+
+// Returns the next non-whitespace character without consuming it.
+int PeekToken(std::streambuf *buf) {
+  int c = buf->sgetc();
+  while (c != Traits::eof() && std::isspace(c)) {
+    c = buf->snextc();
+  }
+  return c;
+}
+
+// Reads one line, without its terminator, into `line`. Returns false at the
+// end of the input. Sets `too_long` if the line exceeds kMaxLineLength, in
+// which case the rest of the line is skipped.
+bool ReadLine(std::streambuf *buf, std::string &line, bool &too_long) {
+  line.clear();
+  too_long = false;
+
+  int c = buf->sbumpc();
+  if (c == Traits::eof()) {
+    return false;
+  }
+  for (; c != Traits::eof() && c != '\n'; c = buf->sbumpc()) {
+    if (line.size() < kMaxLineLength) {
+      line.push_back(Traits::to_char_type(c));
+    } else {
+      too_long = true;
+    }
+  }
+  return true;
+}
+
+bool IsBlank(const std::string &line) {
+  return std::all_of(line.begin(), line.end(), [](char c) {
+    return std::isspace(static_cast<unsigned char>(c));
+  });
+}
+
+void ReportError(const RoutineSerializer::ErrorSink &on_error,
+                 std::size_t index, RoutineError::Code code) {
+  if (on_error) {
+    on_error(index, RoutineError{code});
+  }
+}
+
+// Errors after which the parser's position in the input is unknown.
+bool IsParseError(RoutineError::Code code) {
+  switch (code) {
+  case RoutineError::Code::kSYNTAX:
+  case RoutineError::Code::kTRUNCATED:
+  case RoutineError::Code::kTOO_LARGE:
+  case RoutineError::Code::kTOO_DEEP:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Options shared by every routine parse.
+DeserializationOption::Filter RoutineFilter() {
+  return DeserializationOption::Filter(RoutineJson::Filter());
+}
+
+DeserializationOption::NestingLimit RoutineNestingLimit() {
+  return DeserializationOption::NestingLimit(RoutineJson::kNestingLimit);
+}
+
 class RoutineSerializerImpl : public RoutineSerializer {
 public:
-  RoutineSerializerImpl() : station_serializer_(StationSerializer::Create()) {}
+  RoutineSerializerImpl(std::shared_ptr<JsonArena> arena) : arena_(arena) {}
   virtual ~RoutineSerializerImpl() = default;
 
   virtual std::string Serialize(const Routine &config) override final {
-    JsonDocument doc;
-    doc["name"] = config.name;
-
-    JsonArray wet_stations = doc["wet_stations"].to<JsonArray>();
-    for (std::size_t i = 0; i < 4; ++i) {
-      JsonObject wet_station = wet_stations.add<JsonObject>();
-      station_serializer_->Serialize(wet_station, config.wet_stations[i]);
-    }
-
-    JsonObject dry_station = doc["dry_station"].to<JsonObject>();
-    station_serializer_->Serialize(dry_station, config.dry_station);
+    JsonDocument doc(DocumentAllocator(arena_.get()));
+    RoutineJson::Write(doc.to<JsonObject>(), config);
 
     std::string json_str;
     serializeJson(doc, json_str);
@@ -39,39 +189,457 @@ public:
   }
 
   virtual Routine Deserialize(const std::string &obj) override final {
-    JsonDocument doc;
-    deserializeJson(doc, obj);
+    Routine routine = Routine::GetDisabled();
+    RoutineError error{};
+    JsonDocument doc(DocumentAllocator(arena_.get()));
+    DeserializationError err =
+        deserializeJson(doc, obj, RoutineFilter(), RoutineNestingLimit());
+    RoutineJson::Read(err, doc, routine, error);
+    return routine;
+  }
 
-    WetStation wet_stations[] = {
-        station_serializer_->DeserializeWet(
-            (doc["wet_stations"][0]).as<JsonObject>()),
-        station_serializer_->DeserializeWet(
-            (doc["wet_stations"][1]).as<JsonObject>()),
-        station_serializer_->DeserializeWet(
-            (doc["wet_stations"][2]).as<JsonObject>()),
-        station_serializer_->DeserializeWet(
-            (doc["wet_stations"][3]).as<JsonObject>())};
-    DryStation dry_station = station_serializer_->DeserializeDry(
-        doc["dry_station"].as<JsonObject>());
+  virtual Routine Deserialize(std::istream &input) override final {
+    Routine routine = Routine::GetDisabled();
+    RoutineError error{};
+    Deserialize(input, routine, error);
+    return routine;
+  }
 
-    return Routine::GetConfigured(
-        doc["name"].as<std::string>(), wet_stations[0], wet_stations[1],
-        wet_stations[2], wet_stations[3], dry_station);
+  virtual bool Deserialize(std::istream &input, Routine &routine,
+                           RoutineError &error) override final {
+    JsonDocument doc(DocumentAllocator(arena_.get()));
+    DeserializationError err =
+        deserializeJson(doc, input, RoutineFilter(), RoutineNestingLimit());
+    return RoutineJson::Read(err, doc, routine, error);
+  }
+
+  virtual std::size_t SerializeMany(const RoutineSource &source,
+                                    Layout layout,
+                                    std::ostream &output) override final {
+    std::unique_ptr<BatchArena> owned;
+    JsonArena *arena = GetBatchArena(owned);
+    Routine routine = Routine::GetDisabled();
+    std::string buf;
+    std::size_t count = 0;
+
+    if (layout == Layout::kARRAY) {
+      output.put('[');
+    }
+    while (source(routine)) {
+      buf.clear();
+      {
+        JsonDocument doc(DocumentAllocator(arena));
+        RoutineJson::Write(doc.to<JsonObject>(), routine);
+        if (doc.overflowed()) {
+          break;
+        }
+        serializeJson(doc, buf);
+      }
+
+      if (layout == Layout::kARRAY && count > 0) {
+        output.put(',');
+      }
+      if (layout == Layout::kNDJSON) {
+        buf.push_back('\n');
+      }
+      output.write(buf.data(), buf.size());
+      if (!output) {
+        break;
+      }
+      ++count;
+    }
+    if (layout == Layout::kARRAY) {
+      output.put(']');
+    }
+    return count;
+  }
+
+  virtual std::size_t
+  DeserializeMany(std::istream &input, Layout layout,
+                  const RoutineSink &on_routine,
+                  const ErrorSink &on_error) override final {
+    std::unique_ptr<BatchArena> owned;
+    JsonArena *arena = GetBatchArena(owned);
+    if (layout == Layout::kNDJSON) {
+      return DeserializeLines(input, arena, on_routine, on_error);
+    }
+    return DeserializeArray(input, arena, on_routine, on_error);
   }
 
 private:
-  std::shared_ptr<StationSerializer> station_serializer_;
+  std::shared_ptr<JsonArena> arena_;
+
+  // Batches build every entry in one arena: the serializer's own, or one
+  // allocated for the duration of the batch.
+  JsonArena *GetBatchArena(std::unique_ptr<BatchArena> &owned) {
+    if (arena_) {
+      return arena_.get();
+    }
+    owned = std::make_unique<BatchArena>();
+    return owned.get();
+  }
+
+  // Validates a parsed entry and passes it to the matching sink. Returns the
+  // error code.
+  static RoutineError::Code Deliver(std::size_t index,
+                                    const DeserializationError &err,
+                                    const JsonDocument &doc,
+                                    const RoutineSink &on_routine,
+                                    const ErrorSink &on_error) {
+    Routine routine = Routine::GetDisabled();
+    RoutineError error{};
+    if (!RoutineJson::Read(err, doc, routine, error)) {
+      if (on_error) {
+        on_error(index, error);
+      }
+      return error.code;
+    }
+
+    if (on_routine) {
+      on_routine(index, routine);
+    }
+    return RoutineError::Code::kNONE;
+  }
+
+  static std::size_t DeserializeLines(std::istream &input, JsonArena *arena,
+                                      const RoutineSink &on_routine,
+                                      const ErrorSink &on_error) {
+    std::streambuf *buf = input.rdbuf();
+    if (buf == nullptr) {
+      return 0;
+    }
+
+    std::string line;
+    bool too_long = false;
+    std::size_t index = 0;
+    std::size_t count = 0;
+    while (ReadLine(buf, line, too_long)) {
+      if (!too_long && IsBlank(line)) {
+        continue;
+      }
+      if (too_long) {
+        ReportError(on_error, index++, RoutineError::Code::kTOO_LARGE);
+        continue;
+      }
+
+      JsonDocument doc(DocumentAllocator(arena));
+      DeserializationError err =
+          deserializeJson(doc, line.data(), line.size(), RoutineFilter(),
+                          RoutineNestingLimit());
+      if (Deliver(index++, err, doc, on_routine, on_error) ==
+          RoutineError::Code::kNONE) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  // Reads the array one element at a time, straight from the stream, so the
+  // array as a whole is never held in RAM.
+  static std::size_t DeserializeArray(std::istream &input, JsonArena *arena,
+                                      const RoutineSink &on_routine,
+                                      const ErrorSink &on_error) {
+    std::streambuf *buf = input.rdbuf();
+    if (buf == nullptr) {
+      return 0;
+    }
+
+    int c = PeekToken(buf);
+    if (c != '[') {
+      ReportError(on_error, 0,
+                  c == Traits::eof() ? RoutineError::Code::kTRUNCATED
+                                     : RoutineError::Code::kSYNTAX);
+      return 0;
+    }
+    buf->sbumpc();
+    if (PeekToken(buf) == ']') {
+      buf->sbumpc();
+      return 0;
+    }
+
+    std::size_t index = 0;
+    std::size_t count = 0;
+    for (;;) {
+      RoutineError::Code code;
+      {
+        JsonDocument doc(DocumentAllocator(arena));
+        DeserializationError err =
+            deserializeJson(doc, input, RoutineFilter(), RoutineNestingLimit());
+        code = Deliver(index++, err, doc, on_routine, on_error);
+      }
+      if (code == RoutineError::Code::kNONE) {
+        ++count;
+      } else if (IsParseError(code)) {
+        // The parser stopped mid-entry; the next entry cannot be found.
+        break;
+      }
+
+      c = PeekToken(buf);
+      if (c == ',') {
+        buf->sbumpc();
+      } else if (c == ']') {
+        buf->sbumpc();
+        break;
+      } else {
+        ReportError(on_error, index,
+                    c == Traits::eof() ? RoutineError::Code::kTRUNCATED
+                                       : RoutineError::Code::kSYNTAX);
+        break;
+      }
+    }
+    return count;
+  }
+};
+
+class RoutineBinarySerializerImpl : public RoutineSerializer {
+public:
+  RoutineBinarySerializerImpl() = default;
+  virtual ~RoutineBinarySerializerImpl() = default;
+
+  virtual std::string Serialize(const Routine &config) override final {
+    std::uint8_t buf[RoutineRecord::kSize];
+    RoutineRecord::Encode(config, buf);
+    return std::string(reinterpret_cast<const char *>(buf), sizeof(buf));
+  }
+
+  virtual Routine Deserialize(const std::string &obj) override final {
+    Routine routine = Routine::GetDisabled();
+    if (obj.size() != RoutineRecord::kSize) {
+      return routine;
+    }
+
+    std::uint8_t buf[RoutineRecord::kSize];
+    std::memcpy(buf, obj.data(), sizeof(buf));
+    RoutineRecord::Decode(buf, routine);
+    return routine;
+  }
+
+  virtual Routine Deserialize(std::istream &input) override final {
+    Routine routine = Routine::GetDisabled();
+    RoutineError error{};
+    Deserialize(input, routine, error);
+    return routine;
+  }
+
+  virtual bool Deserialize(std::istream &input, Routine &routine,
+                           RoutineError &error) override final {
+    std::uint8_t buf[RoutineRecord::kSize];
+    input.read(reinterpret_cast<char *>(buf), sizeof(buf));
+    if (input.gcount() != sizeof(buf)) {
+      error = RoutineError{RoutineError::Code::kTRUNCATED};
+      return false;
+    } else if (!RoutineRecord::Decode(buf, routine)) {
+      error = RoutineError{RoutineError::Code::kCORRUPT};
+      return false;
+    }
+    return true;
+  }
+
+  virtual std::size_t SerializeMany(const RoutineSource &source, Layout,
+                                    std::ostream &output) override final {
+    Routine routine = Routine::GetDisabled();
+    std::uint8_t buf[RoutineRecord::kSize];
+    std::size_t count = 0;
+    while (source(routine)) {
+      RoutineRecord::Encode(routine, buf);
+      output.write(reinterpret_cast<const char *>(buf), sizeof(buf));
+      if (!output) {
+        break;
+      }
+      ++count;
+    }
+    return count;
+  }
+
+  virtual std::size_t
+  DeserializeMany(std::istream &input, Layout, const RoutineSink &on_routine,
+                  const ErrorSink &on_error) override final {
+    std::uint8_t buf[RoutineRecord::kSize];
+    std::size_t count = 0;
+    for (std::size_t index = 0;; ++index) {
+      input.read(reinterpret_cast<char *>(buf), sizeof(buf));
+      auto size = input.gcount();
+      if (size == 0) {
+        break;
+      } else if (size != sizeof(buf)) {
+        ReportError(on_error, index, RoutineError::Code::kTRUNCATED);
+        break;
+      }
+
+      // Records are fixed size, so a corrupt one is simply skipped.
+      Routine routine = Routine::GetDisabled();
+      if (!RoutineRecord::Decode(buf, routine)) {
+        ReportError(on_error, index, RoutineError::Code::kCORRUPT);
+        continue;
+      }
+      if (on_routine) {
+        on_routine(index, routine);
+      }
+      ++count;
+    }
+    return count;
+  }
 };
 } // namespace
 
+void RoutineRecord::Encode(const Routine &routine, std::uint8_t (&buf)[kSize]) {
+  std::memset(buf, 0, kSize);
+  std::memcpy(buf, kRecordMagic, sizeof(kRecordMagic));
+  PutU16(buf + 4, kVersion);
+  PutU16(buf + 6, kSize);
+  PutName(buf + kRecordNameOffset, routine.name);
+  for (std::size_t i = 0; i < 4; ++i) {
+    const auto &station = routine.wet_stations[i];
+    PutStation(buf + kRecordWetOffset + i * kStationSize, station,
+               static_cast<std::uint8_t>(station.agitation));
+  }
+  PutStation(buf + kRecordDryOffset, routine.dry_station,
+             static_cast<std::uint8_t>(routine.dry_station.spin));
+  PutU32(buf + kRecordCrcOffset, Crc32(buf, kRecordCrcOffset));
+}
+
+bool RoutineRecord::Decode(const std::uint8_t (&buf)[kSize],
+                           Routine &routine) {
+  if (std::memcmp(buf, kRecordMagic, sizeof(kRecordMagic)) != 0 ||
+      GetU16(buf + 4) != kVersion || GetU16(buf + 6) != kSize ||
+      GetU32(buf + kRecordCrcOffset) != Crc32(buf, kRecordCrcOffset)) {
+    return false;
+  }
+
+  constexpr auto kMaxAgitation =
+      static_cast<std::uint8_t>(WetStation::AgitationLevel::kHIGH);
+  constexpr auto kMaxSpin =
+      static_cast<std::uint8_t>(DryStation::SpinType::kBIDIRECTIONAL);
+  for (std::size_t i = 0; i < 4; ++i) {
+    if (!StationInRange(buf + kRecordWetOffset + i * kStationSize,
+                        kMaxAgitation)) {
+      return false;
+    }
+  }
+  if (!StationInRange(buf + kRecordDryOffset, kMaxSpin)) {
+    return false;
+  }
+
+  routine = Routine::GetConfigured(
+      GetName(buf + kRecordNameOffset),
+      GetWetStation(buf + kRecordWetOffset),
+      GetWetStation(buf + kRecordWetOffset + kStationSize),
+      GetWetStation(buf + kRecordWetOffset + 2 * kStationSize),
+      GetWetStation(buf + kRecordWetOffset + 3 * kStationSize),
+      GetDryStation(buf + kRecordDryOffset));
+  return true;
+}
+
 std::shared_ptr<RoutineSerializer> RoutineSerializer::Create() {
-  return std::make_shared<RoutineSerializerImpl>();
+  return Create(Format::kJSON);
+}
+
+std::shared_ptr<RoutineSerializer> RoutineSerializer::Create(Format format) {
+  return Create(format, nullptr);
+}
+
+std::shared_ptr<RoutineSerializer>
+RoutineSerializer::Create(Format format, std::shared_ptr<JsonArena> arena) {
+  switch (format) {
+  case Format::kBINARY:
+    return std::make_shared<RoutineBinarySerializerImpl>();
+  default:
+    return std::make_shared<RoutineSerializerImpl>(arena);
+  }
+}
+
+std::size_t RoutineSerializer::SerializeMany(
+    const std::vector<Routine> &routines, Layout layout, std::ostream &output) {
+  std::size_t next = 0;
+  return SerializeMany(
+      [&](Routine &routine) {
+        if (next == routines.size()) {
+          return false;
+        }
+        routine = routines[next++];
+        return true;
+      },
+      layout, output);
+}
+
+void RoutineJson::Write(JsonObject obj, const Routine &config) {
+  obj["name"] = config.name.c_str();
+
+  JsonArray wet_stations = obj["wet_stations"].to<JsonArray>();
+  for (std::size_t i = 0; i < 4; ++i) {
+    StationJson::Write(wet_stations.add<JsonObject>(), config.wet_stations[i]);
+  }
+
+  StationJson::Write(obj["dry_station"].to<JsonObject>(), config.dry_station);
+}
+
+bool RoutineJson::Read(JsonVariantConst value, Routine &routine,
+                       RoutineError &error) {
+  if (!value.is<JsonObjectConst>()) {
+    return error.Fail(RoutineError::Code::kNOT_OBJECT, "");
+  }
+  JsonObjectConst obj = value.as<JsonObjectConst>();
+
+  Routine parsed = Routine::GetDisabled();
+  if (!StationJson::ReadName(obj["name"], "", "name", parsed.name, error)) {
+    return false;
+  }
+
+  JsonVariantConst wet_stations = obj["wet_stations"];
+  if (wet_stations.isNull()) {
+    return error.Fail(RoutineError::Code::kMISSING, "wet_stations");
+  } else if (!wet_stations.is<JsonArrayConst>()) {
+    return error.Fail(RoutineError::Code::kWRONG_TYPE, "wet_stations");
+  } else if (wet_stations.size() != 4) {
+    return error.Fail(RoutineError::Code::kWRONG_COUNT, "wet_stations");
+  }
+  for (std::size_t i = 0; i < 4; ++i) {
+    char prefix[sizeof("wet_stations[0]")];
+    std::snprintf(prefix, sizeof(prefix), "wet_stations[%u]",
+                  static_cast<unsigned>(i));
+    if (!StationJson::Read(wet_stations[i], prefix, parsed.wet_stations[i],
+                           error)) {
+      return false;
+    }
+  }
+
+  if (!StationJson::Read(obj["dry_station"], "dry_station",
+                         parsed.dry_station, error)) {
+    return false;
+  }
+
+  routine = parsed;
+  return true;
+}
+
+bool RoutineJson::Read(const DeserializationError &parse,
+                       const JsonDocument &doc, Routine &routine,
+                       RoutineError &error) {
+  return error.Parsed(parse, doc) &&
+         Read(doc.as<JsonVariantConst>(), routine, error);
+}
+
+const JsonDocument &RoutineJson::Filter() {
+  static const JsonDocument filter = [] {
+    JsonDocument doc;
+    doc["name"] = true;
+    // The first element of a filter array applies to every element.
+    JsonObject wet = doc["wet_stations"][0].to<JsonObject>();
+    JsonObject dry = doc["dry_station"].to<JsonObject>();
+    StationJson::FilterWet(wet);
+    StationJson::FilterDry(dry);
+    // Keep the other kind's key so that Read() can spot misplaced stations.
+    wet["spin"] = true;
+    dry["agitation"] = true;
+    return doc;
+  }();
+  return filter;
 }
 
 Routine Routine::GetDefault(void) {
   Routine config;
   config.name = "Default";
-  std::string wet_names[4] = {"Clean", "Rinse 1", "Rinse 2", "Rinse 3"};
+  const char *wet_names[4] = {"Clean", "Rinse 1", "Rinse 2", "Rinse 3"};
   for (std::size_t i = 0; i < 4; ++i) {
     config.wet_stations[i] = WetStation::GetDefault(wet_names[i]);
   }
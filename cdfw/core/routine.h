@@ -17,18 +17,31 @@
 //   - These stations must either StationType::WET and StationType::DISABLED.
 // - Station 5:
 //   - This station must be either StationType::DRY and StationType::DISABLED.
+//
+// These rules, along with the per-field bounds (name length, Station::kMaxTime
+// and the agitation/spin ranges), are enforced whenever a routine is parsed
+// from JSON; see RoutineJson::Read.
 
 // Local Headers
+#include "cdfw/core/json_arena.h"
 #include "cdfw/core/station.h"
 
 // C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace cdfw {
 
 struct Routine {
-  std::string name;
+  ConfigName name;
 
   // Turntable positions 1 - 4.
   WetStation wet_stations[4];
@@ -36,8 +49,6 @@ struct Routine {
   // Turntable position 5.
   DryStation dry_station;
 
-  virtual ~Routine() = default;
-
   // Returns the factory default routine configuration.
   static Routine GetDefault(void);
 
@@ -45,23 +56,144 @@ struct Routine {
   static Routine GetDisabled(void) { return Routine(); }
 
   // Returns a routine with the given configuration.
-  static Routine GetConfigured(std::string name, WetStation wet1,
-                               WetStation wet2, WetStation wet3,
-                               WetStation wet4, DryStation dry) {
+  static Routine GetConfigured(std::string_view name, const WetStation &wet1,
+                               const WetStation &wet2, const WetStation &wet3,
+                               const WetStation &wet4, const DryStation &dry) {
     return Routine{name, wet1, wet2, wet3, wet4, dry};
   }
 
 protected:
   Routine();
-  Routine(std::string name, WetStation wet1, WetStation wet2, WetStation wet3,
-          WetStation wet4, DryStation dry)
+  Routine(std::string_view name, const WetStation &wet1, const WetStation &wet2,
+          const WetStation &wet3, const WetStation &wet4,
+          const DryStation &dry)
       : name(name), wet_stations{wet1, wet2, wet3, wet4}, dry_station(dry) {}
 };
 
+// A routine is a plain value; copying one never touches the heap.
+static_assert(std::is_trivially_copyable<Routine>::value,
+              "Routine must stay trivially copyable.");
+
+// Fixed-layout, versioned binary encoding of a single routine. Every record is
+// exactly kSize bytes, so a routine library stored as consecutive records can
+// be loaded with one read per record into a stack buffer.
+//
+// Layout (all integers little-endian):
+//   [  0,   4) magic "CDRT"
+//   [  4,   6) format version
+//   [  6,   8) record size
+//   [  8,  40) routine name, NUL padded
+//   [ 40, 200) wet stations 1 - 4, kStationSize bytes each
+//   [200, 240) dry station
+//   [240, 252) reserved, zero
+//   [252, 256) CRC-32 of bytes [0, 252)
+//
+// Station layout:
+//   [ 0, 32) name, NUL padded
+//   [32, 36) time in seconds
+//   [36, 37) enabled
+//   [37, 38) agitation level (wet) or spin type (dry)
+//   [38, 40) reserved, zero
+class RoutineRecord {
+public:
+  static constexpr std::uint16_t kVersion = 1;
+  static constexpr std::size_t kSize = 256;
+  static constexpr std::size_t kStationSize = 40;
+  static constexpr std::size_t kNameSize = 32;
+  static constexpr std::size_t kMaxNameLength = kNameSize - 1;
+  static_assert(kMaxNameLength == ConfigName::kCapacity,
+                "Record names must hold a full ConfigName.");
+
+  // Encodes the routine into the given buffer.
+  static void Encode(const Routine &routine, std::uint8_t (&buf)[kSize]);
+
+  // Decodes the record in the given buffer. Returns false, leaving `routine`
+  // untouched, if the magic, version, size or checksum do not match, or a
+  // station's time or mode is out of range.
+  static bool Decode(const std::uint8_t (&buf)[kSize], Routine &routine);
+};
+
+// Non-virtual mapping between routines and JSON objects.
+class RoutineJson {
+public:
+  // Deepest nesting accepted when parsing; a routine needs three levels.
+  // Bounds the recursion spent skipping unknown values.
+  static constexpr std::uint8_t kNestingLimit = 4;
+
+  static void Write(JsonObject obj, const Routine &config);
+
+  // Validates and converts in a single walk over the document, stopping at
+  // the first bad field. Returns false, with the field's path and the reason
+  // in `error`, leaving `routine` untouched.
+  static bool Read(JsonVariantConst value, Routine &routine,
+                   RoutineError &error);
+  // As above, after checking the outcome of deserializeJson().
+  static bool Read(const DeserializationError &parse, const JsonDocument &doc,
+                   Routine &routine, RoutineError &error);
+
+  // Filter selecting the keys Read() uses. Built on first use.
+  static const JsonDocument &Filter();
+};
+
+// Non-virtual JSON routine codec for hot paths such as importing a routine
+// library. Accepts any ArduinoJson reader or writer (std::istream, Stream,
+// const char * with or without a length, std::string, char buffers, Print).
+//
+// Every document is built in the arena, which is reset at the start of each
+// call, so the codec never touches the general heap.
+class RoutineJsonCodec {
+public:
+  // Arena size that fits any routine: ArduinoJson allocates one whole slot
+  // pool (two pointers per slot) per document, plus a margin for the strings
+  // of a routine whose names all have the maximum length.
+  static constexpr std::size_t kArenaSize =
+      ARDUINOJSON_POOL_CAPACITY * 2 * sizeof(void *) + 1024;
+
+  explicit RoutineJsonCodec(JsonArena &arena) : arena_(arena) {}
+
+  // Parses and validates one routine. Returns false, with the first bad field
+  // in `error` and `routine` untouched, if the input is malformed, breaks the
+  // routine rules or does not fit in the arena.
+  template <typename... TInput>
+  bool Read(Routine &routine, RoutineError &error, TInput &&...input) {
+    JsonDocument doc(DocumentAllocator(&arena_));
+    DeserializationError err = deserializeJson(
+        doc, std::forward<TInput>(input)...,
+        DeserializationOption::Filter(RoutineJson::Filter()),
+        DeserializationOption::NestingLimit(RoutineJson::kNestingLimit));
+    return RoutineJson::Read(err, doc, routine, error);
+  }
+
+  // Writes one routine. Returns the number of bytes written, or 0 if the
+  // document does not fit in the arena.
+  template <typename... TOutput>
+  std::size_t Write(const Routine &routine, TOutput &&...output) {
+    JsonDocument doc(DocumentAllocator(&arena_));
+    RoutineJson::Write(doc.to<JsonObject>(), routine);
+    if (doc.overflowed()) {
+      return 0;
+    }
+
+    return serializeJson(doc, std::forward<TOutput>(output)...);
+  }
+
+private:
+  JsonArena &arena_;
+};
+
 class RoutineSerializer {
 public:
-  // Factory method.
+  // Supported encodings. JSON is the interchange/export format; binary is the
+  // compact RoutineRecord used for on-device routine libraries.
+  enum class Format : std::uint8_t { kJSON = 0, kBINARY = 1 };
+
+  // Factory methods. The default format is JSON. If an arena is given, JSON
+  // documents are built in it and the arena is reset at the start of each
+  // call; otherwise documents use the general heap.
   static std::shared_ptr<RoutineSerializer> Create();
+  static std::shared_ptr<RoutineSerializer> Create(Format format);
+  static std::shared_ptr<RoutineSerializer>
+  Create(Format format, std::shared_ptr<JsonArena> arena);
 
   // Virtual destructor.
   virtual ~RoutineSerializer() = default;
@@ -69,8 +201,52 @@ public:
   // Serializes the given routine.
   virtual std::string Serialize(const Routine &config) = 0;
 
-  // Deserializes the given routine representation.
+  // Deserializes the given routine representation. Input that fails
+  // validation deserializes to a disabled routine.
   virtual Routine Deserialize(const std::string &obj) = 0;
+
+  // Deserializes a routine read incrementally from the given stream (e.g., a
+  // std::ifstream over a file in DirLayout::routines_dir). Peak memory is
+  // bounded by the parsed document: the file is never copied into RAM as a
+  // whole and keys the routine does not use are skipped without allocation.
+  virtual Routine Deserialize(std::istream &input) = 0;
+
+  // As above, but reports why the routine was rejected. Returns false, with
+  // the first bad field in `error`, leaving `routine` untouched.
+  virtual bool Deserialize(std::istream &input, Routine &routine,
+                           RoutineError &error) = 0;
+
+  // Layout of a batch of JSON routines: a single array document, or one
+  // routine object per line (NDJSON). Binary batches are always back-to-back
+  // RoutineRecords and ignore the layout.
+  enum class Layout : std::uint8_t { kARRAY = 0, kNDJSON = 1 };
+
+  // Fills in the next routine of a batch. Returns false when there are none
+  // left.
+  typedef std::function<bool(Routine &routine)> RoutineSource;
+  // Receive each entry of a batch along with its position in the batch.
+  typedef std::function<void(std::size_t index, const Routine &routine)>
+      RoutineSink;
+  typedef std::function<void(std::size_t index, const RoutineError &error)>
+      ErrorSink;
+
+  // Writes a whole library. Every routine goes through the same document
+  // storage and output buffer. Returns the number of routines written.
+  virtual std::size_t SerializeMany(const RoutineSource &source, Layout layout,
+                                    std::ostream &output) = 0;
+  std::size_t SerializeMany(const std::vector<Routine> &routines,
+                            Layout layout, std::ostream &output);
+
+  // Reads a whole library, passing each routine to `on_routine` as soon as it
+  // is parsed and validated, so only one routine is held in RAM at a time. A
+  // bad entry is passed to `on_error` and the batch carries on with the next
+  // one. The exception is a JSON syntax, truncation, size or depth error
+  // inside an array: the position of the next entry is then unknown, so that
+  // error ends the batch (NDJSON resumes at the next line). Returns the number
+  // of routines read.
+  virtual std::size_t DeserializeMany(std::istream &input, Layout layout,
+                                      const RoutineSink &on_routine,
+                                      const ErrorSink &on_error) = 0;
 };
 } // namespace cdfw
 
@@ -0,0 +1,445 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/routine_store.h"
+#include "cdfw/core/crc32.h"
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/path_buf.h"
+#include "cdfw/core/routine.h"
+#include "cdfw/core/span.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace cdfw {
+namespace {
+constexpr const char *kIndexFileName = "index.bin";
+constexpr const char *kRecordExtension = ".rt";
+constexpr std::size_t kRecordFileNameLength = 8 + 3; // "%08x.rt"
+
+// Index layout (all integers little-endian):
+//   [ 0,  4) magic "CDRI"
+//   [ 4,  6) format version
+//   [ 6,  8) reserved, zero
+//   [ 8, 12) entry count
+//   [12, 16) next id
+//   [16,  N) entries: id, hash, name (kIndexEntrySize bytes each)
+//   [ N, +4) CRC-32 of bytes [0, N)
+constexpr std::uint8_t kIndexMagic[4] = {'C', 'D', 'R', 'I'};
+constexpr std::uint16_t kIndexVersion = 1;
+constexpr std::size_t kIndexHeaderSize = 16;
+constexpr std::size_t kIndexEntrySize = 8 + RoutineRecord::kNameSize;
+// Far more routines than a card will hold. Keeps the index size computed from
+// an on-card count from overflowing a 32-bit size_t.
+constexpr std::size_t kMaxIndexEntries = 1 << 16;
+
+void PutU32(std::uint8_t *p, std::uint32_t v) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+  }
+}
+
+std::uint32_t GetU32(const std::uint8_t *p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+// The record's own checksum doubles as its content hash.
+std::uint32_t RecordHash(const std::uint8_t (&buf)[RoutineRecord::kSize]) {
+  return GetU32(buf + RoutineRecord::kSize - 4);
+}
+
+class RoutineStoreFilesImpl : public RoutineStoreFiles {
+public:
+  RoutineStoreFilesImpl(std::shared_ptr<vfs::Volume> volume)
+      : volume_(volume) {}
+  virtual ~RoutineStoreFilesImpl() = default;
+
+  virtual std::size_t Read(vfs::PathView path, std::size_t offset, void *buf,
+                           std::size_t size) override final {
+    // Records and the index are read in one piece, so there is nothing for a
+    // buffer to save.
+    auto file = volume_->OpenRead(path);
+    if (!file.Seek(offset)) {
+      return 0;
+    }
+    return file.Read(ByteSpan(static_cast<std::uint8_t *>(buf), size));
+  }
+
+  virtual bool Write(std::initializer_list<Contents> files) override final {
+    vfs::AtomicBatch batch(*volume_);
+    for (const auto &file : files) {
+      if (!batch.Stage(vfs::Path(file.path), file.data)) {
+        return false;
+      }
+    }
+    return batch.Commit();
+  }
+
+  virtual bool Remove(vfs::PathView path) override final {
+    return volume_->Remove(vfs::Path(path));
+  }
+
+  virtual std::vector<vfs::Path> List(const vfs::Path &dir) override final {
+    std::vector<vfs::Path> names;
+    std::vector<vfs::DirEntry> entries;
+    volume_->List(dir, entries);
+    for (auto &entry : entries) {
+      if (!entry.is_dir) {
+        names.push_back(std::move(entry.name));
+      }
+    }
+    return names;
+  }
+
+private:
+  std::shared_ptr<vfs::Volume> volume_;
+};
+
+class RoutineStoreImpl : public RoutineStore {
+public:
+  RoutineStoreImpl(const vfs::Path &routines_dir,
+                   std::shared_ptr<RoutineStoreFiles> files,
+                   std::size_t cache_capacity)
+      : dir_(routines_dir), files_(files), next_id_(kInvalidId + 1),
+        cache_capacity_(std::max<std::size_t>(cache_capacity, 1)), clock_(0) {
+    cache_.reserve(cache_capacity_);
+  }
+  virtual ~RoutineStoreImpl() = default;
+
+  virtual void Load() override final {
+    cache_.clear();
+    if (!LoadIndex()) {
+      Rebuild();
+    }
+  }
+
+  virtual void Rebuild() override final {
+    entries_.clear();
+    cache_.clear();
+    next_id_ = kInvalidId + 1;
+
+    for (const auto &name : files_->List(dir_)) {
+      RoutineId id;
+      if (!ParseRecordFileName(name.native(), id)) {
+        continue;
+      }
+
+      vfs::PathBuf<> path(dir_);
+      path /= name;
+      std::uint8_t buf[RoutineRecord::kSize];
+      Routine routine = Routine::GetDisabled();
+      if (files_->Read(path, 0, buf, sizeof(buf)) != sizeof(buf) ||
+          !RoutineRecord::Decode(buf, routine)) {
+        continue;
+      }
+
+      RoutineIndexEntry entry;
+      entry.id = id;
+      entry.hash = RecordHash(buf);
+      entry.name = routine.name;
+      entries_.push_back(entry);
+      next_id_ = std::max(next_id_, id + 1);
+    }
+
+    std::sort(entries_.begin(), entries_.end(),
+              [](const RoutineIndexEntry &a, const RoutineIndexEntry &b) {
+                return a.id < b.id;
+              });
+    WriteIndex();
+  }
+
+  virtual const std::vector<RoutineIndexEntry> &List() const override final {
+    return entries_;
+  }
+
+  virtual bool Get(RoutineId id, Routine &routine) override final {
+    if (auto slot = FindCached(id)) {
+      slot->last_used = ++clock_;
+      routine = slot->routine;
+      return true;
+    }
+
+    auto entry = FindEntry(id);
+    if (entry == entries_.end()) {
+      return false;
+    }
+
+    std::uint8_t buf[RoutineRecord::kSize];
+    if (files_->Read(RecordPath(id), 0, buf, sizeof(buf)) != sizeof(buf) ||
+        !RoutineRecord::Decode(buf, routine)) {
+      return false;
+    }
+
+    Cache(id, routine);
+    return true;
+  }
+
+  virtual RoutineId Put(const Routine &routine) override final {
+    RoutineIndexEntry entry;
+    entry.id = next_id_;
+    std::uint8_t record[RoutineRecord::kSize];
+    EncodeRecord(routine, entry, record);
+
+    ++next_id_;
+    entries_.push_back(entry);
+    if (!WriteRecordAndIndex(entry.id, record)) {
+      entries_.pop_back();
+      --next_id_;
+      return kInvalidId;
+    }
+
+    Cache(entry.id, routine);
+    return entry.id;
+  }
+
+  virtual bool Put(RoutineId id, const Routine &routine) override final {
+    auto entry = FindEntry(id);
+    if (entry == entries_.end()) {
+      return false;
+    }
+
+    auto previous = *entry;
+    std::uint8_t record[RoutineRecord::kSize];
+    EncodeRecord(routine, *entry, record);
+    if (!WriteRecordAndIndex(id, record)) {
+      *entry = previous;
+      return false;
+    }
+
+    Cache(id, routine);
+    return true;
+  }
+
+  virtual bool Delete(RoutineId id) override final {
+    auto entry = FindEntry(id);
+    if (entry == entries_.end()) {
+      return false;
+    }
+
+    // Index first: a record the index does not list is never read. If the
+    // index cannot be written the record stays, as the index on the card
+    // still lists it.
+    auto previous = *entry;
+    auto position = entries_.erase(entry);
+    if (!WriteIndex()) {
+      entries_.insert(position, previous);
+      return false;
+    }
+    files_->Remove(RecordPath(id));
+    Evict(id);
+    return true;
+  }
+
+private:
+  struct CacheSlot {
+    RoutineId id;
+    std::uint32_t last_used;
+    Routine routine;
+  };
+
+  const vfs::Path dir_;
+  std::shared_ptr<RoutineStoreFiles> files_;
+  std::vector<RoutineIndexEntry> entries_; // Sorted by id.
+  RoutineId next_id_;
+  const std::size_t cache_capacity_;
+  std::vector<CacheSlot> cache_;
+  std::uint32_t clock_;
+
+  // Built on the stack: records are read in the list and load loops.
+  vfs::PathBuf<> IndexPath() const {
+    vfs::PathBuf<> path(dir_);
+    path /= kIndexFileName;
+    return path;
+  }
+
+  vfs::PathBuf<> RecordPath(RoutineId id) const {
+    char name[kRecordFileNameLength + 1];
+    std::snprintf(name, sizeof(name), "%08lx%s",
+                  static_cast<unsigned long>(id), kRecordExtension);
+    vfs::PathBuf<> path(dir_);
+    path /= name;
+    return path;
+  }
+
+  static bool ParseRecordFileName(std::string_view name, RoutineId &id) {
+    if (name.size() != kRecordFileNameLength ||
+        name.substr(8) != kRecordExtension) {
+      return false;
+    }
+
+    unsigned long value = 0;
+    const char *end = name.data() + 8;
+    auto result = std::from_chars(name.data(), end, value, 16);
+    if (result.ec != std::errc() || result.ptr != end || value == kInvalidId) {
+      return false;
+    }
+    id = static_cast<RoutineId>(value);
+    return true;
+  }
+
+  std::vector<RoutineIndexEntry>::iterator FindEntry(RoutineId id) {
+    auto it = std::lower_bound(
+        entries_.begin(), entries_.end(), id,
+        [](const RoutineIndexEntry &e, RoutineId id) { return e.id < id; });
+    return (it != entries_.end() && it->id == id) ? it : entries_.end();
+  }
+
+  static void EncodeRecord(const Routine &routine, RoutineIndexEntry &entry,
+                           std::uint8_t (&buf)[RoutineRecord::kSize]) {
+    RoutineRecord::Encode(routine, buf);
+    entry.hash = RecordHash(buf);
+    entry.name = routine.name;
+  }
+
+  // Writes a record together with the index, which must already list it.
+  bool WriteRecordAndIndex(RoutineId id,
+                           const std::uint8_t (&record)[RoutineRecord::kSize]) {
+    std::vector<std::uint8_t> index;
+    EncodeIndex(index);
+    return files_->Write({{RecordPath(id), record},
+                          {IndexPath(), ConstByteSpan(index.data(),
+                                                      index.size())}});
+  }
+
+  bool LoadIndex() {
+    std::uint8_t header[kIndexHeaderSize];
+    if (files_->Read(IndexPath(), 0, header, sizeof(header)) !=
+            sizeof(header) ||
+        std::memcmp(header, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+        (header[4] | (header[5] << 8)) != kIndexVersion) {
+      return false;
+    }
+
+    // The count is not covered by the CRC until the body is read, so it is
+    // checked against the file's size before anything is allocated: reading
+    // from the last byte on returns exactly one byte.
+    std::size_t count = GetU32(header + 8);
+    if (count > kMaxIndexEntries) {
+      return false;
+    }
+    const std::size_t body_size = count * kIndexEntrySize + 4;
+    std::uint8_t probe[2];
+    if (files_->Read(IndexPath(), sizeof(header) + body_size - 1, probe,
+                     sizeof(probe)) != 1) {
+      return false;
+    }
+    std::vector<std::uint8_t> body(body_size);
+    if (files_->Read(IndexPath(), sizeof(header), body.data(), body.size()) !=
+        body.size()) {
+      return false;
+    }
+
+    std::uint32_t crc = Crc32(header, sizeof(header));
+    crc = Crc32(body.data(), body.size() - 4, crc);
+    if (crc != GetU32(body.data() + body.size() - 4)) {
+      return false;
+    }
+
+    entries_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::uint8_t *p = body.data() + i * kIndexEntrySize;
+      entries_[i].id = GetU32(p);
+      entries_[i].hash = GetU32(p + 4);
+      auto name = reinterpret_cast<const char *>(p + 8);
+      auto end = std::find(name, name + RoutineRecord::kMaxNameLength, '\0');
+      entries_[i].name.assign(std::string_view(name, end - name));
+    }
+    next_id_ = GetU32(header + 12);
+    return true;
+  }
+
+  bool WriteIndex() {
+    std::vector<std::uint8_t> buf;
+    EncodeIndex(buf);
+    return files_->Write(
+        {{IndexPath(), ConstByteSpan(buf.data(), buf.size())}});
+  }
+
+  void EncodeIndex(std::vector<std::uint8_t> &buf) const {
+    buf.assign(kIndexHeaderSize + entries_.size() * kIndexEntrySize + 4, 0);
+    std::memcpy(buf.data(), kIndexMagic, sizeof(kIndexMagic));
+    buf[4] = static_cast<std::uint8_t>(kIndexVersion);
+    buf[5] = static_cast<std::uint8_t>(kIndexVersion >> 8);
+    PutU32(buf.data() + 8, static_cast<std::uint32_t>(entries_.size()));
+    PutU32(buf.data() + 12, next_id_);
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+      std::uint8_t *p = buf.data() + kIndexHeaderSize + i * kIndexEntrySize;
+      PutU32(p, entries_[i].id);
+      PutU32(p + 4, entries_[i].hash);
+      std::memcpy(p + 8, entries_[i].name.c_str(), entries_[i].name.size());
+    }
+    PutU32(buf.data() + buf.size() - 4, Crc32(buf.data(), buf.size() - 4));
+  }
+
+  CacheSlot *FindCached(RoutineId id) {
+    for (auto &slot : cache_) {
+      if (slot.id == id) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  void Cache(RoutineId id, const Routine &routine) {
+    if (auto slot = FindCached(id)) {
+      slot->last_used = ++clock_;
+      slot->routine = routine;
+      return;
+    }
+
+    if (cache_.size() < cache_capacity_) {
+      cache_.push_back(CacheSlot{id, ++clock_, routine});
+      return;
+    }
+
+    // Replace the least recently used slot.
+    auto lru = std::min_element(cache_.begin(), cache_.end(),
+                                [](const CacheSlot &a, const CacheSlot &b) {
+                                  return a.last_used < b.last_used;
+                                });
+    *lru = CacheSlot{id, ++clock_, routine};
+  }
+
+  void Evict(RoutineId id) {
+    cache_.erase(std::remove_if(
+                     cache_.begin(), cache_.end(),
+                     [id](const CacheSlot &slot) { return slot.id == id; }),
+                 cache_.end());
+  }
+};
+} // namespace
+
+std::shared_ptr<RoutineStoreFiles>
+RoutineStoreFiles::Create(std::shared_ptr<vfs::Volume> volume) {
+  return std::make_shared<RoutineStoreFilesImpl>(volume);
+}
+
+std::unique_ptr<RoutineStore>
+RoutineStore::Create(std::shared_ptr<vfs::Volume> volume,
+                     const DirLayout &layout) {
+  return Create(layout.routines_dir, RoutineStoreFiles::Create(volume));
+}
+
+std::unique_ptr<RoutineStore>
+RoutineStore::Create(const vfs::Path &routines_dir,
+                     std::shared_ptr<RoutineStoreFiles> files,
+                     std::size_t cache_capacity) {
+  return std::make_unique<RoutineStoreImpl>(routines_dir, files,
+                                            cache_capacity);
+}
+} // namespace cdfw
@@ -0,0 +1,117 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_ROUTINE_STORE_H
+#define CDFW_CORE_ROUTINE_STORE_H
+
+// The routine store owns the routine library in DirLayout::routines_dir.
+//
+// On-card layout:
+// - Each routine is one RoutineRecord in its own file, named after its id
+//   (e.g., "0000002a.rt").
+// - "index.bin" holds the id, content hash and name of every routine so that
+//   the library can be listed at boot with a single read instead of opening
+//   every record. If the index is missing or corrupt it is rebuilt from the
+//   records.
+// - Records and the index are replaced with vfs::AtomicBatch, so a record and
+//   the index that lists it are updated together.
+//
+// In RAM the store keeps the index (one RoutineIndexEntry per routine) and a
+// small LRU cache of deserialized routines.
+
+// Local Headers
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/routine.h"
+#include "cdfw/core/span.h"
+#include "cdfw/core/station.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+typedef std::uint32_t RoutineId;
+
+struct RoutineIndexEntry {
+  RoutineId id;
+  std::uint32_t hash; // Checksum of the routine's record.
+  ConfigName name;
+};
+
+// File access used by the routine store. Exists so that the store can be
+// exercised without touching the SD card.
+class RoutineStoreFiles {
+public:
+  // Factory method.
+  static std::shared_ptr<RoutineStoreFiles>
+  Create(std::shared_ptr<vfs::Volume> volume);
+
+  // Virtual destructor.
+  virtual ~RoutineStoreFiles() = default;
+
+  // Reads up to `size` bytes starting at `offset`. Returns the number of bytes
+  // read, which is 0 if the file does not exist.
+  virtual std::size_t Read(vfs::PathView path, std::size_t offset, void *buf,
+                           std::size_t size) = 0;
+
+  struct Contents {
+    vfs::PathView path;
+    ConstByteSpan data;
+  };
+
+  // Replaces the contents of every file as one unit: after a power cut either
+  // all of them or none of them are updated.
+  virtual bool Write(std::initializer_list<Contents> files) = 0;
+
+  virtual bool Remove(vfs::PathView path) = 0;
+
+  // Returns the names of the regular files directly inside `dir`.
+  virtual std::vector<vfs::Path> List(const vfs::Path &dir) = 0;
+};
+
+class RoutineStore {
+public:
+  static constexpr RoutineId kInvalidId = 0;
+  static constexpr std::size_t kDefaultCacheCapacity = 8;
+
+  // Factory methods.
+  static std::unique_ptr<RoutineStore>
+  Create(std::shared_ptr<vfs::Volume> volume, const DirLayout &layout);
+  static std::unique_ptr<RoutineStore>
+  Create(const vfs::Path &routines_dir,
+         std::shared_ptr<RoutineStoreFiles> files,
+         std::size_t cache_capacity = kDefaultCacheCapacity);
+
+  // Virtual destructor.
+  virtual ~RoutineStore() = default;
+
+  // Builds the in-memory index. Intended to be called once at boot.
+  virtual void Load() = 0;
+
+  // Discards the index and rebuilds it by reading every record.
+  virtual void Rebuild() = 0;
+
+  // Returns the index, ordered by id. Never touches the card.
+  virtual const std::vector<RoutineIndexEntry> &List() const = 0;
+
+  // Copies the routine with the given id into `routine`. Returns false if the
+  // id is unknown or its record cannot be read.
+  virtual bool Get(RoutineId id, Routine &routine) = 0;
+
+  // Adds a new routine. Returns its id, or kInvalidId on failure.
+  virtual RoutineId Put(const Routine &routine) = 0;
+
+  // Replaces an existing routine. Returns false if the id is unknown or the
+  // record cannot be written.
+  virtual bool Put(RoutineId id, const Routine &routine) = 0;
+
+  virtual bool Delete(RoutineId id) = 0;
+};
+} // namespace cdfw
+
+#endif // CDFW_CORE_ROUTINE_STORE_H
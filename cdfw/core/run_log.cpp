@@ -0,0 +1,485 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/crc32.h"
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/path_buf.h"
+#include "cdfw/core/span.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace cdfw {
+namespace {
+constexpr const char *kRunsDirName = "runs";
+constexpr const char *kSegmentExtension = ".log";
+constexpr const char *kIndexExtension = ".idx";
+constexpr std::size_t kFileNameLength = 8 + 4; // "%08x.log"
+constexpr std::size_t kSectorSize =
+    RunLog::kRecordsPerSector * RunLog::kRecordSize;
+static_assert(kSectorSize == vfs::File::kSectorSize,
+              "Records must pack whole sectors.");
+
+// Record layout (all integers little-endian):
+//   [ 0,  4) sequence number
+//   [ 4,  8) routine id
+//   [ 8, 12) start time
+//   [12, 16) end time
+//   [16, 36) station durations
+//   [36, 37) abort reason
+//   [37, 38) format version
+//   [38, 60) reserved, zero
+//   [60, 64) CRC-32 of bytes [0, 60)
+constexpr std::uint8_t kRecordVersion = 1;
+
+// Index layout (all integers little-endian):
+//   [ 0,  4) magic "CDRX"
+//   [ 4,  6) format version
+//   [ 6,  8) reserved, zero
+//   [ 8, 12) record count
+//   [12,  N) per sector of records: earliest and latest start time
+//   [ N, +4) CRC-32 of bytes [0, N)
+constexpr std::uint8_t kIndexMagic[4] = {'C', 'D', 'R', 'X'};
+constexpr std::uint16_t kIndexVersion = 1;
+constexpr std::size_t kIndexHeaderSize = 12;
+constexpr std::size_t kIndexEntrySize = 8;
+
+void PutU16(std::uint8_t *p, std::uint16_t v) {
+  p[0] = static_cast<std::uint8_t>(v);
+  p[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+void PutU32(std::uint8_t *p, std::uint32_t v) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+  }
+}
+
+std::uint16_t GetU16(const std::uint8_t *p) {
+  return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::uint32_t GetU32(const std::uint8_t *p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+void EncodeRecord(const RunRecord &run, std::uint8_t *p) {
+  std::memset(p, 0, RunLog::kRecordSize);
+  PutU32(p, run.sequence);
+  PutU32(p + 4, run.routine_id);
+  PutU32(p + 8, run.start_time);
+  PutU32(p + 12, run.end_time);
+  for (std::size_t i = 0; i < RunRecord::kStations; ++i) {
+    PutU32(p + 16 + 4 * i, run.station_durations[i]);
+  }
+  p[36] = static_cast<std::uint8_t>(run.abort_reason);
+  p[37] = kRecordVersion;
+  PutU32(p + 60, Crc32(p, 60));
+}
+
+bool DecodeRecord(const std::uint8_t *p, RunRecord &run) {
+  if (p[37] != kRecordVersion || GetU32(p + 60) != Crc32(p, 60)) {
+    return false;
+  }
+  run.sequence = GetU32(p);
+  run.routine_id = GetU32(p + 4);
+  run.start_time = GetU32(p + 8);
+  run.end_time = GetU32(p + 12);
+  for (std::size_t i = 0; i < RunRecord::kStations; ++i) {
+    run.station_durations[i] = GetU32(p + 16 + 4 * i);
+  }
+  run.abort_reason = static_cast<RunAbortReason>(p[36]);
+  return true;
+}
+
+// Earliest and latest start time of a group of runs.
+struct StartRange {
+  std::uint32_t min = std::numeric_limits<std::uint32_t>::max();
+  std::uint32_t max = 0;
+
+  void Add(std::uint32_t time) {
+    min = std::min(min, time);
+    max = std::max(max, time);
+  }
+  void Add(const StartRange &other) {
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+  bool Overlaps(std::uint32_t from, std::uint32_t to) const {
+    return min <= to && max >= from;
+  }
+};
+
+// The sparse index of a segment: one range per sector of records.
+typedef std::vector<StartRange> SegmentIndex;
+
+struct Segment {
+  std::uint32_t first_sequence;
+  std::size_t count;
+  StartRange starts;
+};
+
+class RunLogImpl : public RunLog {
+public:
+  RunLogImpl(std::shared_ptr<vfs::Volume> volume, const vfs::Path &runs_dir,
+             const RunRetentionPolicy &policy, std::size_t records_per_segment)
+      : volume_(volume), dir_(runs_dir), policy_(policy),
+        records_per_segment_(
+            std::max<std::size_t>((records_per_segment + kRecordsPerSector -
+                                   1) / kRecordsPerSector,
+                                  1) *
+            kRecordsPerSector),
+        next_sequence_(1) {}
+  virtual ~RunLogImpl() = default;
+
+  virtual bool Load() override final {
+    segments_.clear();
+    tail_index_.clear();
+    next_sequence_ = 1;
+    if (!volume_->Exists(dir_) && !volume_->CreateDirs(dir_)) {
+      return false;
+    }
+
+    std::vector<vfs::DirEntry> entries;
+    if (!volume_->List(dir_, entries)) {
+      return false;
+    }
+    std::vector<std::uint32_t> firsts;
+    for (const auto &entry : entries) {
+      std::uint32_t first;
+      if (!entry.is_dir &&
+          ParseFileName(entry.name.native(), kSegmentExtension, first)) {
+        firsts.push_back(first);
+      }
+    }
+    std::sort(firsts.begin(), firsts.end());
+
+    for (std::size_t i = 0; i < firsts.size(); ++i) {
+      Segment segment{firsts[i], 0, StartRange()};
+      SegmentIndex index;
+      bool tail = i + 1 == firsts.size();
+      // The tail is always scanned, as it has no index yet.
+      if (tail || !ReadIndex(segment, index)) {
+        ScanSegment(segment, index);
+        if (!tail) {
+          WriteIndex(segment, index);
+        }
+      }
+      for (const auto &range : index) {
+        segment.starts.Add(range);
+      }
+      segments_.push_back(segment);
+      if (tail) {
+        tail_index_ = std::move(index);
+      }
+    }
+
+    if (!segments_.empty()) {
+      const auto &tail = segments_.back();
+      next_sequence_ =
+          tail.first_sequence + static_cast<std::uint32_t>(tail.count);
+    }
+    return true;
+  }
+
+  virtual bool Append(RunRecord &run) override final {
+    if (segments_.empty() ||
+        segments_.back().count == records_per_segment_) {
+      // A failed index write is not fatal: the index is rebuilt on demand.
+      if (!segments_.empty()) {
+        WriteIndex(segments_.back(), tail_index_);
+      }
+      segments_.push_back(Segment{next_sequence_, 0, StartRange()});
+      tail_index_.clear();
+    }
+    auto &tail = segments_.back();
+
+    RunRecord record = run;
+    record.sequence = next_sequence_;
+    std::uint8_t buf[kRecordSize];
+    EncodeRecord(record, buf);
+
+    // Unbuffered, so the record goes to the backend as one write.
+    auto file = volume_->OpenAppend(FilePath(tail, kSegmentExtension));
+    bool ok = file.Seek(tail.count * kRecordSize) &&
+              file.Write(ConstByteSpan(buf, sizeof(buf))) == sizeof(buf) &&
+              file.Sync();
+    ok = file.Close() && ok;
+    if (!ok) {
+      return false;
+    }
+
+    if (tail.count % kRecordsPerSector == 0) {
+      tail_index_.push_back(StartRange());
+    }
+    tail_index_.back().Add(run.start_time);
+    tail.starts.Add(run.start_time);
+    ++tail.count;
+    run.sequence = next_sequence_++;
+    return true;
+  }
+
+  virtual std::size_t Last(std::size_t n,
+                           std::vector<RunRecord> &runs) override final {
+    runs.clear();
+    std::vector<RunRecord> read;
+    for (auto it = segments_.rbegin();
+         it != segments_.rend() && runs.size() < n; ++it) {
+      std::size_t k = std::min(n - runs.size(), it->count);
+      ReadRecords(*it, it->count - k, k, read);
+      runs.insert(runs.end(), read.rbegin(), read.rend());
+    }
+    return runs.size();
+  }
+
+  virtual std::size_t Between(std::uint32_t from, std::uint32_t to,
+                              std::vector<RunRecord> &runs) override final {
+    runs.clear();
+    if (from > to) {
+      return 0;
+    }
+
+    std::vector<RunRecord> read;
+    SegmentIndex sealed_index;
+    for (const auto &segment : segments_) {
+      if (segment.count == 0 || !segment.starts.Overlaps(from, to)) {
+        continue;
+      }
+      const SegmentIndex *index = &tail_index_;
+      if (&segment != &segments_.back()) {
+        Segment sealed = segment;
+        if (!ReadIndex(sealed, sealed_index)) {
+          ScanSegment(sealed, sealed_index);
+        }
+        index = &sealed_index;
+      }
+
+      // Reads each run of matching sectors in one go.
+      for (std::size_t s = 0; s < index->size();) {
+        if (!(*index)[s].Overlaps(from, to)) {
+          ++s;
+          continue;
+        }
+        std::size_t end = s + 1;
+        while (end < index->size() && (*index)[end].Overlaps(from, to)) {
+          ++end;
+        }
+        std::size_t first = s * kRecordsPerSector;
+        std::size_t last = std::min(end * kRecordsPerSector, segment.count);
+        ReadRecords(segment, first, last - first, read);
+        for (const auto &run : read) {
+          if (run.start_time >= from && run.start_time <= to) {
+            runs.push_back(run);
+          }
+        }
+        s = end;
+      }
+    }
+    return runs.size();
+  }
+
+  virtual std::size_t Compact(std::uint32_t now) override final {
+    std::size_t removed = 0;
+    while (segments_.size() > 1) {
+      const auto &oldest = segments_.front();
+      bool too_many = segments_.size() - 1 > policy_.max_segments;
+      bool too_old = policy_.max_age_s > 0 && now >= oldest.starts.max &&
+                     now - oldest.starts.max > policy_.max_age_s;
+      if (!too_many && !too_old) {
+        break;
+      }
+
+      // The index goes first: an index without its segment would be listed
+      // as nothing, but a segment without its index is rebuilt.
+      volume_->Remove(vfs::Path(FilePath(oldest, kIndexExtension)));
+      if (!volume_->Remove(vfs::Path(FilePath(oldest, kSegmentExtension)))) {
+        break;
+      }
+      segments_.erase(segments_.begin());
+      ++removed;
+    }
+    return removed;
+  }
+
+  virtual std::size_t Count() const override final {
+    std::size_t count = 0;
+    for (const auto &segment : segments_) {
+      count += segment.count;
+    }
+    return count;
+  }
+
+private:
+  std::shared_ptr<vfs::Volume> volume_;
+  const vfs::Path dir_;
+  const RunRetentionPolicy policy_;
+  const std::size_t records_per_segment_;
+  std::vector<Segment> segments_; // Oldest first; the last is the tail.
+  SegmentIndex tail_index_;
+  std::uint32_t next_sequence_;
+
+  vfs::PathBuf<> FilePath(const Segment &segment,
+                          const char *extension) const {
+    char name[kFileNameLength + 1];
+    std::snprintf(name, sizeof(name), "%08lx%s",
+                  static_cast<unsigned long>(segment.first_sequence),
+                  extension);
+    vfs::PathBuf<> path(dir_);
+    path /= name;
+    return path;
+  }
+
+  static bool ParseFileName(std::string_view name, const char *extension,
+                            std::uint32_t &first) {
+    if (name.size() != kFileNameLength || name.substr(8) != extension) {
+      return false;
+    }
+
+    unsigned long value = 0;
+    const char *end = name.data() + 8;
+    auto result = std::from_chars(name.data(), end, value, 16);
+    if (result.ec != std::errc() || result.ptr != end || value == 0) {
+      return false;
+    }
+    first = static_cast<std::uint32_t>(value);
+    return true;
+  }
+
+  // Replaces `runs` with the `count` records from record `first` onwards, in
+  // one read. Records that fail their checksum are left out.
+  void ReadRecords(const Segment &segment, std::size_t first,
+                   std::size_t count, std::vector<RunRecord> &runs) {
+    runs.clear();
+    if (count == 0) {
+      return;
+    }
+    std::vector<std::uint8_t> buf(count * kRecordSize);
+    auto file = volume_->OpenRead(FilePath(segment, kSegmentExtension));
+    if (!file.Seek(first * kRecordSize)) {
+      return;
+    }
+    std::size_t n = file.Read(ByteSpan(buf.data(), buf.size())) / kRecordSize;
+    for (std::size_t i = 0; i < n; ++i) {
+      RunRecord run;
+      if (DecodeRecord(buf.data() + i * kRecordSize, run)) {
+        runs.push_back(run);
+      }
+    }
+  }
+
+  // Counts the valid records at the start of the segment and indexes them.
+  // Stops at the first record that is torn or out of sequence.
+  void ScanSegment(Segment &segment, SegmentIndex &index) {
+    segment.count = 0;
+    index.clear();
+    auto file = volume_->OpenRead(FilePath(segment, kSegmentExtension));
+    std::uint8_t buf[kSectorSize];
+    while (segment.count < records_per_segment_) {
+      std::size_t n = file.Read(ByteSpan(buf, sizeof(buf))) / kRecordSize;
+      StartRange range;
+      std::size_t valid = 0;
+      for (; valid < n; ++valid) {
+        RunRecord run;
+        if (!DecodeRecord(buf + valid * kRecordSize, run) ||
+            run.sequence != segment.first_sequence + segment.count + valid) {
+          break;
+        }
+        range.Add(run.start_time);
+      }
+      if (valid > 0) {
+        index.push_back(range);
+        segment.count += valid;
+      }
+      if (valid < kRecordsPerSector) {
+        break;
+      }
+    }
+  }
+
+  // Reads the segment's index and record count.
+  bool ReadIndex(Segment &segment, SegmentIndex &index) {
+    index.clear();
+    std::size_t max_sectors = records_per_segment_ / kRecordsPerSector;
+    std::vector<std::uint8_t> buf(kIndexHeaderSize +
+                                  max_sectors * kIndexEntrySize + 4);
+    auto file = volume_->OpenRead(FilePath(segment, kIndexExtension));
+    std::size_t n = file.Read(ByteSpan(buf.data(), buf.size()));
+    if (n < kIndexHeaderSize + 4 ||
+        std::memcmp(buf.data(), kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+        GetU16(buf.data() + 4) != kIndexVersion) {
+      return false;
+    }
+
+    std::size_t count = GetU32(buf.data() + 8);
+    std::size_t sectors = (count + kRecordsPerSector - 1) / kRecordsPerSector;
+    std::size_t size = kIndexHeaderSize + sectors * kIndexEntrySize;
+    if (count > records_per_segment_ || n != size + 4 ||
+        GetU32(buf.data() + size) != Crc32(buf.data(), size)) {
+      return false;
+    }
+
+    const std::uint8_t *p = buf.data() + kIndexHeaderSize;
+    for (std::size_t i = 0; i < sectors; ++i, p += kIndexEntrySize) {
+      StartRange range;
+      range.min = GetU32(p);
+      range.max = GetU32(p + 4);
+      index.push_back(range);
+    }
+    segment.count = count;
+    return true;
+  }
+
+  // Not atomic: a torn index fails its checksum and is rebuilt.
+  bool WriteIndex(const Segment &segment, const SegmentIndex &index) {
+    std::size_t size = kIndexHeaderSize + index.size() * kIndexEntrySize;
+    std::vector<std::uint8_t> buf(size + 4, 0);
+    std::memcpy(buf.data(), kIndexMagic, sizeof(kIndexMagic));
+    PutU16(buf.data() + 4, kIndexVersion);
+    PutU32(buf.data() + 8, static_cast<std::uint32_t>(segment.count));
+    std::uint8_t *p = buf.data() + kIndexHeaderSize;
+    for (const auto &range : index) {
+      PutU32(p, range.min);
+      PutU32(p + 4, range.max);
+      p += kIndexEntrySize;
+    }
+    PutU32(buf.data() + size, Crc32(buf.data(), size));
+
+    auto file = volume_->OpenWrite(FilePath(segment, kIndexExtension));
+    file.Write(ConstByteSpan(buf.data(), buf.size()));
+    return file.Close();
+  }
+};
+} // namespace
+
+std::unique_ptr<RunLog> RunLog::Create(std::shared_ptr<vfs::Volume> volume,
+                                       const DirLayout &layout,
+                                       const RunRetentionPolicy &policy) {
+  return Create(volume, layout.data_dir / kRunsDirName, policy);
+}
+
+std::unique_ptr<RunLog> RunLog::Create(std::shared_ptr<vfs::Volume> volume,
+                                       const vfs::Path &runs_dir,
+                                       const RunRetentionPolicy &policy,
+                                       std::size_t records_per_segment) {
+  return std::make_unique<RunLogImpl>(volume, runs_dir, policy,
+                                      records_per_segment);
+}
+} // namespace cdfw
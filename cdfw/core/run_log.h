@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_RUN_LOG_H
+#define CDFW_CORE_RUN_LOG_H
+
+// The run log keeps a durable record of every cleaning run, in the "runs" dir
+// under DirLayout::data_dir.
+//
+// On-card layout:
+// - Runs are appended to segment files named after the sequence number of
+//   their first run (e.g., "00000101.log"). Records are fixed-size and eight
+//   fit exactly in a sector, so an append is a single sector write.
+// - Only the newest (tail) segment is appended to. Once it is full it is
+//   sealed: a sparse time index (e.g., "00000101.idx") is written next to it,
+//   holding the earliest and latest start time of each sector of records, so
+//   that time queries read only the sectors that can match. A missing or
+//   corrupt index is rebuilt from its segment.
+// - A record torn by a power cut fails its checksum. It, and anything after
+//   it, is ignored and overwritten by the next append.
+// - Compact() removes whole sealed segments, oldest first, under a
+//   RunRetentionPolicy.
+//
+// In RAM the log keeps a summary of each segment and the tail segment's
+// index, so that Last() reads only the tail segment. Like the routine store,
+// the log must only be used from one thread.
+
+// Local Headers
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/routine_store.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+enum class RunAbortReason : std::uint8_t {
+  kNONE = 0, // The run completed.
+  kUSER = 1,
+  kPOWER = 2,
+  kERROR = 3,
+};
+
+struct RunRecord {
+  // The four wet stations, then the dry station, as in Routine.
+  static constexpr std::size_t kStations = 5;
+
+  std::uint32_t sequence; // Assigned by RunLog::Append(), from 1.
+  RoutineId routine_id;
+  std::uint32_t start_time; // Seconds since the Unix epoch.
+  std::uint32_t end_time;
+  std::uint32_t station_durations[kStations]; // Seconds.
+  RunAbortReason abort_reason;
+};
+
+struct RunRetentionPolicy {
+  // Sealed segments beyond this many are removed. The tail always stays.
+  std::size_t max_segments = 16;
+  // Sealed segments whose newest run started longer ago than this are
+  // removed. 0 keeps runs regardless of age.
+  std::uint32_t max_age_s = 0;
+};
+
+class RunLog {
+public:
+  static constexpr std::size_t kRecordSize = 64;
+  static constexpr std::size_t kRecordsPerSector = 512 / kRecordSize;
+  static constexpr std::size_t kDefaultRecordsPerSegment = 256;
+
+  // Factory methods. `records_per_segment` is rounded up to a whole number of
+  // sectors.
+  static std::unique_ptr<RunLog>
+  Create(std::shared_ptr<vfs::Volume> volume, const DirLayout &layout,
+         const RunRetentionPolicy &policy = RunRetentionPolicy());
+  static std::unique_ptr<RunLog>
+  Create(std::shared_ptr<vfs::Volume> volume, const vfs::Path &runs_dir,
+         const RunRetentionPolicy &policy = RunRetentionPolicy(),
+         std::size_t records_per_segment = kDefaultRecordsPerSegment);
+
+  // Virtual destructor.
+  virtual ~RunLog() = default;
+
+  // Creates the runs dir if needed and reads the segment summaries. Intended
+  // to be called once at boot. Returns false if the dir cannot be used.
+  virtual bool Load() = 0;
+
+  // Appends `run`, setting its sequence number. Returns false if it could not
+  // be written, in which case the log is unchanged.
+  virtual bool Append(RunRecord &run) = 0;
+
+  // Replaces `runs` with the newest `n` runs, newest first. Returns how many
+  // were found.
+  virtual std::size_t Last(std::size_t n, std::vector<RunRecord> &runs) = 0;
+
+  // Replaces `runs` with the runs that started in [from, to], oldest first.
+  // Returns how many were found.
+  virtual std::size_t Between(std::uint32_t from, std::uint32_t to,
+                              std::vector<RunRecord> &runs) = 0;
+
+  // Removes the sealed segments the retention policy no longer keeps, as of
+  // `now` (seconds since the Unix epoch). Returns how many were removed.
+  virtual std::size_t Compact(std::uint32_t now) = 0;
+
+  // The number of runs held.
+  virtual std::size_t Count() const = 0;
+};
+} // namespace cdfw
+
+#endif // CDFW_CORE_RUN_LOG_H
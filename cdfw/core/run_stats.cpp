@@ -0,0 +1,401 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/run_stats.h"
+#include "cdfw/core/crc32.h"
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/span.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+namespace {
+constexpr const char *kStatsDirName = "stats";
+constexpr const char *kTotalsFileName = "totals.bin";
+constexpr const char *kDaysFileName = "days.bin";
+constexpr std::uint32_t kSecondsPerDay = 24 * 60 * 60;
+
+// Upper bounds of the histogram buckets, in seconds: 60 * sqrt(2)^i, from a
+// minute to a little over two hours, then everything longer.
+constexpr std::uint32_t kBucketLimits[RunAggregate::kBuckets] = {
+    60,   85,   120,  170,  240,  339,  480,  679,
+    960,  1358, 1920, 2715, 3840, 5431, 7680,
+    std::numeric_limits<std::uint32_t>::max(),
+};
+
+// Row layout, shared by both files (all integers little-endian):
+//   [  0,   4) routine id
+//   [  4,   8) day, or RunAggregate::kAllTime
+//   [  8,  12) runs
+//   [ 12,  16) aborts
+//   [ 16,  24) total cycle time
+//   [ 24,  28) min cycle time
+//   [ 28,  32) max cycle time
+//   [ 32,  96) histogram
+//   [ 96, 100) totals rows: slot of the routine's latest day row
+//   [100, 101) format version
+//   [101, 124) reserved, zero
+//   [124, 128) CRC-32 of bytes [0, 124)
+constexpr std::size_t kRowSize = 128;
+constexpr std::uint8_t kRowVersion = 1;
+static_assert(vfs::File::kSectorSize % kRowSize == 0,
+              "Rows must not straddle sectors.");
+
+void PutU32(std::uint8_t *p, std::uint32_t v) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+  }
+}
+
+std::uint32_t GetU32(const std::uint8_t *p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+void EncodeRow(const RunAggregate &aggregate, std::uint32_t day_slot,
+               std::uint8_t *p) {
+  std::memset(p, 0, kRowSize);
+  PutU32(p, aggregate.routine_id);
+  PutU32(p + 4, aggregate.day);
+  PutU32(p + 8, aggregate.runs);
+  PutU32(p + 12, aggregate.aborts);
+  PutU32(p + 16, static_cast<std::uint32_t>(aggregate.total_cycle_s));
+  PutU32(p + 20, static_cast<std::uint32_t>(aggregate.total_cycle_s >> 32));
+  PutU32(p + 24, aggregate.min_cycle_s);
+  PutU32(p + 28, aggregate.max_cycle_s);
+  for (std::size_t i = 0; i < RunAggregate::kBuckets; ++i) {
+    PutU32(p + 32 + 4 * i, aggregate.histogram[i]);
+  }
+  PutU32(p + 96, day_slot);
+  p[100] = kRowVersion;
+  PutU32(p + 124, Crc32(p, 124));
+}
+
+bool DecodeRow(const std::uint8_t *p, RunAggregate &aggregate,
+               std::uint32_t &day_slot) {
+  if (p[100] != kRowVersion || GetU32(p + 124) != Crc32(p, 124)) {
+    return false;
+  }
+  aggregate.routine_id = GetU32(p);
+  aggregate.day = GetU32(p + 4);
+  aggregate.runs = GetU32(p + 8);
+  aggregate.aborts = GetU32(p + 12);
+  aggregate.total_cycle_s = GetU32(p + 16) |
+                            (static_cast<std::uint64_t>(GetU32(p + 20)) << 32);
+  aggregate.min_cycle_s = GetU32(p + 24);
+  aggregate.max_cycle_s = GetU32(p + 28);
+  for (std::size_t i = 0; i < RunAggregate::kBuckets; ++i) {
+    aggregate.histogram[i] = GetU32(p + 32 + 4 * i);
+  }
+  day_slot = GetU32(p + 96);
+  return aggregate.aborts <= aggregate.runs;
+}
+
+RunAggregate EmptyAggregate(RoutineId routine_id, std::uint32_t day) {
+  RunAggregate aggregate{};
+  aggregate.routine_id = routine_id;
+  aggregate.day = day;
+  return aggregate;
+}
+
+// Formats days since the Unix epoch as "YYYY-MM-DD" (proleptic Gregorian).
+void FormatDate(std::uint32_t day, char *buf, std::size_t size) {
+  // Shifts the epoch to 0000-03-01, so leap days fall at the end of a year.
+  const std::uint32_t days = day + 719468;
+  const std::uint32_t era = days / 146097;
+  const std::uint32_t doe = days - era * 146097;
+  const std::uint32_t yoe =
+      (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const std::uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const std::uint32_t mp = (5 * doy + 2) / 153;
+  const std::uint32_t d = doy - (153 * mp + 2) / 5 + 1;
+  const std::uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+  const std::uint32_t y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+  std::snprintf(buf, size, "%04lu-%02lu-%02lu", static_cast<unsigned long>(y),
+                static_cast<unsigned long>(m), static_cast<unsigned long>(d));
+}
+
+// Formats one CSV row into `line`; returns its length.
+std::size_t FormatCsvRow(const RunAggregate &aggregate, char *line,
+                         std::size_t size) {
+  char date[32] = "all";
+  if (aggregate.day != RunAggregate::kAllTime) {
+    FormatDate(aggregate.day, date, sizeof(date));
+  }
+  int n = std::snprintf(line, size, "%lu,%s,%lu,%lu,%.4f",
+                        static_cast<unsigned long>(aggregate.routine_id), date,
+                        static_cast<unsigned long>(aggregate.runs),
+                        static_cast<unsigned long>(aggregate.aborts),
+                        aggregate.AbortRate());
+  // Cycle times are left blank when no run completed.
+  if (aggregate.Completed() == 0) {
+    n += std::snprintf(line + n, size - n, ",,,,,\n");
+  } else {
+    n += std::snprintf(
+        line + n, size - n, ",%.1f,%lu,%lu,%lu,%lu\n", aggregate.MeanCycleS(),
+        static_cast<unsigned long>(aggregate.PercentileCycleS(50)),
+        static_cast<unsigned long>(aggregate.PercentileCycleS(90)),
+        static_cast<unsigned long>(aggregate.min_cycle_s),
+        static_cast<unsigned long>(aggregate.max_cycle_s));
+  }
+  return static_cast<std::size_t>(n);
+}
+
+constexpr const char kCsvHeader[] =
+    "routine_id,date,runs,aborts,abort_rate,mean_cycle_s,p50_cycle_s,"
+    "p90_cycle_s,min_cycle_s,max_cycle_s\n";
+
+class RunStatsImpl : public RunStats {
+public:
+  RunStatsImpl(std::shared_ptr<vfs::Volume> volume, const vfs::Path &stats_dir)
+      : volume_(volume), dir_(stats_dir), totals_path_(dir_ / kTotalsFileName),
+        days_path_(dir_ / kDaysFileName), next_totals_slot_(0),
+        next_day_slot_(0) {}
+  virtual ~RunStatsImpl() = default;
+
+  virtual bool Load() override final {
+    entries_.clear();
+    next_totals_slot_ = 0;
+    next_day_slot_ = 0;
+    if (!volume_->Exists(dir_) && !volume_->CreateDirs(dir_)) {
+      return false;
+    }
+    if (!volume_->Exists(totals_path_)) {
+      return true;
+    }
+
+    std::uint8_t buf[vfs::File::kSectorSize];
+    auto totals = volume_->OpenRead(totals_path_, ByteSpan(buf, sizeof(buf)));
+    std::uint8_t row[kRowSize];
+    for (std::uint32_t slot = 0;
+         totals.Read(ByteSpan(row, sizeof(row))) == sizeof(row); ++slot) {
+      // A torn row loses its routine's totals; its slot is not reused.
+      next_totals_slot_ = slot + 1;
+      Entry entry;
+      if (!DecodeRow(row, entry.totals, entry.day_slot) ||
+          entry.totals.day != RunAggregate::kAllTime) {
+        continue;
+      }
+      entry.totals_slot = slot;
+      entries_[entry.totals.routine_id] = entry;
+    }
+    totals.Close();
+
+    // Day rows past the newest one referenced were orphaned by a power cut,
+    // and are overwritten.
+    auto days = volume_->OpenRead(days_path_);
+    for (auto &kv : entries_) {
+      Entry &entry = kv.second;
+      std::uint32_t unused;
+      entry.has_day = days.Seek(std::uint64_t{entry.day_slot} * kRowSize) &&
+                      days.Read(ByteSpan(row, sizeof(row))) == sizeof(row) &&
+                      DecodeRow(row, entry.day, unused) &&
+                      entry.day.routine_id == kv.first;
+      if (entry.has_day) {
+        next_day_slot_ = std::max(next_day_slot_, entry.day_slot + 1);
+      }
+    }
+    return true;
+  }
+
+  virtual bool Record(const RunRecord &run) override final {
+    auto it = entries_.find(run.routine_id);
+    if (it == entries_.end()) {
+      Entry entry;
+      entry.totals = EmptyAggregate(run.routine_id, RunAggregate::kAllTime);
+      entry.totals_slot = next_totals_slot_++;
+      it = entries_.emplace(run.routine_id, entry).first;
+    }
+    Entry &entry = it->second;
+
+    const std::uint32_t day = run.start_time / kSecondsPerDay;
+    if (!entry.has_day || entry.day.day != day) {
+      entry.day = EmptyAggregate(run.routine_id, day);
+      entry.day_slot = next_day_slot_++;
+      entry.has_day = true;
+    }
+    entry.day.Add(run);
+    entry.totals.Add(run);
+
+    // The day row goes first, so that the totals never point at a row that
+    // was not written.
+    std::uint8_t row[kRowSize];
+    EncodeRow(entry.day, 0, row);
+    if (!WriteRow(days_path_, entry.day_slot, row)) {
+      return false;
+    }
+    EncodeRow(entry.totals, entry.day_slot, row);
+    return WriteRow(totals_path_, entry.totals_slot, row);
+  }
+
+  virtual std::vector<RunAggregate> Totals() const override final {
+    std::vector<RunAggregate> totals;
+    totals.reserve(entries_.size());
+    for (const auto &kv : entries_) {
+      totals.push_back(kv.second.totals);
+    }
+    return totals;
+  }
+
+  virtual bool ExportCsv(const vfs::Path &path) override final {
+    std::uint8_t out_buf[vfs::File::kSectorSize];
+    auto out = volume_->OpenWrite(path, ByteSpan(out_buf, sizeof(out_buf)));
+    out.Write(ConstByteSpan(reinterpret_cast<const std::uint8_t *>(kCsvHeader),
+                            sizeof(kCsvHeader) - 1));
+
+    char line[160];
+    for (const auto &kv : entries_) {
+      WriteLine(out, line, FormatCsvRow(kv.second.totals, line, sizeof(line)));
+    }
+
+    // Orphaned day rows, past next_day_slot_, are left out.
+    std::uint8_t in_buf[vfs::File::kSectorSize];
+    auto days = volume_->OpenRead(days_path_, ByteSpan(in_buf, sizeof(in_buf)));
+    std::uint8_t row[kRowSize];
+    for (std::uint32_t slot = 0;
+         slot < next_day_slot_ &&
+         days.Read(ByteSpan(row, sizeof(row))) == sizeof(row);
+         ++slot) {
+      RunAggregate aggregate;
+      std::uint32_t unused;
+      if (DecodeRow(row, aggregate, unused) &&
+          aggregate.day != RunAggregate::kAllTime) {
+        WriteLine(out, line, FormatCsvRow(aggregate, line, sizeof(line)));
+      }
+    }
+    return out.Close();
+  }
+
+private:
+  struct Entry {
+    RunAggregate totals;
+    RunAggregate day; // The latest day with runs, if has_day.
+    std::uint32_t totals_slot = 0;
+    std::uint32_t day_slot = 0;
+    bool has_day = false;
+  };
+
+  std::shared_ptr<vfs::Volume> volume_;
+  const vfs::Path dir_;
+  const vfs::Path totals_path_;
+  const vfs::Path days_path_;
+  std::map<RoutineId, Entry> entries_;
+  std::uint32_t next_totals_slot_;
+  std::uint32_t next_day_slot_;
+
+  // Unbuffered, so the row goes to the backend as one write.
+  bool WriteRow(const vfs::Path &path, std::uint32_t slot,
+                const std::uint8_t *row) {
+    auto file = volume_->OpenAppend(path);
+    bool ok = file.Seek(std::uint64_t{slot} * kRowSize) &&
+              file.Write(ConstByteSpan(row, kRowSize)) == kRowSize &&
+              file.Sync();
+    return file.Close() && ok;
+  }
+
+  static void WriteLine(vfs::File &out, const char *line, std::size_t size) {
+    out.Write(
+        ConstByteSpan(reinterpret_cast<const std::uint8_t *>(line), size));
+  }
+};
+} // namespace
+
+void RunAggregate::Add(const RunRecord &run) {
+  ++runs;
+  if (run.abort_reason != RunAbortReason::kNONE) {
+    ++aborts;
+    return;
+  }
+
+  const std::uint32_t cycle_s =
+      run.end_time > run.start_time ? run.end_time - run.start_time : 0;
+  total_cycle_s += cycle_s;
+  if (Completed() == 1) {
+    min_cycle_s = cycle_s;
+    max_cycle_s = cycle_s;
+  } else {
+    min_cycle_s = std::min(min_cycle_s, cycle_s);
+    max_cycle_s = std::max(max_cycle_s, cycle_s);
+  }
+  std::size_t bucket = 0;
+  while (cycle_s > kBucketLimits[bucket]) {
+    ++bucket;
+  }
+  ++histogram[bucket];
+}
+
+double RunAggregate::AbortRate() const {
+  return runs == 0 ? 0.0 : static_cast<double>(aborts) / runs;
+}
+
+double RunAggregate::MeanCycleS() const {
+  return Completed() == 0 ? 0.0
+                          : static_cast<double>(total_cycle_s) / Completed();
+}
+
+std::uint32_t RunAggregate::PercentileCycleS(double percent) const {
+  const std::uint32_t completed = Completed();
+  if (completed == 0) {
+    return 0;
+  }
+
+  // The rank of the run sought, then where it falls in its bucket, assuming
+  // the bucket's runs are spread evenly across it. The extremes are exact.
+  const double rank = std::max(
+      1.0, std::ceil(std::min(std::max(percent, 0.0), 100.0) / 100.0 *
+                     completed));
+  if (rank <= 1.0) {
+    return min_cycle_s;
+  }
+  if (rank >= completed) {
+    return max_cycle_s;
+  }
+  std::uint32_t below = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    if (below + histogram[i] < rank) {
+      below += histogram[i];
+      continue;
+    }
+    const double lower = i == 0 ? 0.0 : kBucketLimits[i - 1];
+    const double upper =
+        i + 1 == kBuckets ? max_cycle_s : std::min(kBucketLimits[i],
+                                                   max_cycle_s);
+    const double estimate =
+        lower + (upper - lower) * (rank - below - 0.5) / histogram[i];
+    return std::min(max_cycle_s,
+                    std::max(min_cycle_s, static_cast<std::uint32_t>(
+                                              std::lround(estimate))));
+  }
+  return max_cycle_s;
+}
+
+std::uint32_t RunAggregate::BucketLimit(std::size_t i) {
+  return kBucketLimits[i];
+}
+
+std::unique_ptr<RunStats> RunStats::Create(std::shared_ptr<vfs::Volume> volume,
+                                           const DirLayout &layout) {
+  return Create(volume, layout.data_dir / kStatsDirName);
+}
+
+std::unique_ptr<RunStats> RunStats::Create(std::shared_ptr<vfs::Volume> volume,
+                                           const vfs::Path &stats_dir) {
+  return std::make_unique<RunStatsImpl>(volume, stats_dir);
+}
+} // namespace cdfw
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_RUN_STATS_H
+#define CDFW_CORE_RUN_STATS_H
+
+// Running per-routine statistics over the run history, kept in the "stats" dir
+// under DirLayout::data_dir next to the run log. Nothing is ever recomputed
+// from the history: each completed run is folded into two aggregates, the
+// routine's all-time totals and its row for the day the run started.
+//
+// On-card layout:
+// - "totals.bin" holds one fixed-size aggregate per routine. Each also points
+//   at the routine's latest day row.
+// - "days.bin" holds one aggregate per routine per day, appended as days
+//   begin.
+// Recording a run rewrites the routine's day row and then its totals: two
+// record-sized writes, however long the history. A power cut between them can
+// leave the day row one run ahead of the totals.
+//
+// In RAM the store keeps the totals and each routine's latest day row. Runs
+// are expected in time order; one that started on an earlier day than its
+// routine's latest row starts a new row for that day.
+//
+// Cycle time percentiles come from a histogram with buckets a factor of
+// sqrt(2) apart, so they are estimates within a bucket's width. Like the run
+// log, the store must only be used from one thread.
+
+// Local Headers
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/routine_store.h"
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+// Statistics of the runs of one routine, over all time or over one day (UTC).
+// Cycle times are those of completed runs, from start to end.
+struct RunAggregate {
+  static constexpr std::uint32_t kAllTime = 0xffffffff;
+  static constexpr std::size_t kBuckets = 16;
+
+  RoutineId routine_id;
+  std::uint32_t day; // Days since the Unix epoch, or kAllTime.
+  std::uint32_t runs;
+  std::uint32_t aborts;
+  std::uint64_t total_cycle_s;
+  std::uint32_t min_cycle_s;
+  std::uint32_t max_cycle_s;
+  std::uint32_t histogram[kBuckets];
+
+  // Folds `run` in. O(1).
+  void Add(const RunRecord &run);
+
+  std::uint32_t Completed() const { return runs - aborts; }
+  double AbortRate() const;
+  double MeanCycleS() const;
+  // Estimated cycle time that `percent` of the completed runs did not exceed.
+  std::uint32_t PercentileCycleS(double percent) const;
+
+  // Cycle times up to this go in bucket `i`; the last bucket is unbounded.
+  static std::uint32_t BucketLimit(std::size_t i);
+};
+
+class RunStats {
+public:
+  // Factory methods.
+  static std::unique_ptr<RunStats> Create(std::shared_ptr<vfs::Volume> volume,
+                                          const DirLayout &layout);
+  static std::unique_ptr<RunStats> Create(std::shared_ptr<vfs::Volume> volume,
+                                          const vfs::Path &stats_dir);
+
+  // Virtual destructor.
+  virtual ~RunStats() = default;
+
+  // Creates the stats dir if needed and reads the totals. Intended to be
+  // called once at boot. Returns false if the dir cannot be used.
+  virtual bool Load() = 0;
+
+  // Folds a finished run into its routine's aggregates and writes them out.
+  // Returns false if they could not be written; RAM is updated regardless.
+  virtual bool Record(const RunRecord &run) = 0;
+
+  // Returns the all-time aggregate of every routine with runs, ordered by
+  // routine id. Never touches the card.
+  virtual std::vector<RunAggregate> Totals() const = 0;
+
+  // Writes every aggregate to a CSV file at `path`: the all-time rows, then
+  // the day rows in the order they began. Streams through fixed buffers, so
+  // the history is never held in RAM.
+  virtual bool ExportCsv(const vfs::Path &path) = 0;
+};
+} // namespace cdfw
+
+#endif // CDFW_CORE_RUN_STATS_H
@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_SPAN_H
+#define CDFW_CORE_SPAN_H
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace cdfw {
+// Non-owning view of a contiguous run of T. A stand-in for C++20's std::span,
+// which the toolchains we build with do not provide.
+template <typename T>
+class Span {
+public:
+  typedef T element_type;
+
+  // constructors
+  constexpr Span() noexcept : data_(nullptr), size_(0) {}
+  constexpr Span(T *data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+  template <std::size_t N>
+  constexpr Span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+  // Allows Span<const T> to be built from Span<T>.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_convertible<U (*)[], T (*)[]>::value>>
+  constexpr Span(const Span<U> &other) noexcept
+      : data_(other.data()), size_(other.size()) {}
+
+  // access
+  constexpr T *data() const noexcept { return data_; }
+  constexpr std::size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr T &operator[](std::size_t i) const noexcept { return data_[i]; }
+  constexpr T *begin() const noexcept { return data_; }
+  constexpr T *end() const noexcept { return data_ + size_; }
+
+  // subviews; out of range arguments are clamped
+  constexpr Span first(std::size_t n) const noexcept {
+    return Span(data_, std::min(n, size_));
+  }
+  constexpr Span subspan(std::size_t offset) const noexcept {
+    offset = std::min(offset, size_);
+    return Span(data_ + offset, size_ - offset);
+  }
+  constexpr Span subspan(std::size_t offset, std::size_t n) const noexcept {
+    return subspan(offset).first(n);
+  }
+
+private:
+  T *data_;
+  std::size_t size_;
+};
+
+typedef Span<std::uint8_t> ByteSpan;
+typedef Span<const std::uint8_t> ConstByteSpan;
+} // namespace cdfw
+
+#endif // CDFW_CORE_SPAN_H
@@ -4,33 +4,124 @@
 
 // Local Headers
 #include "cdfw/core/station.h"
+#include "cdfw/core/json_arena.h"
 
 // Third Party Headers
 #include <ArduinoJson.h>
 
 // C++ Standard Library Headers
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <memory>
 #include <string>
 
 namespace cdfw {
 namespace {
+RoutineError::Code ToErrorCode(const DeserializationError &err) {
+  switch (err.code()) {
+  case DeserializationError::Ok:
+    return RoutineError::Code::kNONE;
+  case DeserializationError::EmptyInput:
+  case DeserializationError::IncompleteInput:
+    return RoutineError::Code::kTRUNCATED;
+  case DeserializationError::NoMemory:
+    return RoutineError::Code::kTOO_LARGE;
+  case DeserializationError::TooDeep:
+    return RoutineError::Code::kTOO_DEEP;
+  default:
+    return RoutineError::Code::kSYNTAX;
+  }
+}
+
+bool ReadBool(JsonVariantConst value, const char *prefix, const char *field,
+              bool &out, RoutineError &error) {
+  if (value.isNull()) {
+    return error.Fail(RoutineError::Code::kMISSING, prefix, field);
+  } else if (!value.is<bool>()) {
+    return error.Fail(RoutineError::Code::kWRONG_TYPE, prefix, field);
+  }
+  out = value.as<bool>();
+  return true;
+}
+
+bool ReadUint(JsonVariantConst value, const char *prefix, const char *field,
+              std::uint32_t max, std::uint32_t &out, RoutineError &error) {
+  if (value.isNull()) {
+    return error.Fail(RoutineError::Code::kMISSING, prefix, field);
+  } else if (!value.is<double>()) {
+    // Any number passes is<double>(); strings, objects etc. do not.
+    return error.Fail(RoutineError::Code::kWRONG_TYPE, prefix, field);
+  } else if (!value.is<std::uint32_t>() ||
+             value.as<std::uint32_t>() > max) {
+    // Negative, fractional or too large.
+    return error.Fail(RoutineError::Code::kOUT_OF_RANGE, prefix, field);
+  }
+  out = value.as<std::uint32_t>();
+  return true;
+}
+
+// Reads the fields common to every station and checks that the station is
+// of the kind expected: `other_mode` is the key only the other kind of
+// station has.
+bool ReadStation(JsonVariantConst value, const char *prefix,
+                 const char *other_mode, ConfigName &name, bool &enabled,
+                 std::uint32_t &time, RoutineError &error) {
+  if (value.isNull()) {
+    return error.Fail(RoutineError::Code::kMISSING, prefix);
+  } else if (!value.is<JsonObjectConst>()) {
+    return error.Fail(RoutineError::Code::kWRONG_TYPE, prefix);
+  }
+
+  JsonObjectConst obj = value.as<JsonObjectConst>();
+  if (!obj[other_mode].isNull()) {
+    return error.Fail(RoutineError::Code::kWRONG_STATION, prefix);
+  }
+  if (!StationJson::ReadName(obj["name"], prefix, "name", name, error) ||
+      !ReadBool(obj["enabled"], prefix, "enabled", enabled, error) ||
+      !ReadUint(obj["time"], prefix, "time", Station::kMaxTime, time,
+                error)) {
+    return false;
+  }
+  if (enabled && time == 0) {
+    return error.Fail(RoutineError::Code::kOUT_OF_RANGE, prefix, "time");
+  }
+  return true;
+}
+
+// Reads a station parsed into `doc`. A station that cannot be read is
+// disabled.
+template <typename TStation>
+TStation ReadDocument(const DeserializationError &parse,
+                      const JsonDocument &doc, RoutineError &error) {
+  TStation station = TStation::GetDisabled();
+  if (error.Parsed(parse, doc)) {
+    StationJson::Read(doc.as<JsonVariantConst>(), "", station, error);
+  }
+  return station;
+}
+
 class StationSerializerImpl : public StationSerializer {
 public:
-  StationSerializerImpl() = default;
+  StationSerializerImpl(std::shared_ptr<JsonArena> arena) : arena_(arena) {
+    StationJson::FilterWet(wet_filter_.to<JsonObject>());
+    StationJson::FilterDry(dry_filter_.to<JsonObject>());
+    // Keep the other kind's key so that Read() can spot the wrong station.
+    wet_filter_["spin"] = true;
+    dry_filter_["agitation"] = true;
+  }
   virtual ~StationSerializerImpl() = default;
 
   virtual void Serialize(JsonObject &obj,
                          const WetStation &config) override final {
-    obj["name"] = config.name;
-    obj["enabled"] = config.enabled;
-    obj["time"] = config.time;
-    obj["agitation"] = static_cast<std::uint8_t>(config.agitation);
+    StationJson::Write(obj, config);
   }
 
   virtual std::string Serialize(const WetStation &config) override final {
-    JsonDocument doc;
+    JsonDocument doc(DocumentAllocator(arena_.get()));
     JsonObject obj = doc.add<JsonObject>();
-    Serialize(obj, config);
+    StationJson::Write(obj, config);
 
     std::string json_str;
     serializeJson(obj, json_str);
@@ -39,61 +130,190 @@ public:
 
   virtual void Serialize(JsonObject &obj,
                          const DryStation &config) override final {
-    obj["name"] = config.name;
-    obj["enabled"] = config.enabled;
-    obj["time"] = config.time;
-    obj["spin"] = static_cast<std::uint8_t>(config.spin);
+    StationJson::Write(obj, config);
   }
 
   virtual std::string Serialize(const DryStation &config) override final {
-    JsonDocument doc;
+    JsonDocument doc(DocumentAllocator(arena_.get()));
     JsonObject obj = doc.add<JsonObject>();
-    Serialize(obj, config);
+    StationJson::Write(obj, config);
 
     std::string json_str;
     serializeJson(obj, json_str);
     return json_str;
   }
 
-  virtual WetStation DeserializeWet(const JsonObject &obj) override final {
-    if (obj["enabled"].as<bool>()) {
-      return WetStation::GetConfigured(
-          obj["name"].as<std::string>(), obj["time"].as<std::uint32_t>(),
-          static_cast<WetStation::AgitationLevel>(
-              obj["agitation"].as<std::uint8_t>()));
-    } else {
-      return WetStation::GetDisabled();
-    }
+  virtual WetStation DeserializeWet(const JsonObject &obj,
+                                    RoutineError &error) override final {
+    WetStation station = WetStation::GetDisabled();
+    StationJson::Read(obj, "", station, error);
+    return station;
+  }
+
+  virtual WetStation DeserializeWet(const std::string &obj,
+                                    RoutineError &error) override final {
+    JsonDocument doc(DocumentAllocator(arena_.get()));
+    DeserializationError err = deserializeJson(doc, obj);
+
+    return ReadDocument<WetStation>(err, doc, error);
   }
 
-  virtual WetStation DeserializeWet(const std::string &obj) override final {
-    JsonDocument doc;
-    deserializeJson(doc, obj);
+  virtual WetStation DeserializeWet(std::istream &input,
+                                    RoutineError &error) override final {
+    JsonDocument doc(DocumentAllocator(arena_.get()));
+    DeserializationError err = deserializeJson(
+        doc, input, DeserializationOption::Filter(wet_filter_));
 
-    return DeserializeWet(doc.as<JsonObject>());
+    return ReadDocument<WetStation>(err, doc, error);
   }
 
-  virtual DryStation DeserializeDry(const JsonObject &obj) override final {
-    if (obj["enabled"].as<bool>()) {
-      return DryStation::GetConfigured(
-          obj["name"].as<std::string>(), obj["time"].as<std::uint32_t>(),
-          static_cast<DryStation::SpinType>(obj["spin"].as<std::uint8_t>()));
-    } else {
-      return DryStation::GetDisabled();
-    }
+  virtual DryStation DeserializeDry(const JsonObject &obj,
+                                    RoutineError &error) override final {
+    DryStation station = DryStation::GetDisabled();
+    StationJson::Read(obj, "", station, error);
+    return station;
   }
 
-  virtual DryStation DeserializeDry(const std::string &obj) override final {
-    JsonDocument doc;
-    deserializeJson(doc, obj);
+  virtual DryStation DeserializeDry(const std::string &obj,
+                                    RoutineError &error) override final {
+    JsonDocument doc(DocumentAllocator(arena_.get()));
+    DeserializationError err = deserializeJson(doc, obj);
 
-    return DeserializeDry(doc.as<JsonObject>());
+    return ReadDocument<DryStation>(err, doc, error);
   }
+
+  virtual DryStation DeserializeDry(std::istream &input,
+                                    RoutineError &error) override final {
+    JsonDocument doc(DocumentAllocator(arena_.get()));
+    DeserializationError err = deserializeJson(
+        doc, input, DeserializationOption::Filter(dry_filter_));
+
+    return ReadDocument<DryStation>(err, doc, error);
+  }
+
+private:
+  std::shared_ptr<JsonArena> arena_;
+  // Filters are built once and live on the heap, never in the arena.
+  JsonDocument wet_filter_;
+  JsonDocument dry_filter_;
 };
 } // namespace
 
+bool RoutineError::Fail(Code code, const char *prefix, const char *field) {
+  char buf[decltype(path)::kCapacity + 1];
+  std::snprintf(buf, sizeof(buf), "%s%s%s", prefix,
+                (*prefix && *field) ? "." : "", field);
+  this->code = code;
+  path = buf;
+  return false;
+}
+
+bool RoutineError::Parsed(const DeserializationError &parse,
+                          const JsonDocument &doc) {
+  Code parsed = ToErrorCode(parse);
+  if (parsed == Code::kNONE && doc.overflowed()) {
+    parsed = Code::kTOO_LARGE;
+  }
+  if (parsed != Code::kNONE) {
+    *this = RoutineError{parsed};
+    return false;
+  }
+  return true;
+}
+
+void StationJson::Write(JsonObject obj, const WetStation &config) {
+  obj["name"] = config.name.c_str();
+  obj["enabled"] = config.enabled;
+  obj["time"] = config.time;
+  obj["agitation"] = static_cast<std::uint8_t>(config.agitation);
+}
+
+void StationJson::Write(JsonObject obj, const DryStation &config) {
+  obj["name"] = config.name.c_str();
+  obj["enabled"] = config.enabled;
+  obj["time"] = config.time;
+  obj["spin"] = static_cast<std::uint8_t>(config.spin);
+}
+
+bool StationJson::Read(JsonVariantConst value, const char *prefix,
+                       WetStation &station, RoutineError &error) {
+  ConfigName name;
+  bool enabled = false;
+  std::uint32_t time = 0;
+  std::uint32_t agitation = 0;
+  constexpr auto kMaxAgitation =
+      static_cast<std::uint32_t>(WetStation::AgitationLevel::kHIGH);
+  if (!ReadStation(value, prefix, "spin", name, enabled, time, error) ||
+      !ReadUint(value["agitation"], prefix, "agitation", kMaxAgitation,
+                agitation, error)) {
+    return false;
+  }
+
+  station = enabled ? WetStation::GetConfigured(
+                          name.view(), time,
+                          static_cast<WetStation::AgitationLevel>(agitation))
+                    : WetStation::GetDisabled();
+  return true;
+}
+
+bool StationJson::Read(JsonVariantConst value, const char *prefix,
+                       DryStation &station, RoutineError &error) {
+  ConfigName name;
+  bool enabled = false;
+  std::uint32_t time = 0;
+  std::uint32_t spin = 0;
+  constexpr auto kMaxSpin =
+      static_cast<std::uint32_t>(DryStation::SpinType::kBIDIRECTIONAL);
+  if (!ReadStation(value, prefix, "agitation", name, enabled, time, error) ||
+      !ReadUint(value["spin"], prefix, "spin", kMaxSpin, spin, error)) {
+    return false;
+  }
+
+  station = enabled ? DryStation::GetConfigured(
+                          name.view(), time,
+                          static_cast<DryStation::SpinType>(spin))
+                    : DryStation::GetDisabled();
+  return true;
+}
+
+bool StationJson::ReadName(JsonVariantConst value, const char *prefix,
+                           const char *field, ConfigName &name,
+                           RoutineError &error) {
+  if (value.isNull()) {
+    return error.Fail(RoutineError::Code::kMISSING, prefix, field);
+  } else if (!value.is<const char *>()) {
+    return error.Fail(RoutineError::Code::kWRONG_TYPE, prefix, field);
+  }
+
+  const char *str = value.as<const char *>();
+  if (std::strlen(str) > ConfigName::kCapacity) {
+    return error.Fail(RoutineError::Code::kTOO_LONG, prefix, field);
+  }
+  name = str;
+  return true;
+}
+
+void StationJson::FilterWet(JsonObject filter) {
+  filter["name"] = true;
+  filter["enabled"] = true;
+  filter["time"] = true;
+  filter["agitation"] = true;
+}
+
+void StationJson::FilterDry(JsonObject filter) {
+  filter["name"] = true;
+  filter["enabled"] = true;
+  filter["time"] = true;
+  filter["spin"] = true;
+}
+
 std::shared_ptr<StationSerializer> StationSerializer::Create() {
-  return std::make_shared<StationSerializerImpl>();
+  return Create(nullptr);
+}
+
+std::shared_ptr<StationSerializer>
+StationSerializer::Create(std::shared_ptr<JsonArena> arena) {
+  return std::make_shared<StationSerializerImpl>(arena);
 }
 
 } // namespace cdfw
@@ -8,31 +8,47 @@
 // A station is the base element of a cleaning routine.
 // Stations fall into two categories: wet (e.g., clean, rinse) and dry.
 
+// Local Headers
+#include "cdfw/core/inline_string.h"
+#include "cdfw/core/json_arena.h"
+
 // Third Party Headers
 #include <ArduinoJson.h>
 
 // C++ Standard Library Headers
+#include <cstddef>
 #include <cstdint>
+#include <iosfwd>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace cdfw {
+// Station and routine names are stored inline; longer names are truncated.
+constexpr std::size_t kMaxConfigNameLength = 31;
+typedef InlineString<kMaxConfigNameLength> ConfigName;
 
 // ---------------------------------------------------------------------------
 // Abstract Station Config Type
 // ---------------------------------------------------------------------------
 
 // Every station has a name and a type.
+//
+// Station config types are plain values: they own no heap memory and are
+// trivially copyable, so copies between models, presenters and the routine
+// store are a memcpy.
 struct Station {
-  std::string name;
+  // Longest time a station may run for, in seconds.
+  static constexpr std::uint32_t kMaxTime = 60 * 60;
+
+  ConfigName name;
   bool enabled;
   std::uint32_t time; // Time in seconds.
 
-  virtual ~Station() = default;
-
 protected:
   Station() = default;
-  Station(std::string name, bool enabled, std::uint32_t time)
+  Station(std::string_view name, bool enabled, std::uint32_t time)
       : name(name), enabled(enabled), time(time) {}
 };
 
@@ -53,11 +69,11 @@ struct WetStation : Station {
 
   AgitationLevel agitation;
 
-  virtual ~WetStation() = default;
-
-  static WetStation GetDefault(std::string name) { return WetStation(name); }
+  static WetStation GetDefault(std::string_view name) {
+    return WetStation(name);
+  }
   static WetStation GetDisabled() { return WetStation(); }
-  static WetStation GetConfigured(std::string name, std::uint32_t time,
+  static WetStation GetConfigured(std::string_view name, std::uint32_t time,
                                   AgitationLevel agitation) {
     return WetStation(name, time, agitation);
   }
@@ -68,13 +84,14 @@ private:
       : Station("Disabled", false, 0), agitation(AgitationLevel::kNONE) {}
 
   // Constructor for a configured station.
-  WetStation(std::string name, std::uint32_t time, AgitationLevel agitation)
+  WetStation(std::string_view name, std::uint32_t time,
+             AgitationLevel agitation)
       : Station(name, true, time), agitation(agitation) {}
 
   // By default we assume:
   // - 3 minutes for the wet station.
   // - Medium agitation.
-  WetStation(std::string name)
+  explicit WetStation(std::string_view name)
       : Station(name, true, 180), agitation(AgitationLevel::kMEDIUM) {}
 };
 
@@ -88,11 +105,11 @@ struct DryStation : Station {
 
   SpinType spin;
 
-  virtual ~DryStation() = default;
-
-  static DryStation GetDefault(std::string name) { return DryStation(name); }
+  static DryStation GetDefault(std::string_view name) {
+    return DryStation(name);
+  }
   static DryStation GetDisabled() { return DryStation(); }
-  static DryStation GetConfigured(std::string name, std::uint32_t time,
+  static DryStation GetConfigured(std::string_view name, std::uint32_t time,
                                   SpinType spin) {
     return DryStation(name, time, spin);
   }
@@ -102,20 +119,92 @@ private:
   DryStation() : Station("Disabled", false, 0), spin(SpinType::kNONE) {}
 
   // Constructor for a configured station.
-  DryStation(std::string name, std::uint32_t time, SpinType spin)
+  DryStation(std::string_view name, std::uint32_t time, SpinType spin)
       : Station(name, true, time), spin(spin) {}
 
   // By default we assume:
   // - 6 minutes for the dry station.
   // - Uni-directional spin.
-  DryStation(std::string name)
+  explicit DryStation(std::string_view name)
       : Station(name, true, 360), spin(SpinType::kUNIDIRECTIONAL) {}
 };
 
+static_assert(std::is_trivially_copyable<WetStation>::value,
+              "WetStation must stay trivially copyable.");
+static_assert(std::is_trivially_copyable<DryStation>::value,
+              "DryStation must stay trivially copyable.");
+
+// Why a serialized routine or station was rejected.
+struct RoutineError {
+  enum class Code : std::uint8_t {
+    kNONE = 0,
+    kSYNTAX = 1,     // Not valid JSON.
+    kTRUNCATED = 2,  // Input ended inside an entry.
+    kTOO_LARGE = 3,  // Entry does not fit in memory.
+    kNOT_OBJECT = 4, // Valid JSON, but not a routine object.
+    kCORRUPT = 5,    // Binary record failed validation.
+    kTOO_DEEP = 6,   // Nested deeper than any routine.
+
+    // Field-level errors; `path` names the field.
+    kMISSING = 7,        // Required field is absent or null.
+    kWRONG_TYPE = 8,     // Field has the wrong JSON type.
+    kOUT_OF_RANGE = 9,   // Number outside the field's bounds.
+    kTOO_LONG = 10,      // Name longer than kMaxConfigNameLength.
+    kWRONG_COUNT = 11,   // Not exactly four wet stations.
+    kWRONG_STATION = 12, // Station of the wrong kind for its position.
+  };
+
+  Code code;
+  // Path of the offending field (e.g., "wet_stations[2].time"). Empty when the
+  // entry is rejected as a whole.
+  InlineString<31> path;
+
+  // Records the error for `prefix.field` (or just one of them if the other is
+  // empty). Always returns false.
+  bool Fail(Code code, const char *prefix, const char *field = "");
+
+  // Records the outcome of deserializeJson() into `doc`, counting a document
+  // that ran out of memory as too large. Returns true, leaving the error
+  // untouched, if the document was read whole.
+  bool Parsed(const DeserializationError &parse, const JsonDocument &doc);
+};
+
+// Non-virtual mapping between station configs and JSON objects. Shared by
+// every serializer that embeds stations, so that hot paths (e.g., importing a
+// routine library) do not pay for virtual dispatch per station.
+class StationJson {
+public:
+  static void Write(JsonObject obj, const WetStation &config);
+  static void Write(JsonObject obj, const DryStation &config);
+
+  // Validates and converts one station, stopping at the first bad field: a
+  // missing or mistyped field, a name over kMaxConfigNameLength, a time over
+  // Station::kMaxTime (or zero while enabled), an unknown agitation or spin,
+  // or the other kind of station's key. Returns false, with the field's path
+  // below `prefix` and the reason in `error`, leaving `station` untouched.
+  static bool Read(JsonVariantConst value, const char *prefix,
+                   WetStation &station, RoutineError &error);
+  static bool Read(JsonVariantConst value, const char *prefix,
+                   DryStation &station, RoutineError &error);
+
+  // Reads the name at `prefix.field`, with the same checks as above.
+  static bool ReadName(JsonVariantConst value, const char *prefix,
+                       const char *field, ConfigName &name,
+                       RoutineError &error);
+
+  // Marks the keys read by Read() in the given ArduinoJson filter object.
+  static void FilterWet(JsonObject filter);
+  static void FilterDry(JsonObject filter);
+};
+
 class StationSerializer {
 public:
-  // Factory method.
+  // Factory methods. If an arena is given, every document is built in it and
+  // the arena is reset at the start of each call; otherwise documents use the
+  // general heap.
   static std::shared_ptr<StationSerializer> Create();
+  static std::shared_ptr<StationSerializer>
+  Create(std::shared_ptr<JsonArena> arena);
 
   // Virtual destructor.
   virtual ~StationSerializer() = default;
@@ -128,11 +217,22 @@ public:
   virtual void Serialize(JsonObject &dobj, const DryStation &config) = 0;
   virtual std::string Serialize(const DryStation &config) = 0;
 
-  // Deserializes the given configuration object.
-  virtual WetStation DeserializeWet(const JsonObject &obj) = 0;
-  virtual WetStation DeserializeWet(const std::string &obj) = 0;
-  virtual DryStation DeserializeDry(const JsonObject &obj) = 0;
-  virtual DryStation DeserializeDry(const std::string &obj) = 0;
+  // Deserializes the given configuration object. The stream overloads parse
+  // incrementally from the reader and never materialize unknown keys. Input
+  // that is malformed or fails StationJson::Read() yields a disabled station,
+  // with the reason in `error`.
+  virtual WetStation DeserializeWet(const JsonObject &obj,
+                                    RoutineError &error) = 0;
+  virtual WetStation DeserializeWet(const std::string &obj,
+                                    RoutineError &error) = 0;
+  virtual WetStation DeserializeWet(std::istream &input,
+                                    RoutineError &error) = 0;
+  virtual DryStation DeserializeDry(const JsonObject &obj,
+                                    RoutineError &error) = 0;
+  virtual DryStation DeserializeDry(const std::string &obj,
+                                    RoutineError &error) = 0;
+  virtual DryStation DeserializeDry(std::istream &input,
+                                    RoutineError &error) = 0;
 };
 
 } // namespace cdfw
@@ -7,6 +7,7 @@
 #include "cdfw/core/ui/clean_presenter.h"
 #include "cdfw/core/ui/home_presenter.h"
 #include "cdfw/core/ui/routines_presenter.h"
+#include "cdfw/core/ui/screen_cache.h"
 #include "cdfw/core/ui/settings_presenter.h"
 
 // C++ Standard Library Headers
@@ -16,39 +17,74 @@ namespace cdfw {
 namespace core {
 namespace ui {
 namespace {
+// Adapts a presenter to the screen cache.
+template <typename Presenter> class PresenterScreen : public CachedScreen {
+public:
+  PresenterScreen(Presenter *presenter, AppPresenter *app_presenter)
+      : presenter_(presenter), app_presenter_(app_presenter) {}
+  virtual ~PresenterScreen() = default;
+
+  virtual void Build() override final { presenter_->Init(app_presenter_); }
+  virtual void Destroy() override final { presenter_->Destroy(); }
+
+private:
+  Presenter *presenter_;
+  AppPresenter *app_presenter_;
+};
+
 class AppPresenterImpl : public AppPresenter {
 public:
   AppPresenterImpl(std::unique_ptr<HomePresenter> home_presenter,
                    std::unique_ptr<CleanPresenter> clean_presenter,
                    std::unique_ptr<RoutinesPresenter> routines_presenter,
-                   std::shared_ptr<SettingsPresenter> settings_presenter)
+                   std::shared_ptr<SettingsPresenter> settings_presenter,
+                   std::unique_ptr<ScreenCache> screen_cache)
       : home_presenter_(std::move(home_presenter)),
         clean_presenter_(std::move(clean_presenter)),
         routines_presenter_(std::move(routines_presenter)),
-        settings_presenter_(settings_presenter) {}
+        settings_presenter_(settings_presenter),
+        screen_cache_(std::move(screen_cache)),
+        home_screen_(home_presenter_.get(), this),
+        clean_screen_(clean_presenter_.get(), this),
+        routines_screen_(routines_presenter_.get(), this),
+        settings_screen_(settings_presenter_.get(), this) {}
 
   ~AppPresenterImpl() = default;
 
-  virtual void Init() override final {
-    home_presenter_->Init(this);
-    clean_presenter_->Init(this);
-    routines_presenter_->Init(this);
-    settings_presenter_->Init(this);
-  }
+  // The other screens wait for their first Show*().
+  virtual void Init() override final { screen_cache_->Use(&home_screen_); }
 
-  virtual void ShowHome() override final { home_presenter_->Show(); }
-  virtual void ShowHomeDelayed() override final {
-    home_presenter_->DelayedShow();
+  virtual void ShowHome() override final {
+    screen_cache_->Use(&home_screen_);
+    home_presenter_->Show();
+    screen_cache_->Trim();
+  }
+  virtual void ShowClean() override final {
+    screen_cache_->Use(&clean_screen_);
+    clean_presenter_->Show();
+    screen_cache_->Trim();
+  }
+  virtual void ShowRoutines() override final {
+    screen_cache_->Use(&routines_screen_);
+    routines_presenter_->Show();
+    screen_cache_->Trim();
+  }
+  virtual void ShowSettings() override final {
+    screen_cache_->Use(&settings_screen_);
+    settings_presenter_->Show();
+    screen_cache_->Trim();
   }
-  virtual void ShowClean() override final { clean_presenter_->Show(); }
-  virtual void ShowRoutines() override final { routines_presenter_->Show(); }
-  virtual void ShowSettings() override final { settings_presenter_->Show(); }
 
 private:
   std::unique_ptr<HomePresenter> home_presenter_;
   std::unique_ptr<CleanPresenter> clean_presenter_;
   std::unique_ptr<RoutinesPresenter> routines_presenter_;
   std::shared_ptr<SettingsPresenter> settings_presenter_;
+  std::unique_ptr<ScreenCache> screen_cache_;
+  PresenterScreen<HomePresenter> home_screen_;
+  PresenterScreen<CleanPresenter> clean_screen_;
+  PresenterScreen<RoutinesPresenter> routines_screen_;
+  PresenterScreen<SettingsPresenter> settings_screen_;
 };
 } // namespace
 
@@ -56,10 +92,12 @@ std::unique_ptr<AppPresenter>
 AppPresenter::Create(std::unique_ptr<HomePresenter> home_presenter,
                      std::unique_ptr<CleanPresenter> clean_presenter,
                      std::unique_ptr<RoutinesPresenter> routines_presenter,
-                     std::shared_ptr<SettingsPresenter> settings_presenter) {
+                     std::shared_ptr<SettingsPresenter> settings_presenter,
+                     std::unique_ptr<ScreenCache> screen_cache) {
   return std::make_unique<AppPresenterImpl>(
       std::move(home_presenter), std::move(clean_presenter),
-      std::move(routines_presenter), settings_presenter);
+      std::move(routines_presenter), settings_presenter,
+      std::move(screen_cache));
 }
 } // namespace ui
 } // namespace core
@@ -5,6 +5,9 @@
 #ifndef CDFW_CORE_UI_APP_PRESENTER_H
 #define CDFW_CORE_UI_APP_PRESENTER_H
 
+// Local Headers
+#include "cdfw/core/ui/screen_cache.h"
+
 // C++ Standard Library Headers
 #include <memory>
 
@@ -20,6 +23,10 @@ class SettingsPresenter;
 // Top level presenter for the application. This presenter serves two purposes:
 // (1) it handles initialization of all other presenters, and (2) it provides a
 // a means for switching between presenters.
+//
+// Screens are built on their first Show*() and kept in `screen_cache`, which
+// deletes the least recently shown ones once they outgrow its budget. A
+// deleted screen is rebuilt the next time it is shown.
 class AppPresenter {
 public:
   // Factory method.
@@ -27,12 +34,13 @@ public:
   Create(std::unique_ptr<HomePresenter> home_presenter,
          std::unique_ptr<CleanPresenter> clean_presenter,
          std::unique_ptr<RoutinesPresenter> routines_presenter,
-         std::shared_ptr<SettingsPresenter> settings_presenter);
+         std::shared_ptr<SettingsPresenter> settings_presenter,
+         std::unique_ptr<ScreenCache> screen_cache);
 
   // Virtual d'tor.
   virtual ~AppPresenter() = default;
 
-  // Initializes all presenters.
+  // Builds the home screen, ready to be shown.
   virtual void Init() = 0;
 
   // ---------------------------------------------------------------------------
@@ -40,7 +48,6 @@ public:
   // ---------------------------------------------------------------------------
 
   virtual void ShowHome() = 0;
-  virtual void ShowHomeDelayed() = 0;
   virtual void ShowClean() = 0;
   virtual void ShowRoutines() = 0;
   virtual void ShowSettings() = 0;
@@ -26,6 +26,8 @@ public:
     view_->Init(this);
   }
 
+  virtual void Destroy() override final { view_->Destroy(); }
+
   virtual void Show() override final { view_->Show(); }
 
   virtual void OnBackClicked() override final { app_presenter_->ShowHome(); }
@@ -29,7 +29,10 @@ public:
   // Presenter -> View Interface
   // ---------------------------------------------------------------------------
 
+  // Builds the object tree. Called again to rebuild it after Destroy().
   virtual void Init(CleanPresenter *presenter) = 0;
+  // Deletes the object tree.
+  virtual void Destroy() = 0;
   virtual void Show() = 0;
 };
 
@@ -47,7 +50,11 @@ public:
   // AppPresenter -> Presenter Interface
   // ---------------------------------------------------------------------------
 
+  // Builds the view; the first call also sets up the model. Called again to
+  // rebuild the view after Destroy().
   virtual void Init(AppPresenter *app_presenter) = 0;
+  // Deletes the view's object tree. Model changes reach it on the next Init().
+  virtual void Destroy() = 0;
   virtual void Show() = 0;
 
   // ---------------------------------------------------------------------------
@@ -15,24 +15,32 @@ public:
   HomePresenterImpl(std::unique_ptr<HomePresenterView> view,
                     std::unique_ptr<HomeModel> model)
       : app_presenter_(nullptr), view_(std::move(view)),
-        model_(std::move(model)) {}
+        model_(std::move(model)), model_ready_(false), view_built_(false) {}
   virtual ~HomePresenterImpl() = default;
 
   virtual void Init(AppPresenter *app_presenter) override final {
     // Record the app presenter.
     app_presenter_ = app_presenter;
 
-    // Initialize the model and register as a subscriber.
-    model_->Init();
-    model_->RegisterSubscriber(this);
+    // Initialize the model and register as a subscriber, once.
+    if (!model_ready_) {
+      model_->Init();
+      model_->RegisterSubscriber(this);
+      model_ready_ = true;
+    }
 
     // Setup the view.
     view_->Init(this);
+    view_built_ = true;
     UpdateWifiIcon();
   }
 
+  virtual void Destroy() override final {
+    view_->Destroy();
+    view_built_ = false;
+  }
+
   virtual void Show() override final { view_->Show(); }
-  virtual void DelayedShow() override final { view_->DelayedShow(); }
   virtual void OnSettingsClicked() override final {
     app_presenter_->ShowSettings();
   }
@@ -40,12 +48,18 @@ public:
   virtual void OnRoutinesClicked() override final {
     app_presenter_->ShowRoutines();
   }
-  virtual void WifiStateChanged() override final { UpdateWifiIcon(); }
+  virtual void WifiStateChanged() override final {
+    if (view_built_) {
+      UpdateWifiIcon();
+    }
+  }
 
 private:
   AppPresenter *app_presenter_;
   std::unique_ptr<HomePresenterView> view_;
   std::unique_ptr<HomeModel> model_;
+  bool model_ready_;
+  bool view_built_;
 
   void UpdateWifiIcon() {
     switch (model_->GetWifiState()) {
@@ -31,9 +31,11 @@ public:
   // Presenter -> View Interface
   // ---------------------------------------------------------------------------
 
+  // Builds the object tree. Called again to rebuild it after Destroy().
   virtual void Init(HomePresenter *presenter) = 0;
+  // Deletes the object tree.
+  virtual void Destroy() = 0;
   virtual void Show() = 0;
-  virtual void DelayedShow() = 0;
   virtual void SetWifiColor(const lv_color_t &color) = 0;
   virtual void SetWifiVisible(bool visible) = 0;
 };
@@ -52,9 +54,12 @@ public:
   // AppPresenter -> Presenter Interface
   // ---------------------------------------------------------------------------
 
+  // Builds the view; the first call also sets up the model. Called again to
+  // rebuild the view after Destroy().
   virtual void Init(AppPresenter *app_presenter) = 0;
+  // Deletes the view's object tree. Model changes reach it on the next Init().
+  virtual void Destroy() = 0;
   virtual void Show() = 0;
-  virtual void DelayedShow() = 0;
 
   // ---------------------------------------------------------------------------
   // View -> Presenter Interface
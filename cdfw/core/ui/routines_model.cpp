@@ -5,20 +5,77 @@
 // Local Headers
 #include "cdfw/core/ui/routines_model.h"
 
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/routine.h"
+#include "cdfw/core/routine_store.h"
+
 // C++ Standard Library Headers
+#include <list>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace cdfw {
 namespace core {
 namespace ui {
+namespace {
+std::vector<std::string> CopyNames(const RoutineStore &store) {
+  std::vector<std::string> names;
+  names.reserve(store.List().size());
+  for (const auto &entry : store.List()) {
+    names.emplace_back(entry.name.c_str());
+  }
+  return names;
+}
+
 class RoutinesModelImpl : public RoutinesModel {
 public:
-  RoutinesModelImpl() = default;
+  RoutinesModelImpl(std::shared_ptr<RoutineStore> store,
+                    std::shared_ptr<IoWorker> worker)
+      : store_(store), worker_(worker), names_(CopyNames(*store)) {}
   virtual ~RoutinesModelImpl() = default;
+
+  virtual void
+  RegisterSubscriber(RoutinesModelSubscriber *subscriber) override final {
+    subscribers_.push_back(subscriber);
+  }
+
+  virtual std::vector<std::string> GetRoutineNames() override final {
+    return names_;
+  }
+
+  virtual bool SaveRoutine(const Routine &routine) override final {
+    // The job fills in the new names on the worker; the completion publishes
+    // them on the UI loop.
+    auto names = std::make_shared<std::vector<std::string>>();
+    auto store = store_;
+    return worker_->Submit(
+        [store, routine, names]() {
+          const bool ok = store->Put(routine) != RoutineStore::kInvalidId;
+          *names = CopyNames(*store);
+          return ok;
+        },
+        [this, names](bool, const IoLatency &) {
+          names_ = std::move(*names);
+          for (auto subscriber : subscribers_) {
+            subscriber->RoutinesChanged();
+          }
+        });
+  }
+
+private:
+  std::list<RoutinesModelSubscriber *> subscribers_;
+  std::shared_ptr<RoutineStore> store_;
+  std::shared_ptr<IoWorker> worker_;
+  std::vector<std::string> names_;
 };
+} // namespace
 
-std::unique_ptr<RoutinesModel> RoutinesModel::Create() {
-  return std::make_unique<RoutinesModelImpl>();
+std::unique_ptr<RoutinesModel>
+RoutinesModel::Create(std::shared_ptr<RoutineStore> store,
+                      std::shared_ptr<IoWorker> worker) {
+  return std::make_unique<RoutinesModelImpl>(store, worker);
 }
 } // namespace ui
 } // namespace core
@@ -5,19 +5,55 @@
 #ifndef CDFW_CORE_UI_ROUTINES_MODEL_H
 #define CDFW_CORE_UI_ROUTINES_MODEL_H
 
+// Local Headers
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/routine.h"
+#include "cdfw/core/routine_store.h"
+
 // C++ Standard Library Headers
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace cdfw {
 namespace core {
 namespace ui {
+// Interface for a subscriber to the routines model.
+class RoutinesModelSubscriber {
+public:
+  virtual ~RoutinesModelSubscriber() = default;
+
+  // ---------------------------------------------------------------------------
+  // Model -> Subscriber Interface
+  // ---------------------------------------------------------------------------
+
+  virtual void RoutinesChanged() = 0;
+};
+
+// The store is only touched from jobs on `worker`, so saves never block the
+// UI loop. The model must be created before any job touches the store, and
+// must outlive the polling of its completions.
 class RoutinesModel {
 public:
   // Factory method.
-  static std::unique_ptr<RoutinesModel> Create();
+  static std::unique_ptr<RoutinesModel>
+  Create(std::shared_ptr<RoutineStore> store,
+         std::shared_ptr<IoWorker> worker);
 
   // Virtual d'tor.
   virtual ~RoutinesModel() = default;
+
+  // Register a subscriber to the model.
+  virtual void RegisterSubscriber(RoutinesModelSubscriber *subscriber) = 0;
+
+  // Returns the names of the stored routines, ordered by id. Served from a
+  // copy of the store's index taken on the UI loop; it is refreshed, and the
+  // subscribers notified, when a save lands.
+  virtual std::vector<std::string> GetRoutineNames() = 0;
+
+  // Queues `routine` to be added to the store. Returns false if the worker's
+  // queue is full, in which case nothing is saved.
+  virtual bool SaveRoutine(const Routine &routine) = 0;
 };
 } // namespace ui
 } // namespace core
@@ -10,12 +10,13 @@ namespace cdfw {
 namespace core {
 namespace ui {
 namespace {
-class RoutinesPresenterImpl : public RoutinesPresenter {
+class RoutinesPresenterImpl : public RoutinesPresenter,
+                              public RoutinesModelSubscriber {
 public:
   RoutinesPresenterImpl(std::unique_ptr<RoutinesPresenterView> view,
                         std::unique_ptr<RoutinesModel> model)
       : app_presenter_(nullptr), view_(std::move(view)),
-        model_(std::move(model)) {}
+        model_(std::move(model)), subscribed_(false), view_built_(false) {}
   virtual ~RoutinesPresenterImpl() = default;
 
   virtual void Init(AppPresenter *app_presenter) override final {
@@ -24,6 +25,26 @@ public:
 
     // Setup the view.
     view_->Init(this);
+    view_built_ = true;
+    view_->SetRoutines(model_->GetRoutineNames());
+
+    // Keep the list in step with saves that land later.
+    if (!subscribed_) {
+      model_->RegisterSubscriber(this);
+      subscribed_ = true;
+    }
+  }
+
+  virtual void Destroy() override final {
+    view_->Destroy();
+    view_built_ = false;
+  }
+
+  virtual void RoutinesChanged() override final {
+    // A destroyed view gets the list when it is rebuilt.
+    if (view_built_) {
+      view_->SetRoutines(model_->GetRoutineNames());
+    }
   }
 
   virtual void Show() override final { view_->Show(); }
@@ -34,6 +55,8 @@ private:
   AppPresenter *app_presenter_;
   std::unique_ptr<RoutinesPresenterView> view_;
   std::unique_ptr<RoutinesModel> model_;
+  bool subscribed_;
+  bool view_built_;
 };
 } // namespace
 
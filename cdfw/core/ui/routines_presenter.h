@@ -11,6 +11,8 @@
 
 // C++ Standard Library Headers
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace cdfw {
 namespace core {
@@ -29,8 +31,15 @@ public:
   // Presenter -> View Interface
   // ---------------------------------------------------------------------------
 
+  // Builds the object tree. Called again to rebuild it after Destroy().
   virtual void Init(RoutinesPresenter *presenter) = 0;
+  // Deletes the object tree.
+  virtual void Destroy() = 0;
   virtual void Show() = 0;
+
+  // Populates the routine list, replacing any previous one. Called after
+  // Init() and again whenever the library changes.
+  virtual void SetRoutines(const std::vector<std::string> &names) = 0;
 };
 
 class RoutinesPresenter : public BackBtnPresenter {
@@ -47,7 +56,11 @@ public:
   // AppPresenter -> Presenter Interface
   // ---------------------------------------------------------------------------
 
+  // Builds the view; the first call also sets up the model. Called again to
+  // rebuild the view after Destroy().
   virtual void Init(AppPresenter *app_presenter) = 0;
+  // Deletes the view's object tree. Model changes reach it on the next Init().
+  virtual void Destroy() = 0;
   virtual void Show() = 0;
 
   // ---------------------------------------------------------------------------
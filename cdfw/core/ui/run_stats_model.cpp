@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/ui/run_stats_model.h"
+
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/run_stats.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace cdfw {
+namespace core {
+namespace ui {
+namespace {
+class RunStatsModelImpl : public RunStatsModel {
+public:
+  RunStatsModelImpl(std::shared_ptr<RunLog> log,
+                    std::shared_ptr<RunStats> stats,
+                    std::shared_ptr<IoWorker> worker)
+      : log_(log), stats_(stats), worker_(worker), totals_(stats->Totals()) {}
+  virtual ~RunStatsModelImpl() = default;
+
+  virtual void
+  RegisterSubscriber(RunStatsModelSubscriber *subscriber) override final {
+    subscribers_.push_back(subscriber);
+  }
+
+  virtual std::vector<RunAggregate> GetRoutineStats() override final {
+    return totals_;
+  }
+
+  virtual bool RecordRun(const RunRecord &run) override final {
+    // The job fills in the new totals on the worker; the completion publishes
+    // them on the UI loop.
+    auto totals = std::make_shared<std::vector<RunAggregate>>();
+    auto log = log_;
+    auto stats = stats_;
+    return worker_->Submit(
+        [log, stats, run, totals]() {
+          RunRecord record = run;
+          const bool logged = log->Append(record);
+          const bool ok = stats->Record(record) && logged;
+          *totals = stats->Totals();
+          return ok;
+        },
+        [this, totals](bool, const IoLatency &) {
+          totals_ = std::move(*totals);
+          for (auto subscriber : subscribers_) {
+            subscriber->RunStatsChanged();
+          }
+        });
+  }
+
+  virtual bool ExportCsv(const vfs::Path &path) override final {
+    auto stats = stats_;
+    return worker_->Submit([stats, path]() { return stats->ExportCsv(path); },
+                           [this](bool ok, const IoLatency &) {
+                             for (auto subscriber : subscribers_) {
+                               subscriber->CsvExported(ok);
+                             }
+                           });
+  }
+
+private:
+  std::list<RunStatsModelSubscriber *> subscribers_;
+  std::shared_ptr<RunLog> log_;
+  std::shared_ptr<RunStats> stats_;
+  std::shared_ptr<IoWorker> worker_;
+  std::vector<RunAggregate> totals_;
+};
+} // namespace
+
+std::unique_ptr<RunStatsModel>
+RunStatsModel::Create(std::shared_ptr<RunLog> log,
+                      std::shared_ptr<RunStats> stats,
+                      std::shared_ptr<IoWorker> worker) {
+  return std::make_unique<RunStatsModelImpl>(log, stats, worker);
+}
+} // namespace ui
+} // namespace core
+} // namespace cdfw
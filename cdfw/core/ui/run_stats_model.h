@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_UI_RUN_STATS_MODEL_H
+#define CDFW_CORE_UI_RUN_STATS_MODEL_H
+
+// Local Headers
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/run_stats.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+namespace core {
+namespace ui {
+// Interface for a subscriber to the run stats model.
+class RunStatsModelSubscriber {
+public:
+  virtual ~RunStatsModelSubscriber() = default;
+
+  // ---------------------------------------------------------------------------
+  // Model -> Subscriber Interface
+  // ---------------------------------------------------------------------------
+
+  virtual void RunStatsChanged() = 0;
+  virtual void CsvExported(bool ok) = 0;
+};
+
+// The run log and stats are only touched from jobs on `worker`, so recording a
+// run never blocks the UI loop. The model must be created before any job
+// touches them, and must outlive the polling of its completions.
+class RunStatsModel {
+public:
+  // Factory method.
+  static std::unique_ptr<RunStatsModel>
+  Create(std::shared_ptr<RunLog> log, std::shared_ptr<RunStats> stats,
+         std::shared_ptr<IoWorker> worker);
+
+  // Virtual d'tor.
+  virtual ~RunStatsModel() = default;
+
+  // Register a subscriber to the model.
+  virtual void RegisterSubscriber(RunStatsModelSubscriber *subscriber) = 0;
+
+  // Returns the all-time statistics of each routine with runs, ordered by
+  // routine id. Served from a copy taken on the UI loop; it is refreshed, and
+  // the subscribers notified, when a recorded run lands.
+  virtual std::vector<RunAggregate> GetRoutineStats() = 0;
+
+  // Queues a finished run to be appended to the log and folded into the
+  // stats. Returns false if the worker's queue is full, in which case nothing
+  // is recorded.
+  virtual bool RecordRun(const RunRecord &run) = 0;
+
+  // Queues a CSV export of the stats to `path`. Returns false if the worker's
+  // queue is full; otherwise the subscribers are told how it went.
+  virtual bool ExportCsv(const vfs::Path &path) = 0;
+};
+} // namespace ui
+} // namespace core
+} // namespace cdfw
+
+#endif // CDFW_CORE_UI_RUN_STATS_MODEL_H
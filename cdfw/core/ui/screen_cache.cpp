@@ -0,0 +1,81 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/ui/screen_cache.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <memory>
+
+namespace cdfw {
+namespace core {
+namespace ui {
+namespace {
+class ScreenCacheImpl : public ScreenCache {
+public:
+  ScreenCacheImpl(std::size_t budget, HeapUsage heap_usage)
+      : budget_(budget), heap_usage_(heap_usage), bytes_(0) {}
+  virtual ~ScreenCacheImpl() = default;
+
+  virtual void Use(CachedScreen *screen) override final {
+    auto it = Find(screen);
+    if (it != built_.end()) {
+      built_.splice(built_.begin(), built_, it);
+      return;
+    }
+
+    const std::size_t before = heap_usage_();
+    screen->Build();
+    const std::size_t after = heap_usage_();
+    const std::size_t cost = after > before ? after - before : 0;
+    built_.push_front(Entry{screen, cost});
+    bytes_ += cost;
+  }
+
+  virtual void Trim() override final {
+    while (bytes_ > budget_ && built_.size() > 1) {
+      const Entry &lru = built_.back();
+      lru.screen->Destroy();
+      bytes_ -= lru.cost;
+      built_.pop_back();
+    }
+  }
+
+  virtual bool IsBuilt(const CachedScreen *screen) const override final {
+    return std::any_of(built_.begin(), built_.end(), [&](const Entry &entry) {
+      return entry.screen == screen;
+    });
+  }
+
+  virtual std::size_t Bytes() const override final { return bytes_; }
+
+private:
+  struct Entry {
+    CachedScreen *screen;
+    std::size_t cost;
+  };
+
+  const std::size_t budget_;
+  HeapUsage heap_usage_;
+  std::list<Entry> built_; // Most recently used first.
+  std::size_t bytes_;
+
+  std::list<Entry>::iterator Find(const CachedScreen *screen) {
+    return std::find_if(built_.begin(), built_.end(), [&](const Entry &entry) {
+      return entry.screen == screen;
+    });
+  }
+};
+} // namespace
+
+std::unique_ptr<ScreenCache> ScreenCache::Create(std::size_t budget,
+                                                 HeapUsage heap_usage) {
+  return std::make_unique<ScreenCacheImpl>(budget, heap_usage);
+}
+} // namespace ui
+} // namespace core
+} // namespace cdfw
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_UI_SCREEN_CACHE_H
+#define CDFW_CORE_UI_SCREEN_CACHE_H
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace cdfw {
+namespace core {
+namespace ui {
+// A screen whose object tree can be built on demand and deleted to free the
+// UI heap.
+class CachedScreen {
+public:
+  // Virtual d'tor.
+  virtual ~CachedScreen() = default;
+
+  virtual void Build() = 0;
+  virtual void Destroy() = 0;
+};
+
+// Keeps built screens under a byte budget, deleting the least recently used
+// first. A screen's cost is how much the UI heap grew while it was built.
+//
+// The cache does not own its screens; they must outlive it.
+class ScreenCache {
+public:
+  // Returns the bytes in use in the UI heap.
+  typedef std::function<std::size_t()> HeapUsage;
+
+  // Factory method.
+  static std::unique_ptr<ScreenCache> Create(std::size_t budget,
+                                             HeapUsage heap_usage);
+
+  // Virtual d'tor.
+  virtual ~ScreenCache() = default;
+
+  // Builds `screen` if it is not built, and makes it the most recently used.
+  virtual void Use(CachedScreen *screen) = 0;
+
+  // Destroys the least recently used screens until the built ones fit the
+  // budget. The most recently used screen is never destroyed, so call this
+  // once it is showing.
+  virtual void Trim() = 0;
+
+  virtual bool IsBuilt(const CachedScreen *screen) const = 0;
+
+  // The combined cost of the built screens.
+  virtual std::size_t Bytes() const = 0;
+};
+} // namespace ui
+} // namespace core
+} // namespace cdfw
+
+#endif // CDFW_CORE_UI_SCREEN_CACHE_H
@@ -24,7 +24,8 @@ class SettingsPresenterImpl : public SettingsPresenter {
 public:
   SettingsPresenterImpl(std::unique_ptr<SettingsPresenterView> view,
                         std::shared_ptr<SettingsModel> model)
-      : app_presenter_(nullptr), view_(std::move(view)), model_(model) {}
+      : app_presenter_(nullptr), view_(std::move(view)), model_(model),
+        subscribed_(false), view_built_(false) {}
   virtual ~SettingsPresenterImpl() = default;
 
   virtual void Init(AppPresenter *app_presenter) override final {
@@ -33,16 +34,28 @@ public:
 
     // Setup the view.
     view_->Init(this);
+    view_built_ = true;
     view_->SetWifiCredentials(model_->GetWifiCredentials());
     SetViewWifiState(model_->GetWifiState());
 
-    // Register the presenter as a subscriber to the model.
-    model_->RegisterSubscriber(this);
+    // Register the presenter as a subscriber to the model, once.
+    if (!subscribed_) {
+      model_->RegisterSubscriber(this);
+      subscribed_ = true;
+    }
+  }
+
+  virtual void Destroy() override final {
+    view_->Destroy();
+    view_built_ = false;
   }
 
   virtual void Show() override final { view_->Show(); }
 
   virtual void WifiStateChanged() override final {
+    if (!view_built_) {
+      return;
+    }
     const WifiState &state = model_->GetWifiState();
     SetViewWifiState(state);
   }
@@ -74,6 +87,8 @@ private:
   AppPresenter *app_presenter_;
   std::unique_ptr<SettingsPresenterView> view_;
   std::shared_ptr<SettingsModel> model_;
+  bool subscribed_;
+  bool view_built_;
 
   void SetViewWifiState(const WifiState &state) {
     view_->SetWifiEnabled(state != WifiState::DISABLED_);
@@ -5,65 +5,294 @@
 // Local Headers
 #include "cdfw/core/vfs.h"
 #include "cdfw/compat/arduino.h"
+#include "cdfw/core/crc32.h"
+#include "cdfw/core/vfs_tree.h"
 
 // C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 namespace cdfw {
 namespace vfs {
 namespace {
 namespace stdfs = std::filesystem;
 
-void WalkImpl(stdfs::path p, std::string indent = "") {
-  if (indent.empty()) {
-    // Show the top-level directory as absolute.
-    Serial.printf("%s%s/\n", indent.c_str(), p.c_str());
-    indent = "└── ";
-  } else {
-    // Otherwise, show the directory as relative.
-    Serial.printf("%s%s/\n", indent.c_str(), p.filename().c_str());
-    indent = "    " + indent;
+constexpr const char *kStagingDirName = "atomic";
+constexpr const char *kManifestFileName = "commit.bin";
+
+// Manifest layout (all integers little-endian):
+//   [0, 4) magic "CDTX"
+//   [4, 8) entry count
+//   entries: size, CRC-32 and path length of the target, then its path
+//   CRC-32 of everything before it
+constexpr std::uint8_t kManifestMagic[4] = {'C', 'D', 'T', 'X'};
+constexpr std::size_t kManifestHeaderSize = 8;
+constexpr std::size_t kManifestEntrySize = 12;
+constexpr std::uint64_t kMaxManifestSize = 16 * 1024;
+
+void PutU32(std::vector<std::uint8_t> &buf, std::uint32_t v) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    buf.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+  }
+}
+
+std::uint32_t GetU32(const std::uint8_t *p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+Path StagingDir(Volume &volume) {
+  return volume.TempDir() / kStagingDirName;
+}
+
+// Staged files are named after their position in the batch.
+Path StagedPath(const Path &dir, std::size_t i) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "%u.tmp", static_cast<unsigned>(i));
+  return dir / name;
+}
+
+bool MatchesFile(Volume &volume, const Path &path, std::uint32_t size,
+                 std::uint32_t crc) {
+  auto file = volume.OpenRead(path);
+  if (!file || file.Size() != size) {
+    return false;
   }
 
-  for (const auto &entry : stdfs::directory_iterator(p)) {
-    if (entry.is_directory()) {
-      WalkImpl(entry.path(), indent);
+  std::uint8_t buf[File::kSectorSize];
+  std::uint32_t actual = 0;
+  std::size_t n;
+  while ((n = file.Read(buf)) > 0) {
+    actual = Crc32(buf, n, actual);
+  }
+  return actual == crc;
+}
+
+// Reads and checks the manifest. Leaves `buf` empty if there is no complete
+// manifest.
+void ReadManifest(Volume &volume, const Path &path,
+                  std::vector<std::uint8_t> &buf) {
+  buf.clear();
+  auto file = volume.OpenRead(path);
+  auto size = file.Size();
+  if (size < kManifestHeaderSize + 4 || size > kMaxManifestSize) {
+    return;
+  }
+
+  buf.resize(static_cast<std::size_t>(size));
+  if (file.Read(ByteSpan(buf.data(), buf.size())) != buf.size() ||
+      std::memcmp(buf.data(), kManifestMagic, sizeof(kManifestMagic)) != 0 ||
+      Crc32(buf.data(), buf.size() - 4) != GetU32(buf.data() + size - 4)) {
+    buf.clear();
+  }
+}
+
+void WalkImpl(const stdfs::path &root) {
+  // Show the top-level directory as absolute and the rest as relative.
+  Serial.printf("%s/\n", root.c_str());
+  WalkTree(root, [](const stdfs::directory_entry &entry, std::size_t depth) {
+    std::error_code ec;
+    int indent = static_cast<int>(depth * 4);
+    if (entry.is_directory(ec)) {
+      Serial.printf("%*s└── %s/\n", indent, "",
+                    entry.path().filename().c_str());
     } else {
-      Serial.printf("%s%s (%d bytes)\n", indent.c_str(),
-                    entry.path().filename().c_str(), entry.file_size());
+      Serial.printf("%*s└── %s (%llu bytes)\n", indent, "",
+                    entry.path().filename().c_str(),
+                    static_cast<unsigned long long>(entry.file_size(ec)));
     }
+  });
+}
+
+// Returns true if `a` and `b` are the same path or one is inside the other.
+bool Overlaps(std::string_view a, std::string_view b) {
+  auto n = std::min(a.size(), b.size());
+  if (a.compare(0, n, b, 0, n) != 0) {
+    return false;
   }
+  const auto &longer = a.size() > b.size() ? a : b;
+  return a.size() == b.size() || longer[n] == Path::preferred_separator ||
+         (n > 0 && longer[n - 1] == Path::preferred_separator);
 }
 
+// Wraps the backend volume with a cache of Exists() and List() results.
+//
+// A change to a path drops every cached entry for that path, its ancestors
+// (whose listings or existence may change) and its descendants. Opening a
+// file for writing counts as a change, as it may create the file; writes
+// through the open file do not, as neither cache holds sizes.
+//
+// Backend calls are made without the lock held. A result is only cached if
+// no change was made while it was being fetched. A change invalidates both
+// before and after its backend call, as a lookup that runs alongside the call
+// may fetch the state from before it and cache it under the new generation.
 class VolumeImpl : public Volume {
 public:
-  VolumeImpl(std::unique_ptr<Volume> volume) : v_(std::move(volume)) {}
+  static constexpr std::size_t kMaxCachedPaths = 64;
+  static constexpr std::size_t kMaxCachedDirs = 8;
+
+  VolumeImpl(std::unique_ptr<Volume> volume)
+      : v_(std::move(volume)), generation_(0), stats_{} {}
   virtual ~VolumeImpl() = default;
 
   virtual bool IsSD() override final { return v_->IsSD(); }
   virtual std::uint64_t Capacity() override final { return v_->Capacity(); }
   virtual std::uint64_t Available() override final { return v_->Available(); }
   virtual std::uint64_t Used() override final { return v_->Used(); }
+  virtual VolumeStats Stats() override final { return v_->Stats(); }
   virtual vfs::Path MountPoint() override final { return v_->MountPoint(); }
   virtual vfs::Path TempDir() override final { return v_->TempDir(); }
-  virtual bool Exists(const vfs::Path &path) const override final {
-    return v_->Exists(path);
+  virtual bool Exists(PathView path) const override final {
+    std::uint32_t generation;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = exists_.find(path.native());
+      if (it != exists_.end()) {
+        ++stats_.hits;
+        return it->second;
+      }
+      ++stats_.misses;
+      generation = generation_;
+    }
+
+    bool exists = v_->Exists(path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation == generation_) {
+      if (exists_.size() >= kMaxCachedPaths) {
+        exists_.clear();
+      }
+      exists_.emplace(path.native(), exists);
+    }
+    return exists;
+  }
+  virtual bool List(const vfs::Path &dir,
+                    std::vector<DirEntry> &entries) override final {
+    std::uint32_t generation;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = listings_.find(dir);
+      if (it != listings_.end()) {
+        ++stats_.hits;
+        entries = it->second;
+        return true;
+      }
+      ++stats_.misses;
+      generation = generation_;
+    }
+
+    if (!v_->List(dir, entries)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation == generation_) {
+      if (listings_.size() >= kMaxCachedDirs) {
+        listings_.clear();
+      }
+      listings_[dir] = entries;
+      // A listed dir exists, and so do its entries.
+      exists_[dir.native()] = true;
+    }
+    return true;
+  }
+  virtual MetadataCacheStats CacheStats() const override final {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+  virtual std::uint32_t Generation() const override final {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
   }
 
   virtual bool CreateDirs(const vfs::Path &path) override final {
-    return v_->CreateDirs(path);
+    Invalidate(path);
+    const bool ok = v_->CreateDirs(path);
+    Invalidate(path);
+    return ok;
   }
   virtual bool Remove(const vfs::Path &path) override final {
-    return v_->Remove(path);
+    Invalidate(path);
+    const bool ok = v_->Remove(path);
+    Invalidate(path);
+    return ok;
+  }
+  virtual bool RemoveAll(const vfs::Path &path,
+                         const RemoveProgress &progress) override final {
+    Invalidate(path);
+    const bool ok = v_->RemoveAll(path, progress);
+    Invalidate(path);
+    return ok;
   }
-  virtual bool RemoveAll(const vfs::Path &path) override final {
-    return v_->RemoveAll(path);
+  virtual bool Rename(const vfs::Path &from,
+                      const vfs::Path &to) override final {
+    Invalidate(from);
+    Invalidate(to);
+    const bool ok = v_->Rename(from, to);
+    Invalidate(from);
+    Invalidate(to);
+    return ok;
+  }
+
+  virtual bool Sync() override final { return v_->Sync(); }
+
+  virtual std::unique_ptr<RawMapping>
+  MapFile(const vfs::Path &path) override final {
+    return v_->MapFile(path);
+  }
+
+  virtual std::unique_ptr<RawFile> Open(PathView path,
+                                        OpenMode mode) override final {
+    if (mode == OpenMode::kREAD) {
+      return v_->Open(path, mode);
+    }
+    Invalidate(path);
+    auto file = v_->Open(path, mode);
+    Invalidate(path);
+    return file;
   }
 
 private:
   std::unique_ptr<Volume> v_;
+  mutable std::mutex mutex_;
+  // Keyed by string so that lookups by PathView do not allocate.
+  mutable std::map<std::string, bool, std::less<>> exists_;
+  std::map<vfs::Path, std::vector<DirEntry>> listings_;
+  mutable std::uint32_t generation_; // Bumped by every change.
+  mutable MetadataCacheStats stats_;
+
+  void Invalidate(PathView path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    stats_.invalidations += EraseOverlapping(exists_, path.native());
+    stats_.invalidations += EraseOverlapping(listings_, path.native());
+  }
+
+  template <typename TMap>
+  static std::uint32_t EraseOverlapping(TMap &map, std::string_view path) {
+    std::uint32_t erased = 0;
+    for (auto it = map.begin(); it != map.end();) {
+      if (Overlaps(PathView(it->first).native(), path)) {
+        it = map.erase(it);
+        ++erased;
+      } else {
+        ++it;
+      }
+    }
+    return erased;
+  }
 };
 } // namespace
 
@@ -71,17 +300,467 @@ std::shared_ptr<Volume> Volume::Create(std::unique_ptr<Volume> volume) {
   return std::make_shared<VolumeImpl>(std::move(volume));
 }
 
+File::File() noexcept
+    : raw_(nullptr), buf_(), pos_(0), win_start_(0), win_len_(0),
+      dirty_(false), failed_(false) {}
+
+File::File(std::unique_ptr<RawFile> raw, ByteSpan buffer,
+           std::uint64_t position)
+    : raw_(std::move(raw)), buf_(buffer), pos_(position), win_start_(0),
+      win_len_(0), dirty_(false), failed_(false) {
+  if (buf_.size() >= kSectorSize) {
+    buf_ = buf_.first(buf_.size() - buf_.size() % kSectorSize);
+  }
+}
+
+File::File(File &&other) noexcept
+    : raw_(std::move(other.raw_)), buf_(other.buf_), pos_(other.pos_),
+      win_start_(other.win_start_), win_len_(other.win_len_),
+      dirty_(other.dirty_), failed_(other.failed_) {
+  other.dirty_ = false;
+}
+
+File::~File() { Close(); }
+
+File &File::operator=(File &&other) noexcept {
+  if (this != &other) {
+    Close();
+    raw_ = std::move(other.raw_);
+    buf_ = other.buf_;
+    pos_ = other.pos_;
+    win_start_ = other.win_start_;
+    win_len_ = other.win_len_;
+    dirty_ = other.dirty_;
+    failed_ = other.failed_;
+    other.dirty_ = false;
+  }
+  return *this;
+}
+
+std::uint64_t File::Size() {
+  if (!raw_) {
+    return 0;
+  }
+  std::uint64_t size = raw_->Size();
+  return dirty_ ? std::max<std::uint64_t>(size, win_start_ + win_len_) : size;
+}
+
+std::size_t File::Read(ByteSpan out) {
+  if (!raw_ || (dirty_ && !Flush())) {
+    return 0;
+  }
+
+  std::size_t done = 0;
+  while (done < out.size()) {
+    auto rest = out.subspan(done);
+    if (pos_ >= win_start_ && pos_ < win_start_ + win_len_) {
+      auto offset = static_cast<std::size_t>(pos_ - win_start_);
+      auto n = std::min(rest.size(), win_len_ - offset);
+      std::memcpy(rest.data(), buf_.data() + offset, n);
+      done += n;
+      pos_ += n;
+      continue;
+    }
+
+    std::size_t n;
+    if (rest.size() >= buf_.size()) {
+      // Large enough to skip the buffer and read straight into the caller's
+      // memory.
+      n = raw_->ReadAt(pos_, rest);
+      done += n;
+      pos_ += n;
+    } else {
+      // Refill, from the start of the sector holding the position if the
+      // buffer is large enough to hold one.
+      win_start_ =
+          buf_.size() < kSectorSize ? pos_ : pos_ - pos_ % kSectorSize;
+      win_len_ = raw_->ReadAt(win_start_, buf_);
+      n = win_len_ > pos_ - win_start_ ? win_len_ : 0;
+    }
+    if (n == 0) {
+      break; // End of file.
+    }
+  }
+  return done;
+}
+
+std::size_t File::Write(ConstByteSpan data) {
+  if (!raw_ || failed_) {
+    return 0;
+  }
+  if (dirty_ && pos_ != win_start_ + win_len_ && !Flush()) {
+    return 0;
+  }
+
+  std::size_t done = 0;
+  while (done < data.size()) {
+    auto rest = data.subspan(done);
+    if (!dirty_) {
+      // Any read-ahead is stale now; start a new window at the position.
+      win_start_ = pos_;
+      win_len_ = 0;
+    }
+
+    auto limit = WindowLimit();
+    if (win_len_ == 0 && rest.size() >= limit) {
+      // Large enough to skip the buffer and write straight from the caller's
+      // memory.
+      auto n = raw_->WriteAt(pos_, rest);
+      done += n;
+      pos_ += n;
+      if (n < rest.size()) {
+        failed_ = true;
+      }
+      break;
+    }
+
+    auto n = std::min(rest.size(), limit - win_len_);
+    std::memcpy(buf_.data() + win_len_, rest.data(), n);
+    win_len_ += n;
+    dirty_ = true;
+    done += n;
+    pos_ += n;
+    if (win_len_ == limit && !Flush()) {
+      break;
+    }
+  }
+  return done;
+}
+
+bool File::Seek(std::uint64_t position) {
+  if (!raw_) {
+    return false;
+  }
+  pos_ = position;
+  return true;
+}
+
+bool File::Flush() {
+  if (!raw_) {
+    return false;
+  }
+  if (dirty_) {
+    // The buffer keeps its contents, so it stays valid as read-ahead.
+    dirty_ = false;
+    if (raw_->WriteAt(win_start_, buf_.first(win_len_)) != win_len_) {
+      failed_ = true;
+      win_len_ = 0;
+    }
+  }
+  return !failed_;
+}
+
+bool File::Sync() { return Flush() && raw_->Sync(); }
+
+bool File::Close() {
+  if (!raw_) {
+    return false;
+  }
+  bool ok = Flush();
+  raw_.reset();
+  return ok;
+}
+
+// Bytes that may be buffered before flushing. The first window after a seek
+// is cut short so that it, and every one after it, ends on a sector boundary.
+std::size_t File::WindowLimit() const {
+  if (buf_.size() < kSectorSize) {
+    return buf_.size();
+  }
+  return buf_.size() - static_cast<std::size_t>(win_start_ % kSectorSize);
+}
+
+File Volume::OpenRead(PathView path, ByteSpan buffer) {
+  auto raw = Open(path, OpenMode::kREAD);
+  return raw ? File(std::move(raw), buffer, 0) : File();
+}
+
+File Volume::OpenWrite(PathView path, ByteSpan buffer) {
+  auto raw = Open(path, OpenMode::kTRUNCATE);
+  return raw ? File(std::move(raw), buffer, 0) : File();
+}
+
+File Volume::OpenAppend(PathView path, ByteSpan buffer) {
+  auto raw = Open(path, OpenMode::kAPPEND);
+  if (!raw) {
+    return File();
+  }
+  auto size = raw->Size();
+  return File(std::move(raw), buffer, size);
+}
+
+MappedFile::MappedFile() noexcept
+    : mapping_(nullptr), file_(nullptr), cache_(), page_size_(0),
+      page_count_(0), size_(0), clock_(0), pages_{} {}
+
+MappedFile::MappedFile(std::unique_ptr<RawMapping> mapping)
+    : MappedFile() {
+  mapping_ = std::move(mapping);
+  size_ = mapping_->Data().size();
+}
+
+MappedFile::MappedFile(std::unique_ptr<RawFile> file, ByteSpan cache,
+                       std::size_t pages)
+    : MappedFile() {
+  page_count_ = std::min(std::max<std::size_t>(pages, 1), kMaxPages);
+  page_size_ = cache.size() / page_count_;
+  if (page_size_ >= File::kSectorSize) {
+    page_size_ -= page_size_ % File::kSectorSize;
+  }
+  if (page_size_ == 0) {
+    return; // Nowhere to read into; stays closed.
+  }
+  file_ = std::move(file);
+  cache_ = cache;
+  size_ = file_->Size();
+}
+
+ConstByteSpan MappedFile::View(std::uint64_t offset, std::size_t size) {
+  if (offset >= size_) {
+    return ConstByteSpan();
+  }
+  size = static_cast<std::size_t>(
+      std::min<std::uint64_t>(size, size_ - offset));
+  if (mapping_) {
+    return mapping_->Data().subspan(static_cast<std::size_t>(offset), size);
+  }
+  if (!file_) {
+    return ConstByteSpan();
+  }
+
+  // A page is good enough if loading a new one would not give a longer view.
+  std::size_t align = page_size_ < File::kSectorSize ? 1 : File::kSectorSize;
+  auto start = offset - offset % align;
+  auto end = std::min(offset + size, std::min(start + page_size_, size_));
+
+  Page *page = nullptr;
+  Page *victim = &pages_[0];
+  for (std::size_t i = 0; i < page_count_; ++i) {
+    if (pages_[i].length > 0 && pages_[i].start <= offset &&
+        pages_[i].start + pages_[i].length >= end) {
+      page = &pages_[i];
+      break;
+    }
+    if (pages_[i].last_used < victim->last_used) {
+      victim = &pages_[i];
+    }
+  }
+
+  auto data = [&](Page *p) {
+    return cache_.data() + (p - pages_) * page_size_;
+  };
+  if (!page) {
+    page = victim;
+    page->start = start;
+    page->length = file_->ReadAt(start, ByteSpan(data(page), page_size_));
+    if (page->start + page->length <= offset) {
+      page->length = 0;
+      page->last_used = 0;
+      return ConstByteSpan();
+    }
+  }
+
+  page->last_used = ++clock_;
+  auto skip = static_cast<std::size_t>(offset - page->start);
+  return ConstByteSpan(data(page) + skip,
+                       std::min(size, page->length - skip));
+}
+
+MappedFile Volume::Map(const vfs::Path &path, ByteSpan cache,
+                       std::size_t pages) {
+  if (auto mapping = MapFile(path)) {
+    return MappedFile(std::move(mapping));
+  }
+  auto raw = Open(path, OpenMode::kREAD);
+  return raw ? MappedFile(std::move(raw), cache, pages) : MappedFile();
+}
+
+bool Volume::WriteAtomic(const vfs::Path &path, ConstByteSpan data) {
+  AtomicBatch batch(*this);
+  return batch.Stage(path, data) && batch.Commit();
+}
+
+std::size_t Volume::RecoverAtomicWrites() {
+  auto dir = StagingDir(*this);
+  if (!Exists(dir)) {
+    return 0;
+  }
+
+  // Without a manifest the batch never committed, so its staged files are
+  // simply dropped along with the dir.
+  std::vector<std::uint8_t> manifest;
+  ReadManifest(*this, dir / kManifestFileName, manifest);
+
+  std::size_t finished = 0;
+  if (!manifest.empty()) {
+    const std::uint8_t *p = manifest.data() + kManifestHeaderSize;
+    const std::uint8_t *end = manifest.data() + manifest.size() - 4;
+    std::size_t count = GetU32(manifest.data() + 4);
+    for (std::size_t i = 0; i < count; ++i) {
+      if (end - p < static_cast<std::ptrdiff_t>(kManifestEntrySize) ||
+          end - p - kManifestEntrySize < GetU32(p + 8)) {
+        break;
+      }
+      auto size = GetU32(p);
+      auto crc = GetU32(p + 4);
+      Path target(std::string(reinterpret_cast<const char *>(p) +
+                                  kManifestEntrySize,
+                              GetU32(p + 8)));
+      p += kManifestEntrySize + GetU32(p + 8);
+
+      // A staged file that is gone was renamed before the power cut.
+      auto staged = StagedPath(dir, i);
+      if (Exists(staged) && MatchesFile(*this, staged, size, crc) &&
+          Rename(staged, target)) {
+        ++finished;
+      }
+    }
+  }
+
+  RemoveAll(dir);
+  return finished;
+}
+
+AtomicBatch::AtomicBatch(Volume &volume)
+    : volume_(volume), entries_(), failed_(false), open_(false) {}
+
+AtomicBatch::~AtomicBatch() {
+  if (!entries_.empty()) {
+    Abort();
+  }
+  Close();
+}
+
+bool AtomicBatch::Stage(const vfs::Path &path, ConstByteSpan data) {
+  if (failed_) {
+    return false;
+  }
+
+  if (!open_) {
+    if (volume_.atomic_batch_open_.exchange(true)) {
+      failed_ = true;
+      return false;
+    }
+    open_ = true;
+  }
+
+  auto dir = StagingDir(volume_);
+  if (entries_.empty()) {
+    // A committed batch whose renames failed still owns the staged files.
+    if (volume_.Exists(dir / kManifestFileName)) {
+      volume_.RecoverAtomicWrites();
+    }
+    if (!volume_.Exists(dir)) {
+      volume_.CreateDirs(dir);
+    }
+  }
+
+  auto file = volume_.OpenWrite(StagedPath(dir, entries_.size()));
+  bool ok = file.Write(data) == data.size();
+  ok = file.Close() && ok;
+  entries_.push_back({path, static_cast<std::uint32_t>(data.size()),
+                      Crc32(data.data(), data.size())});
+  if (!ok) {
+    Abort();
+    failed_ = true;
+  }
+  return ok;
+}
+
+bool AtomicBatch::Commit() {
+  if (failed_ || entries_.empty()) {
+    return !failed_;
+  }
+
+  std::vector<std::uint8_t> manifest(kManifestMagic,
+                                     kManifestMagic + sizeof(kManifestMagic));
+  PutU32(manifest, static_cast<std::uint32_t>(entries_.size()));
+  for (const auto &entry : entries_) {
+    const auto &target = entry.target.native();
+    PutU32(manifest, entry.size);
+    PutU32(manifest, entry.crc);
+    PutU32(manifest, static_cast<std::uint32_t>(target.size()));
+    manifest.insert(manifest.end(), target.begin(), target.end());
+  }
+  PutU32(manifest, Crc32(manifest.data(), manifest.size()));
+
+  // The staged files must be durable before the manifest can point at them.
+  auto dir = StagingDir(volume_);
+  auto manifest_path = dir / kManifestFileName;
+  if (!volume_.Sync()) {
+    Abort();
+    return false;
+  }
+  auto file = volume_.OpenWrite(manifest_path);
+  bool ok = file.Write(ConstByteSpan(manifest.data(), manifest.size())) ==
+            manifest.size();
+  ok = file.Sync() && ok;
+  ok = file.Close() && ok;
+  if (!ok) {
+    volume_.Remove(manifest_path);
+    Abort();
+    return false;
+  }
+
+  // Committed. From here on a power cut is finished by recovery.
+  for (std::size_t i = 0; i < entries_.size(); ++i) {
+    ok = volume_.Rename(StagedPath(dir, i), entries_[i].target) && ok;
+  }
+  entries_.clear();
+  // The renames must be durable before the manifest goes, or a power cut
+  // could keep its removal but lose renames, and recovery would then drop the
+  // staged files they moved.
+  ok = ok && volume_.Sync();
+  if (ok) {
+    volume_.Remove(manifest_path);
+  }
+  Close();
+  return ok;
+}
+
+void AtomicBatch::Abort() {
+  auto dir = StagingDir(volume_);
+  for (std::size_t i = 0; i < entries_.size(); ++i) {
+    volume_.Remove(StagedPath(dir, i));
+  }
+  entries_.clear();
+  Close();
+}
+
+void AtomicBatch::Close() {
+  if (open_) {
+    volume_.atomic_batch_open_ = false;
+    open_ = false;
+  }
+}
+
 void Volume::Walk() {
   Serial.println("Walking SD card...");
   WalkImpl(MountPoint().native());
   Serial.println("Done walking SD card.");
 }
 
+VolumeStats Volume::Stats() {
+  VolumeStats stats;
+  stats.capacity = Capacity();
+  stats.available = Available();
+  stats.used = stats.capacity - stats.available;
+  return stats;
+}
+
 void Volume::PrintInfo() {
-  Serial.printf("SD capacity: %llu bytes\n", Capacity());
-  Serial.printf("SD available: %llu bytes\n", Available());
-  Serial.printf("SD used: %llu bytes\n", Used());
+  auto space = Stats();
+  Serial.printf("SD capacity: %llu bytes\n",
+                static_cast<unsigned long long>(space.capacity));
+  Serial.printf("SD available: %llu bytes\n",
+                static_cast<unsigned long long>(space.available));
+  Serial.printf("SD used: %llu bytes\n",
+                static_cast<unsigned long long>(space.used));
   Serial.printf("SD mountpoint: %s\n", MountPoint().native().c_str());
+  auto stats = CacheStats();
+  Serial.printf("SD metadata cache: %lu hits, %lu misses\n",
+                static_cast<unsigned long>(stats.hits),
+                static_cast<unsigned long>(stats.misses));
 }
 
 } // namespace vfs
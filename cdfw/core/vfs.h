@@ -5,16 +5,78 @@
 #ifndef CDFW_CORE_VFS_H
 #define CDFW_CORE_VFS_H
 
+// Local Headers
+#include "cdfw/core/span.h"
+
 // C++ Standard Library Headers
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace cdfw {
 namespace vfs {
 namespace stdfs = std::filesystem;
 
+class Path;
+
+// Non-owning view of a path, for passing paths around without copying them.
+// Built from a Path, a PathBuf (see path_buf.h) or a string, none of which
+// allocates. The viewed characters must outlive the view, and are not
+// necessarily null-terminated; backends convert explicitly to a Path or
+// std::filesystem::path where they need one.
+class PathView {
+public:
+  typedef char value_type;
+  static constexpr value_type preferred_separator = '/';
+
+  // constructors
+  constexpr PathView() noexcept {}
+  constexpr PathView(std::string_view s) noexcept : s_(s) {}
+  PathView(const char *s) noexcept : s_(s) {}
+  PathView(const std::string &s) noexcept : s_(s) {}
+  PathView(const stdfs::path &p) noexcept : s_(p.native()) {}
+  PathView(const Path &p) noexcept;
+
+  // comparators
+  friend bool operator==(PathView lhs, PathView rhs) noexcept {
+    return lhs.s_ == rhs.s_;
+  }
+  friend bool operator!=(PathView lhs, PathView rhs) noexcept {
+    return lhs.s_ != rhs.s_;
+  }
+
+  // native format
+  constexpr std::string_view native() const noexcept { return s_; }
+  explicit operator stdfs::path() const { return stdfs::path(s_); }
+
+  // decomposition
+  // Unlike Path, these are plain string splits on the last separator.
+  PathView filename() const noexcept {
+    auto slash = s_.rfind(preferred_separator);
+    return slash == std::string_view::npos ? s_ : s_.substr(slash + 1);
+  }
+  PathView parent_path() const noexcept {
+    auto slash = s_.rfind(preferred_separator);
+    if (slash == std::string_view::npos) {
+      return PathView();
+    }
+    return s_.substr(0, slash == 0 ? 1 : slash);
+  }
+
+  // query
+  constexpr bool empty() const noexcept { return s_.empty(); }
+  constexpr std::size_t size() const noexcept { return s_.size(); }
+
+private:
+  std::string_view s_;
+};
+
 // Thin wrapper around std::filesystem::path to provide an interface for mocks.
 class Path {
 public:
@@ -30,6 +92,8 @@ public:
   Path(const char *s) : p_(s) {}
   Path(const stdfs::path &p) : p_(p) {}
   Path(stdfs::path &&p) noexcept : p_(std::move(p)) {}
+  // Copies the viewed characters.
+  explicit Path(PathView v) : p_(v.native()) {}
   virtual ~Path() = default;
 
   // assignment
@@ -80,11 +144,193 @@ protected:
   stdfs::path p_;
 };
 
+inline PathView::PathView(const Path &p) noexcept : s_(p.native()) {}
+
+struct DirEntry {
+  vfs::Path name; // Relative to the listed dir.
+  bool is_dir;
+};
+
+// Counters for the metadata cache in front of every Volume::Create() volume.
+struct MetadataCacheStats {
+  std::uint32_t hits;
+  std::uint32_t misses;
+  std::uint32_t invalidations; // Cached entries dropped by mutations.
+};
+
+// Space on a volume, in bytes.
+struct VolumeStats {
+  std::uint64_t capacity;
+  std::uint64_t available;
+  std::uint64_t used;
+};
+
+struct RemoveStats {
+  std::uint32_t files;
+  std::uint32_t dirs;
+};
+
+// Progress callback for Volume::RemoveAll(). Returning false stops the removal.
+typedef std::function<bool(const RemoveStats &stats)> RemoveProgress;
+
+enum class OpenMode : std::uint8_t {
+  kREAD = 0,     // Existing file, read only.
+  kTRUNCATE = 1, // Created if missing, existing contents discarded.
+  kAPPEND = 2,   // Created if missing, existing contents kept.
+};
+
+// Unbuffered, positional access to one open file. Each volume backend provides
+// one; callers normally go through File instead. Closes the file on
+// destruction.
+class RawFile {
+public:
+  // Virtual destructor.
+  virtual ~RawFile() = default;
+
+  // Returns the number of bytes transferred. A short count means end of file
+  // (reads) or an error.
+  virtual std::size_t ReadAt(std::uint64_t offset, ByteSpan buf) = 0;
+  virtual std::size_t WriteAt(std::uint64_t offset, ConstByteSpan data) = 0;
+
+  virtual std::uint64_t Size() = 0;
+
+  // Makes written data durable on the media.
+  virtual bool Sync() = 0;
+};
+
+// Buffered file handle returned by Volume::OpenRead/OpenWrite/OpenAppend.
+//
+// The buffer is supplied by the caller and only used while the handle is open,
+// so file I/O never allocates. It is trimmed to a multiple of kSectorSize and
+// buffered transfers are issued on sector boundaries. Requests at least as
+// large as the buffer bypass it and go straight between the caller's memory
+// and the backend. Without a buffer every call goes to the backend.
+//
+// A default constructed (or moved from) File is closed; every operation on it
+// fails.
+class File {
+public:
+  static constexpr std::size_t kSectorSize = 512;
+
+  // constructors and destructor
+  File() noexcept;
+  File(std::unique_ptr<RawFile> raw, ByteSpan buffer, std::uint64_t position);
+  File(File &&other) noexcept;
+  File(const File &) = delete;
+  // Flushes buffered writes. Use Close() to find out whether that worked.
+  ~File();
+
+  // assignment
+  File &operator=(File &&other) noexcept;
+  File &operator=(const File &) = delete;
+
+  // query
+  bool IsOpen() const noexcept { return raw_ != nullptr; }
+  explicit operator bool() const noexcept { return IsOpen(); }
+  std::uint64_t Position() const noexcept { return pos_; }
+  std::uint64_t Size();
+
+  // Transfers bytes at the current position and advances it. Returns the
+  // number of bytes transferred.
+  std::size_t Read(ByteSpan buf);
+  std::size_t Write(ConstByteSpan data);
+
+  // Moves the position. Seeking past the end is allowed; a later write
+  // extends the file.
+  bool Seek(std::uint64_t position);
+
+  // Hands buffered writes to the backend. Returns false if any write on this
+  // handle has failed.
+  bool Flush();
+
+  // Flush() and make the data durable on the media.
+  bool Sync();
+
+  // Flush() and close. Returns false if any write on this handle has failed.
+  bool Close();
+
+private:
+  std::unique_ptr<RawFile> raw_;
+  ByteSpan buf_;
+  std::uint64_t pos_;
+  std::uint64_t win_start_; // File offset of buf_[0].
+  std::size_t win_len_;     // Valid bytes in buf_ (pending ones if dirty_).
+  bool dirty_;
+  bool failed_;
+
+  std::size_t WindowLimit() const;
+};
+
+// Read-only mapping of a whole file, from backends that can map files.
+// Unmaps on destruction.
+class RawMapping {
+public:
+  // Virtual destructor.
+  virtual ~RawMapping() = default;
+
+  virtual ConstByteSpan Data() = 0;
+};
+
+// Read-only, zero-copy view of a file's contents, returned by Volume::Map().
+//
+// Where the backend can map files (native) a view points straight into the
+// mapping and stays valid for the life of the MappedFile. Otherwise (CYD) the
+// file is read on demand into pages carved out of a caller-supplied cache, and
+// a view points into a page. Pages are loaded from a sector boundary and
+// replaced least recently used first, so with N pages a view stays valid
+// across the next N - 1 calls to View().
+//
+// Either way, parsers can walk a file without owning a copy of it. The file
+// must not change while it is mapped.
+class MappedFile {
+public:
+  static constexpr std::size_t kMaxPages = 8;
+
+  // constructors
+  MappedFile() noexcept;
+  explicit MappedFile(std::unique_ptr<RawMapping> mapping);
+  MappedFile(std::unique_ptr<RawFile> file, ByteSpan cache, std::size_t pages);
+  MappedFile(MappedFile &&other) noexcept = default;
+  MappedFile(const MappedFile &) = delete;
+
+  // assignment
+  MappedFile &operator=(MappedFile &&other) noexcept = default;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // query
+  bool IsOpen() const noexcept { return mapping_ || file_; }
+  explicit operator bool() const noexcept { return IsOpen(); }
+  bool IsMapped() const noexcept { return mapping_ != nullptr; }
+  std::uint64_t Size() const noexcept { return size_; }
+
+  // Returns a view of up to `size` bytes at `offset`. The view is shorter
+  // than asked for at the end of the file, on a read error, or when it does
+  // not fit in a page; callers walk on from the end of what they got.
+  ConstByteSpan View(std::uint64_t offset, std::size_t size);
+
+private:
+  struct Page {
+    std::uint64_t start;
+    std::size_t length;
+    std::uint32_t last_used;
+  };
+
+  std::unique_ptr<RawMapping> mapping_;
+  std::unique_ptr<RawFile> file_;
+  ByteSpan cache_;
+  std::size_t page_size_;
+  std::size_t page_count_;
+  std::uint64_t size_;
+  std::uint32_t clock_;
+  Page pages_[kMaxPages];
+};
+
 class Volume {
 public:
   // Volume is not meant to be instantiated directly, instead you should
   // instantiate a derived class (e.g., SD). This factory method exists to allow
-  // for us to inject a mock volume for testing.
+  // for us to inject a mock volume for testing. The returned volume caches
+  // metadata, so every change must be made through it.
   static std::shared_ptr<Volume> Create(std::unique_ptr<Volume> volume);
   virtual ~Volume() = default;
 
@@ -93,20 +339,133 @@ public:
   virtual std::uint64_t Capacity() = 0;
   virtual std::uint64_t Available() = 0;
   virtual std::uint64_t Used() = 0;
+  // The three queries above in one go. Each of them can cost a trip to the
+  // card, so backends override this to ask once. Still not cheap: callers on
+  // the UI loop should read a VolumeStatsSampler instead.
+  virtual VolumeStats Stats();
   virtual vfs::Path MountPoint() = 0;
   virtual vfs::Path TempDir() = 0;
-  virtual bool Exists(const vfs::Path &path) const = 0;
+  // Takes a PathView, as it is asked on hot paths; cache hits never allocate.
+  virtual bool Exists(PathView path) const = 0;
+  // Replaces `entries` with the entries directly inside `dir`. Returns false
+  // if `dir` cannot be listed.
+  virtual bool List(const vfs::Path &dir, std::vector<DirEntry> &entries) = 0;
+  // Volumes from Volume::Create() cache Exists() and List() results until the
+  // paths they cover are changed through the volume. Others report zeros.
+  virtual MetadataCacheStats CacheStats() const {
+    return MetadataCacheStats{};
+  }
+  // Bumped by every change made through volumes from Volume::Create(), so that
+  // observers can notice writes without asking the card. Others report 0.
+  virtual std::uint32_t Generation() const { return 0; }
 
   // create and remove
   // Returns false if the dir cannot be created (e.g., the path does not belong
   // to this volume).
   virtual bool CreateDirs(const vfs::Path &path) = 0;
   virtual bool Remove(const vfs::Path &path) = 0;
-  virtual bool RemoveAll(const vfs::Path &path) = 0;
+  // Removes `path` and everything below it, reporting to `progress` (if set)
+  // as it goes. Trees deeper than the backend can walk safely are refused.
+  virtual bool RemoveAll(const vfs::Path &path,
+                         const RemoveProgress &progress = nullptr) = 0;
+  // Moves the file at `from` to `to`, replacing `to` if it exists.
+  virtual bool Rename(const vfs::Path &from, const vfs::Path &to) = 0;
+
+  // Makes the contents of every closed file durable on the media.
+  virtual bool Sync() = 0;
+
+  // file I/O
+  // Backend hook behind the Open* helpers below. Returns nullptr if the file
+  // cannot be opened (e.g., it is missing and `mode` is kREAD, or its parent
+  // dir does not exist).
+  virtual std::unique_ptr<RawFile> Open(PathView path, OpenMode mode) = 0;
+  // Open the file at `path`, buffering through `buffer` (see File). On failure
+  // the returned File is closed.
+  File OpenRead(PathView path, ByteSpan buffer = ByteSpan());
+  File OpenWrite(PathView path, ByteSpan buffer = ByteSpan());
+  // Like OpenWrite() but keeps the contents; the position starts at the end.
+  File OpenAppend(PathView path, ByteSpan buffer = ByteSpan());
+  // Backend hook behind Map(). Returns nullptr if the file cannot be opened or
+  // the backend cannot map files.
+  virtual std::unique_ptr<RawMapping> MapFile(const vfs::Path &path) = 0;
+  // Maps the file at `path` read-only (see MappedFile). `cache` is split into
+  // `pages` pages (at most MappedFile::kMaxPages) for backends that cannot map
+  // files. On failure the returned MappedFile is closed.
+  MappedFile Map(const vfs::Path &path, ByteSpan cache = ByteSpan(),
+                 std::size_t pages = 1);
+
+  // atomic writes
+  // Replaces the contents of the file at `path` such that a power cut leaves
+  // either the old or the new contents. See AtomicBatch.
+  bool WriteAtomic(const vfs::Path &path, ConstByteSpan data);
+  // Finishes or discards the atomic writes interrupted by a power cut. Meant to
+  // be called at boot. Returns the number of files that were finished.
+  std::size_t RecoverAtomicWrites();
 
   // misc
   void Walk();
   void PrintInfo();
+
+private:
+  friend class AtomicBatch;
+
+  // Set while an AtomicBatch has files staged on this volume.
+  std::atomic<bool> atomic_batch_open_{false};
+};
+
+// Replaces several files as one crash-safe unit.
+//
+// Stage() writes each new file into a scratch dir under Volume::TempDir().
+// Commit() makes the staged files durable with one Volume::Sync(), writes and
+// syncs a manifest naming every staged file with its target and CRC-32, and
+// then renames the staged files over their targets and syncs again before the
+// manifest is removed. The synced manifest is the commit point:
+// Volume::RecoverAtomicWrites() finishes the renames of a batch that committed
+// and discards the staged files of one that did not.
+//
+// A commit costs three flushes however many files it holds, so the files saved
+// by one UI action should share a batch.
+//
+// Batches share one scratch dir, so a volume has at most one open batch: from
+// its first Stage() until Commit() or Abort(). Stage() on another batch fails
+// meanwhile.
+class AtomicBatch {
+public:
+  // constructors and destructor
+  explicit AtomicBatch(Volume &volume);
+  AtomicBatch(const AtomicBatch &) = delete;
+  // Discards anything staged but not committed.
+  ~AtomicBatch();
+
+  // assignment
+  AtomicBatch &operator=(const AtomicBatch &) = delete;
+
+  // Stages `data` as the new contents of the file at `path`. Nothing is
+  // visible until Commit(). If staging fails, or another batch is open on the
+  // volume, the whole batch is discarded.
+  bool Stage(const vfs::Path &path, ConstByteSpan data);
+
+  // Replaces every staged file. Returns false, with no file changed, if
+  // anything failed before the commit point. A failure after it is finished
+  // by the next batch or by Volume::RecoverAtomicWrites().
+  bool Commit();
+
+  // Discards everything staged.
+  void Abort();
+
+private:
+  struct Entry {
+    vfs::Path target;
+    std::uint32_t size;
+    std::uint32_t crc;
+  };
+
+  Volume &volume_;
+  std::vector<Entry> entries_;
+  bool failed_;
+  bool open_; // Holds the volume's open batch.
+
+  void Close();
 };
 } // namespace vfs
 } // namespace cdfw
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/vfs_tree.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+namespace cdfw {
+namespace vfs {
+bool WalkTree(const stdfs::path &root, const TreeVisitor &visit) {
+  std::error_code ec;
+  std::vector<stdfs::directory_iterator> stack;
+  stack.reserve(kMaxTreeDepth);
+  stack.emplace_back(root, ec);
+  if (ec) {
+    return false;
+  }
+
+  const stdfs::directory_iterator end;
+  while (!stack.empty()) {
+    auto &it = stack.back();
+    if (it == end) {
+      stack.pop_back();
+      continue;
+    }
+
+    // Copy the entry; `it` is advanced before any child is pushed.
+    auto entry = *it;
+    it.increment(ec);
+    if (ec) {
+      return false;
+    }
+
+    visit(entry, stack.size() - 1);
+    if (entry.is_directory(ec) && stack.size() < kMaxTreeDepth) {
+      stack.emplace_back(entry.path(), ec);
+      if (ec) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool RemoveTree(const stdfs::path &root, const RemoveProgress &progress) {
+  std::error_code ec;
+  RemoveStats stats{};
+  if (!stdfs::is_directory(root, ec)) {
+    if (!stdfs::remove(root, ec)) {
+      return false;
+    }
+    stats.files = 1;
+    return !progress || progress(stats);
+  }
+
+  std::vector<stdfs::path> dirs;
+  dirs.reserve(kMaxTreeDepth);
+  dirs.push_back(root);
+  std::vector<stdfs::path> batch;
+  batch.reserve(kRemoveBatchSize);
+
+  const stdfs::directory_iterator end;
+  while (!dirs.empty()) {
+    // Read up to a batch of files, or up to the first subdir. The iterator is
+    // closed before anything in the dir is deleted.
+    bool descend = false;
+    batch.clear();
+    {
+      stdfs::directory_iterator it(dirs.back(), ec);
+      for (; !ec && it != end && batch.size() < kRemoveBatchSize;
+           it.increment(ec)) {
+        if (it->is_directory(ec)) {
+          if (dirs.size() == kMaxTreeDepth) {
+            return false;
+          }
+          dirs.push_back(it->path());
+          descend = true;
+          break;
+        }
+        batch.push_back(it->path());
+      }
+      if (ec) {
+        return false;
+      }
+    }
+
+    for (const auto &path : batch) {
+      if (!stdfs::remove(path, ec)) {
+        return false;
+      }
+      ++stats.files;
+    }
+    if (!batch.empty() && progress && !progress(stats)) {
+      return false;
+    }
+
+    if (!descend && batch.empty()) {
+      // Nothing left in the dir.
+      if (!stdfs::remove(dirs.back(), ec)) {
+        return false;
+      }
+      dirs.pop_back();
+      ++stats.dirs;
+      if (progress && !progress(stats)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace vfs
+} // namespace cdfw
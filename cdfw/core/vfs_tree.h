@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_VFS_TREE_H
+#define CDFW_CORE_VFS_TREE_H
+
+// Traversal of a std::filesystem tree, shared by the volume backends that sit
+// on one. Neither function recurses: open directories are kept on an explicit
+// stack capped at kMaxTreeDepth levels, so stack and heap use do not grow with
+// the size or shape of the card.
+
+// Local Headers
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+
+namespace cdfw {
+namespace vfs {
+constexpr std::size_t kMaxTreeDepth = 16;
+
+// Called for every entry below the root, parents before their children.
+// `depth` is 0 for the root's own entries.
+typedef std::function<void(const stdfs::directory_entry &entry,
+                           std::size_t depth)>
+    TreeVisitor;
+
+// Visits the tree below `root`. Dirs at kMaxTreeDepth are visited but not
+// entered. Returns false if `root` or a dir below it cannot be read.
+bool WalkTree(const stdfs::path &root, const TreeVisitor &visit);
+
+// Removes `root` and everything below it.
+//
+// Files are deleted in batches of up to kRemoveBatchSize: the dir is read
+// until a batch is full, closed, and the batch deleted, so no directory is
+// modified while it is being read. `progress` (if set) is called after every
+// batch and every removed dir.
+//
+// Refuses trees with dirs more than kMaxTreeDepth - 1 levels below `root`, the
+// same dirs WalkTree() would not enter. Returns false, leaving whatever
+// was not yet removed, if `root` does not exist, the tree is too deep, a
+// delete fails, or `progress` returns false.
+constexpr std::size_t kRemoveBatchSize = 32;
+bool RemoveTree(const stdfs::path &root, const RemoveProgress &progress);
+} // namespace vfs
+} // namespace cdfw
+
+#endif // CDFW_CORE_VFS_TREE_H
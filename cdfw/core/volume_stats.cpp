@@ -0,0 +1,165 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/volume_stats.h"
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace cdfw {
+namespace {
+constexpr std::size_t kNoLevel = static_cast<std::size_t>(-1);
+
+class VolumeStatsSamplerImpl : public VolumeStatsSampler {
+public:
+  VolumeStatsSamplerImpl(std::shared_ptr<vfs::Volume> volume,
+                         std::shared_ptr<IoWorker> worker,
+                         std::uint32_t interval_ms,
+                         std::uint32_t min_interval_ms)
+      : volume_(volume), worker_(worker), interval_ms_(interval_ms),
+        min_interval_ms_(min_interval_ms), thresholds_{10, 5, 1}, seq_(0),
+        snapshot_{}, stale_(true), in_flight_(false), last_ms_(0),
+        generation_(0), level_(kNoLevel) {}
+
+  virtual ~VolumeStatsSamplerImpl() {
+    // A queued refresh writes to the snapshot.
+    if (in_flight_) {
+      worker_->Drain();
+    }
+  }
+
+  virtual void
+  RegisterSubscriber(VolumeStatsSubscriber *subscriber) override final {
+    subscribers_.push_back(subscriber);
+  }
+
+  virtual void
+  SetThresholds(std::vector<std::uint8_t> free_percent) override final {
+    std::sort(free_percent.begin(), free_percent.end(),
+              std::greater<std::uint8_t>());
+    thresholds_ = std::move(free_percent);
+  }
+
+  virtual vfs::VolumeStats Get() const override final {
+    // Read side of a sequence lock: retry if the worker published while the
+    // snapshot was being copied.
+    while (true) {
+      const std::uint32_t before = seq_.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue;
+      }
+      vfs::VolumeStats stats = snapshot_;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq_.load(std::memory_order_relaxed) == before) {
+        return stats;
+      }
+    }
+  }
+
+  virtual void Invalidate() override final { stale_ = true; }
+
+  virtual bool Tick(std::uint32_t now_ms) override final {
+    if (in_flight_) {
+      return false;
+    }
+    const std::uint32_t generation = volume_->Generation();
+    const std::uint32_t elapsed_ms = now_ms - last_ms_;
+    // Writes made before the minimum interval is up wait for the next Tick()
+    // after it, as the generation is only taken when a refresh is queued.
+    const bool written =
+        generation != generation_ && elapsed_ms >= min_interval_ms_;
+    const bool stale = stale_.exchange(false);
+    if (!stale && !written && elapsed_ms < interval_ms_) {
+      return false;
+    }
+
+    const bool queued = worker_->Submit(
+        [this]() {
+          Publish(volume_->Stats());
+          return true;
+        },
+        [this](bool, const IoLatency &) {
+          in_flight_ = false;
+          Notify();
+        });
+    if (queued) {
+      in_flight_ = true;
+      last_ms_ = now_ms;
+      generation_ = generation;
+    } else if (stale) {
+      stale_ = true;
+    }
+    return queued;
+  }
+
+private:
+  // Runs on the worker, the only writer.
+  void Publish(const vfs::VolumeStats &stats) {
+    const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    snapshot_ = stats;
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  // Runs on the UI loop.
+  void Notify() {
+    const auto stats = Get();
+    std::size_t level = 0;
+    for (auto percent : thresholds_) {
+      if (stats.available * 100 < stats.capacity * percent) {
+        ++level;
+      }
+    }
+    if (level == level_) {
+      return;
+    }
+    level_ = level;
+    for (auto subscriber : subscribers_) {
+      subscriber->FreeSpaceChanged(stats, level);
+    }
+  }
+
+  std::shared_ptr<vfs::Volume> volume_;
+  std::shared_ptr<IoWorker> worker_;
+  std::uint32_t interval_ms_;
+  std::uint32_t min_interval_ms_;
+  std::vector<std::uint8_t> thresholds_;
+  std::list<VolumeStatsSubscriber *> subscribers_;
+
+  // Shared with the worker. Odd while a snapshot is being written.
+  std::atomic<std::uint32_t> seq_;
+  vfs::VolumeStats snapshot_;
+
+  // Set by Invalidate() from any thread.
+  std::atomic<bool> stale_;
+
+  // UI loop only.
+  bool in_flight_;
+  std::uint32_t last_ms_;
+  std::uint32_t generation_;
+  std::size_t level_;
+};
+} // namespace
+
+std::unique_ptr<VolumeStatsSampler>
+VolumeStatsSampler::Create(std::shared_ptr<vfs::Volume> volume,
+                           std::shared_ptr<IoWorker> worker,
+                           std::uint32_t interval_ms,
+                           std::uint32_t min_interval_ms) {
+  return std::make_unique<VolumeStatsSamplerImpl>(volume, worker, interval_ms,
+                                                  min_interval_ms);
+}
+} // namespace cdfw
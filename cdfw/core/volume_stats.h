@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_VOLUME_STATS_H
+#define CDFW_CORE_VOLUME_STATS_H
+
+// Keeps a snapshot of a volume's space so that the UI can show it without
+// talking to the card.
+//
+// Tick() is called from the UI loop. When the snapshot is older than the
+// refresh interval, or something has been written through the volume since it
+// was taken, Tick() queues a refresh on the I/O worker. A refresh is a slow
+// scan of the card, so one for writes waits until the minimum interval has
+// passed since the last, and takes in every write made meanwhile. The worker
+// publishes the new snapshot, which Get() reads without a lock from any
+// thread.
+//
+// Subscribers are told, on the UI loop, after the first refresh and whenever
+// free space crosses one of the thresholds.
+
+// Local Headers
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+// Interface for a subscriber to the sampler.
+class VolumeStatsSubscriber {
+public:
+  virtual ~VolumeStatsSubscriber() = default;
+
+  // `level` is the number of thresholds free space is below.
+  virtual void FreeSpaceChanged(const vfs::VolumeStats &stats,
+                                std::size_t level) = 0;
+};
+
+class VolumeStatsSampler {
+public:
+  static constexpr std::uint32_t kDefaultIntervalMs = 30000;
+  static constexpr std::uint32_t kDefaultMinIntervalMs = 2000;
+
+  // Factory method. The sampler must outlive the polling of `worker`.
+  // `min_interval_ms` spaces out the refreshes queued for writes.
+  static std::unique_ptr<VolumeStatsSampler>
+  Create(std::shared_ptr<vfs::Volume> volume, std::shared_ptr<IoWorker> worker,
+         std::uint32_t interval_ms = kDefaultIntervalMs,
+         std::uint32_t min_interval_ms = kDefaultMinIntervalMs);
+
+  // Virtual destructor. Waits for a refresh in progress.
+  virtual ~VolumeStatsSampler() = default;
+
+  // Register a subscriber to the sampler.
+  virtual void RegisterSubscriber(VolumeStatsSubscriber *subscriber) = 0;
+
+  // Free space thresholds, as a percentage of capacity. Defaults to 10, 5
+  // and 1.
+  virtual void SetThresholds(std::vector<std::uint8_t> free_percent) = 0;
+
+  // Returns the latest snapshot, all zeros before the first refresh. Lock-free
+  // and never touches the card.
+  virtual vfs::VolumeStats Get() const = 0;
+
+  // Forces a refresh on the next Tick(), e.g. after writing behind the
+  // volume's back.
+  virtual void Invalidate() = 0;
+
+  // Queues a refresh if one is due. Call from the UI loop. Returns true if a
+  // refresh was queued.
+  virtual bool Tick(std::uint32_t now_ms) = 0;
+};
+} // namespace cdfw
+
+#endif // CDFW_CORE_VOLUME_STATS_H
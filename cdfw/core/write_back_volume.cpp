@@ -0,0 +1,464 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/write_back_volume.h"
+#include "cdfw/compat/arduino.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cdfw {
+namespace vfs {
+namespace {
+typedef std::vector<std::uint8_t> Bytes;
+
+// True if `key` is `root` or below it.
+bool Under(const std::string &key, const std::string &root) {
+  return key.compare(0, root.size(), root) == 0 &&
+         (key.size() == root.size() || key[root.size()] == '/');
+}
+
+// The cached state of one file. Lives while it is dirty or open.
+struct Entry {
+  Path path;
+  // Disjoint, non-adjacent dirty ranges keyed by offset.
+  std::map<std::uint64_t, Bytes> extents;
+  std::uint64_t size;        // As seen by callers.
+  std::size_t dirty;         // Bytes in `extents`.
+  std::uint32_t dirty_since; // When the entry last became pending.
+  bool truncate;             // The wrapped file must be truncated first.
+  bool unsynced;             // Written out but not yet synced.
+  bool detached; // Removed or renamed away; writes and Sync() fail.
+
+  bool Pending() const { return dirty > 0 || truncate; }
+};
+
+// Keyed by string so that lookups by PathView do not allocate.
+typedef std::map<std::string, std::shared_ptr<Entry>, std::less<>> EntryMap;
+
+struct State {
+  std::mutex mutex;
+  std::shared_ptr<Volume> volume;
+  WriteBackPolicy policy;
+  WriteBackVolume::Clock clock;
+  EntryMap entries;
+  WriteBackStats stats;
+
+  // The functions below expect `mutex` to be held.
+
+  void MarkPending(Entry &entry) {
+    if (!entry.Pending()) {
+      entry.dirty_since = clock();
+    }
+  }
+
+  // Adds [offset, offset + data.size()) to the entry's extents, merging it
+  // with every extent it overlaps or touches.
+  void Absorb(Entry &entry, std::uint64_t offset, ConstByteSpan data) {
+    MarkPending(entry);
+    const std::uint64_t end = offset + data.size();
+    auto &extents = entry.extents;
+    auto first = extents.upper_bound(offset);
+    if (first != extents.begin()) {
+      auto prev = std::prev(first);
+      if (prev->first + prev->second.size() >= offset) {
+        first = prev;
+      }
+    }
+    auto last = first;
+    std::uint64_t start = offset;
+    std::uint64_t stop = end;
+    std::size_t before = 0;
+    while (last != extents.end() && last->first <= end) {
+      start = std::min(start, last->first);
+      stop = std::max<std::uint64_t>(stop,
+                                     last->first + last->second.size());
+      before += last->second.size();
+      ++last;
+    }
+
+    if (first != last && std::next(first) == last && first->first <= offset) {
+      // One extent starts at or before the write: grow it in place. This is
+      // the common case of appending to a file.
+      Bytes &bytes = first->second;
+      bytes.resize(stop - start);
+      std::memcpy(bytes.data() + (offset - start), data.data(), data.size());
+    } else {
+      Bytes merged(stop - start);
+      for (auto it = first; it != last; ++it) {
+        std::memcpy(merged.data() + (it->first - start), it->second.data(),
+                    it->second.size());
+      }
+      std::memcpy(merged.data() + (offset - start), data.data(), data.size());
+      extents.erase(first, last);
+      extents.emplace(start, std::move(merged));
+    }
+
+    const std::size_t after = stop - start;
+    entry.dirty += after - before;
+    entry.size = std::max(entry.size, end);
+    stats.dirty += after - before;
+  }
+
+  bool Due() const {
+    const std::uint32_t now = clock();
+    for (const auto &it : entries) {
+      if (it.second->Pending() &&
+          now - it.second->dirty_since >= policy.max_age_ms) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Hands the entry's dirty extents to the wrapped volume in one open. A
+  // detached entry has nowhere to go.
+  bool WriteOut(Entry &entry, bool sync) {
+    if (entry.detached) {
+      return false;
+    }
+    if (!entry.Pending() && !(sync && entry.unsynced)) {
+      return true;
+    }
+    auto raw = volume->Open(entry.path, entry.truncate ? OpenMode::kTRUNCATE
+                                                       : OpenMode::kAPPEND);
+    if (!raw) {
+      return false;
+    }
+    const bool pending = entry.Pending();
+    entry.truncate = false;
+    for (auto it = entry.extents.begin(); it != entry.extents.end();) {
+      ConstByteSpan bytes(it->second.data(), it->second.size());
+      if (raw->WriteAt(it->first, bytes) != bytes.size()) {
+        return false;
+      }
+      stats.written += bytes.size();
+      stats.dirty -= bytes.size();
+      entry.dirty -= bytes.size();
+      it = entry.extents.erase(it);
+    }
+    if (pending) {
+      ++stats.flushes;
+    }
+    entry.unsynced = !sync;
+    return !sync || raw->Sync();
+  }
+
+  bool WriteOutAll() {
+    bool ok = true;
+    for (auto it = entries.begin(); it != entries.end();) {
+      ok = WriteOut(*it->second, false) && ok;
+      it = Release(it);
+    }
+    return ok;
+  }
+
+  // Drops the entry if nothing needs it any more.
+  EntryMap::iterator Release(EntryMap::iterator it) {
+    const Entry &entry = *it->second;
+    if (it->second.use_count() == 1 && !entry.Pending() && !entry.unsynced) {
+      return entries.erase(it);
+    }
+    return std::next(it);
+  }
+
+  // Drops every entry at or below `root`, discarding its dirty data. Handles
+  // still open on them fail from then on rather than lose writes quietly.
+  void Detach(const std::string &root) {
+    for (auto it = entries.begin(); it != entries.end();) {
+      if (!Under(it->first, root)) {
+        ++it;
+        continue;
+      }
+      Entry &entry = *it->second;
+      stats.dirty -= entry.dirty;
+      entry.detached = true;
+      it = entries.erase(it);
+    }
+  }
+};
+
+// A handle on a cached file. Writes land in the entry, and reads see the
+// entry's extents over the wrapped file.
+class RawFileImpl : public RawFile {
+public:
+  RawFileImpl(std::shared_ptr<State> state, std::shared_ptr<Entry> entry,
+              bool writable)
+      : state_(state), entry_(entry), writable_(writable) {}
+
+  virtual ~RawFileImpl() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->entries.find(entry_->path.native());
+    if (it != state_->entries.end() && it->second == entry_) {
+      entry_.reset();
+      state_->Release(it);
+    }
+  }
+
+  virtual std::size_t ReadAt(std::uint64_t offset,
+                             ByteSpan buf) override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    Entry &entry = *entry_;
+    if (offset >= entry.size) {
+      return 0;
+    }
+    buf = buf.first(static_cast<std::size_t>(
+        std::min<std::uint64_t>(buf.size(), entry.size - offset)));
+    const std::uint64_t end = offset + buf.size();
+
+    // Read the wrapped file unless one extent covers the whole range.
+    auto it = entry.extents.upper_bound(offset);
+    if (it != entry.extents.begin()) {
+      --it;
+    }
+    const bool covered = it != entry.extents.end() && it->first <= offset &&
+                         it->first + it->second.size() >= end;
+    if (!covered) {
+      std::size_t got = 0;
+      if (!entry.truncate) {
+        auto raw = state_->volume->Open(entry.path, OpenMode::kREAD);
+        got = raw ? raw->ReadAt(offset, buf) : 0;
+      }
+      // Past the wrapped file's end, unwritten bytes read as zeros.
+      std::fill(buf.begin() + got, buf.end(), 0);
+    }
+
+    for (; it != entry.extents.end() && it->first < end; ++it) {
+      const std::uint64_t from = std::max(offset, it->first);
+      const std::uint64_t to =
+          std::min<std::uint64_t>(end, it->first + it->second.size());
+      if (from < to) {
+        std::memcpy(buf.data() + (from - offset),
+                    it->second.data() + (from - it->first), to - from);
+      }
+    }
+    return buf.size();
+  }
+
+  virtual std::size_t WriteAt(std::uint64_t offset,
+                              ConstByteSpan data) override final {
+    if (!writable_) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (entry_->detached) {
+      return 0;
+    }
+    state_->Absorb(*entry_, offset, data);
+    state_->stats.absorbed += data.size();
+    ++state_->stats.writes;
+
+    // A failed write-out keeps the data dirty; it is reported by the next
+    // Sync().
+    if (state_->stats.dirty > state_->policy.max_dirty_bytes ||
+        state_->Due()) {
+      state_->WriteOutAll();
+    }
+    return data.size();
+  }
+
+  virtual std::uint64_t Size() override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return entry_->size;
+  }
+
+  virtual bool Sync() override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->WriteOut(*entry_, true);
+  }
+
+private:
+  std::shared_ptr<State> state_;
+  std::shared_ptr<Entry> entry_;
+  bool writable_;
+};
+
+class WriteBackVolumeImpl : public WriteBackVolume {
+public:
+  WriteBackVolumeImpl(std::shared_ptr<Volume> volume,
+                      const WriteBackPolicy &policy, Clock clock)
+      : state_(std::make_shared<State>()) {
+    state_->volume = volume;
+    state_->policy = policy;
+    state_->clock = clock;
+    if (!state_->clock) {
+      state_->clock = []() { return static_cast<std::uint32_t>(millis()); };
+    }
+    state_->stats = WriteBackStats{};
+  }
+
+  virtual ~WriteBackVolumeImpl() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->WriteOutAll();
+  }
+
+  virtual bool Flush() override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->WriteOutAll();
+  }
+
+  virtual bool FlushDue() const override final {
+    // Busy means another thread is in the volume, maybe writing to the card;
+    // the next call will tell.
+    std::unique_lock<std::mutex> lock(state_->mutex, std::try_to_lock);
+    return lock.owns_lock() && state_->Due();
+  }
+
+  virtual WriteBackStats GetStats() const override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->stats;
+  }
+
+  // Queries go straight to the wrapped volume.
+  virtual bool IsSD() override final { return volume().IsSD(); }
+  virtual std::uint64_t Capacity() override final {
+    return volume().Capacity();
+  }
+  virtual std::uint64_t Available() override final {
+    return volume().Available();
+  }
+  virtual std::uint64_t Used() override final { return volume().Used(); }
+  virtual VolumeStats Stats() override final { return volume().Stats(); }
+  virtual Path MountPoint() override final { return volume().MountPoint(); }
+  virtual Path TempDir() override final { return volume().TempDir(); }
+  virtual bool Exists(PathView path) const override final {
+    return state_->volume->Exists(path);
+  }
+  virtual bool List(const Path &dir,
+                    std::vector<DirEntry> &entries) override final {
+    return volume().List(dir, entries);
+  }
+  virtual MetadataCacheStats CacheStats() const override final {
+    return state_->volume->CacheStats();
+  }
+  virtual std::uint32_t Generation() const override final {
+    return state_->volume->Generation();
+  }
+
+  virtual bool CreateDirs(const Path &path) override final {
+    return volume().CreateDirs(path);
+  }
+  virtual bool Remove(const Path &path) override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->Detach(path.native());
+    return volume().Remove(path);
+  }
+  virtual bool RemoveAll(const Path &path,
+                         const RemoveProgress &progress) override final {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      state_->Detach(path.native());
+    }
+    // Unlocked: `progress` may use the volume.
+    return volume().RemoveAll(path, progress);
+  }
+  virtual bool Rename(const Path &from, const Path &to) override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    // The moved files must be complete on the wrapped volume, and whatever
+    // the rename replaces is gone.
+    for (auto &it : state_->entries) {
+      if (Under(it.first, from.native()) &&
+          !state_->WriteOut(*it.second, false)) {
+        return false;
+      }
+    }
+    state_->Detach(from.native());
+    state_->Detach(to.native());
+    return volume().Rename(from, to);
+  }
+
+  virtual bool Sync() override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    bool ok = state_->WriteOutAll();
+    ok = volume().Sync() && ok;
+    for (auto it = state_->entries.begin(); it != state_->entries.end();) {
+      it->second->unsynced = false;
+      it = state_->Release(it);
+    }
+    return ok;
+  }
+
+  virtual std::unique_ptr<RawFile> Open(PathView path,
+                                        OpenMode mode) override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->entries.find(path.native());
+    if (mode == OpenMode::kREAD) {
+      if (it == state_->entries.end() || !it->second->Pending()) {
+        return volume().Open(path, mode);
+      }
+      return std::make_unique<RawFileImpl>(state_, it->second, false);
+    }
+
+    std::shared_ptr<Entry> entry;
+    if (it != state_->entries.end()) {
+      entry = it->second;
+    } else {
+      // Creates the file, so that the wrapped volume lists it, and learns its
+      // current size.
+      auto raw = volume().Open(path, OpenMode::kAPPEND);
+      if (!raw) {
+        return nullptr;
+      }
+      entry = std::make_shared<Entry>();
+      entry->path = Path(path);
+      entry->size = raw->Size();
+      entry->dirty = 0;
+      entry->dirty_since = 0;
+      entry->truncate = false;
+      entry->unsynced = false;
+      entry->detached = false;
+      state_->entries.emplace(entry->path.native(), entry);
+    }
+
+    if (mode == OpenMode::kTRUNCATE) {
+      // Deferred along with the writes that follow it.
+      if (entry->size > 0 || entry->truncate) {
+        state_->MarkPending(*entry);
+        entry->truncate = true;
+      }
+      state_->stats.dirty -= entry->dirty;
+      entry->dirty = 0;
+      entry->extents.clear();
+      entry->size = 0;
+    }
+    return std::make_unique<RawFileImpl>(state_, entry, true);
+  }
+
+  virtual std::unique_ptr<RawMapping>
+  MapFile(const Path &path) override final {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->entries.find(path.native());
+    if (it != state_->entries.end() && !state_->WriteOut(*it->second, false)) {
+      return nullptr;
+    }
+    return volume().MapFile(path);
+  }
+
+private:
+  std::shared_ptr<State> state_;
+
+  Volume &volume() { return *state_->volume; }
+};
+} // namespace
+
+std::shared_ptr<WriteBackVolume>
+WriteBackVolume::Create(std::shared_ptr<Volume> volume,
+                        const WriteBackPolicy &policy, Clock clock) {
+  return std::make_shared<WriteBackVolumeImpl>(volume, policy, clock);
+}
+} // namespace vfs
+} // namespace cdfw
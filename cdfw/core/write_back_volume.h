@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_CORE_WRITE_BACK_VOLUME_H
+#define CDFW_CORE_WRITE_BACK_VOLUME_H
+
+// A volume decorator that holds file writes in RAM and hands them to the
+// wrapped volume in batches, so that many small updates to a file cost one
+// write to the card.
+//
+// Writes to a file are kept as dirty extents, and overlapping or adjacent
+// writes are merged into one extent. Truncation is deferred with them. Every
+// dirty extent is written out when:
+// - the dirty bytes exceed WriteBackPolicy::max_dirty_bytes (on the write
+//   that crossed it),
+// - the oldest dirty byte is older than WriteBackPolicy::max_age_ms (on the
+//   next write, or by calling Flush() once FlushDue() says so),
+// - Sync() is called on the volume, or on a file (that file only),
+// - the file is mapped, renamed or about to be replaced by a rename.
+// Removing a file discards its dirty data. Writes and Sync() through a handle
+// still open on a file that was removed, renamed or replaced by a rename fail.
+//
+// Files are still created on the wrapped volume when opened, so Exists() and
+// List() need no help. Call Sync() before power-down: anything still dirty is
+// lost with the power.
+
+// Local Headers
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace cdfw {
+namespace vfs {
+struct WriteBackPolicy {
+  std::size_t max_dirty_bytes = 16 * 1024;
+  std::uint32_t max_age_ms = 2000;
+};
+
+// `absorbed` is what callers wrote, `written` what reached the wrapped
+// volume. The gap is what coalescing saved (or what is still dirty).
+struct WriteBackStats {
+  std::uint64_t absorbed;
+  std::uint64_t written;
+  std::uint32_t writes;  // WriteAt() calls absorbed.
+  std::uint32_t flushes; // Files written out.
+  std::size_t dirty;     // Bytes waiting to be written out.
+};
+
+class WriteBackVolume : public Volume {
+public:
+  // Milliseconds since boot.
+  typedef std::function<std::uint32_t()> Clock;
+
+  // Factory method. `clock` defaults to millis().
+  static std::shared_ptr<WriteBackVolume>
+  Create(std::shared_ptr<Volume> volume,
+         const WriteBackPolicy &policy = WriteBackPolicy(),
+         Clock clock = nullptr);
+
+  // Virtual destructor. Dirty data is written out, but not synced.
+  virtual ~WriteBackVolume() = default;
+
+  // Writes out every dirty file, without syncing. Returns false if any could
+  // not be written; their data stays dirty.
+  virtual bool Flush() = 0;
+
+  // Returns true if dirty data has outlived WriteBackPolicy::max_age_ms.
+  // Never touches the wrapped volume and never blocks, so it can be polled
+  // from the UI loop; returns false while another thread is using the volume.
+  virtual bool FlushDue() const = 0;
+
+  virtual WriteBackStats GetStats() const = 0;
+};
+} // namespace vfs
+} // namespace cdfw
+
+#endif // CDFW_CORE_WRITE_BACK_VOLUME_H
@@ -0,0 +1,29 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/gui/internal/menu.h"
+
+// Third Party Headers
+#include <lvgl.h>
+
+namespace cdfw {
+namespace gui {
+namespace {
+void LazyLoadPageEventHandler(lv_event_t *e) {
+  auto lazy = static_cast<LazyMenuPage *>(lv_event_get_user_data(e));
+  if (lazy->page == nullptr) {
+    lazy->page = lazy->build();
+  }
+  lv_menu_set_page(lazy->menu, lazy->page);
+}
+} // namespace
+
+void SetLazyLoadPageEvent(lv_obj_t *obj, LazyMenuPage *page) {
+  lv_obj_add_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_flag(obj, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
+  lv_obj_add_event_cb(obj, LazyLoadPageEventHandler, LV_EVENT_CLICKED, page);
+}
+} // namespace gui
+} // namespace cdfw
@@ -0,0 +1,31 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_GUI_INTERNAL_MENU_H
+#define CDFW_GUI_INTERNAL_MENU_H
+
+// Third Party Headers
+#include <lvgl.h>
+
+// C++ Standard Library Headers
+#include <functional>
+
+namespace cdfw {
+namespace gui {
+// An lv_menu page that is only built the first time it is navigated to.
+// `build` creates the page in `menu` and returns it. Reset `page` to nullptr
+// when the menu is deleted.
+struct LazyMenuPage {
+  lv_obj_t *menu = nullptr;
+  lv_obj_t *page = nullptr;
+  std::function<lv_obj_t *()> build;
+};
+
+// Like lv_menu_set_load_page_event(), but builds the page on the first click.
+// `page` must outlive `obj`.
+void SetLazyLoadPageEvent(lv_obj_t *obj, LazyMenuPage *page);
+} // namespace gui
+} // namespace cdfw
+
+#endif // CDFW_GUI_INTERNAL_MENU_H
@@ -68,6 +68,12 @@ public:
     }
   }
 
+  void Destroy() override final {
+    // Deferred, as this can run from one of the screen's own event handlers.
+    lv_obj_delete_async(scr_);
+    scr_ = nullptr;
+  }
+
   void Show() override final { lv_scr_load(scr_); }
 
 private:
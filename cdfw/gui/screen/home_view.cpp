@@ -136,6 +136,14 @@ public:
     }
   }
 
+  void Destroy() override final {
+    // Deferred, as this can run from one of the screen's own event handlers.
+    lv_obj_delete_async(scr_);
+    scr_ = nullptr;
+    wifi_btn_ = nullptr;
+    wifi_label_ = nullptr;
+  }
+
   void Show() override final { lv_scr_load(scr_); }
 
   void SetWifiColor(const lv_color_t &color) override final {
@@ -150,13 +158,6 @@ public:
     }
   }
 
-  void DelayedShow() override final {
-    // Queue timed animation to show the home screen.
-    lv_screen_load_anim(scr_, LV_SCR_LOAD_ANIM_FADE_IN, /*time*/ 200,
-                        /*delay*/ 1500,
-                        /*auto_del*/ true);
-  }
-
 private:
   lv_obj_t *scr_;
   lv_obj_t *wifi_btn_;
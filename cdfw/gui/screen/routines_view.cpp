@@ -6,6 +6,7 @@
 #include "cdfw/gui/screen/routines_view.h"
 #include "cdfw/core/ui/routines_presenter.h"
 #include "cdfw/gui/internal/color.h"
+#include "cdfw/gui/internal/menu.h"
 #include "cdfw/gui/internal/styles.h"
 
 // Third Party Headers
@@ -14,6 +15,7 @@
 // C++ Standard Library Headers
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace cdfw {
 namespace gui {
@@ -55,7 +57,9 @@ void AddLine(lv_obj_t *obj) {
 
 class RoutinesViewImpl : public RoutinesView {
 public:
-  RoutinesViewImpl() : scr_(nullptr) {}
+  RoutinesViewImpl()
+      : scr_(nullptr), menu_(nullptr), routines_section_(nullptr),
+        payload_{nullptr, nullptr} {}
   virtual ~RoutinesViewImpl() = default;
 
   void Init(core::ui::RoutinesPresenter *presenter) override final {
@@ -88,8 +92,8 @@ public:
       lv_obj_set_size(back_btn, 40, 40);
       lv_obj_set_flex_align(back_btn, LV_FLEX_ALIGN_CENTER,
                             LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-      static BackEventPayload payload = {menu, presenter};
-      lv_obj_add_event_cb(menu, BackEventHandler, LV_EVENT_CLICKED, &payload);
+      payload_ = {menu, presenter};
+      lv_obj_add_event_cb(menu, BackEventHandler, LV_EVENT_CLICKED, &payload_);
 
       // Sole purpose of this object is to balance the back_btn so that the
       // title is centered.
@@ -111,50 +115,81 @@ public:
       lv_menu_set_page(menu, main_page);
     }
 
-    // For each routine, create a sub-page and add a corresponding menu item to
-    // the main page.
-    std::string routines[] = {"Routine A", "Routine B", "Routine C",
-                              "Routine D", "Routine E"};
+    menu_ = menu;
+    routines_section_ = routines_section;
+  }
+
+  void SetRoutines(const std::vector<std::string> &routines) override final {
+    // Drop the previous list; the presenter resends the whole list on change.
+    lv_obj_clean(routines_section_);
+    for (const auto &sub_page : sub_pages_) {
+      if (sub_page->page != nullptr) {
+        lv_obj_delete(sub_page->page);
+      }
+    }
+    sub_pages_.clear();
+
+    // For each routine, add a menu item to the main page. Its sub-page is only
+    // built when it is opened.
     bool first_routine = true;
     for (auto &routine : routines) {
       if (!first_routine) {
-        AddLine(routines_section);
+        AddLine(routines_section_);
       } else {
         first_routine = false;
       }
 
-      auto sub_page = lv_menu_page_create(menu, routine.c_str());
-      {
+      auto sub_page = std::make_unique<LazyMenuPage>();
+      sub_page->menu = menu_;
+      sub_page->build = [menu = menu_, routine]() {
+        auto page = lv_menu_page_create(menu, routine.c_str());
         lv_obj_set_style_pad_hor(
-            sub_page,
-            lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0), 0);
+            page, lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0),
+            0);
 
-        lv_menu_separator_create(sub_page);
-        auto section = lv_menu_section_create(sub_page);
+        lv_menu_separator_create(page);
+        auto section = lv_menu_section_create(page);
         auto label = lv_label_create(section);
         lv_label_set_text(label, "TODO");
-
+        return page;
+      };
+      {
         // Add menu item to main page.
-        auto cont = lv_menu_cont_create(routines_section);
-        label = lv_label_create(cont);
+        auto cont = lv_menu_cont_create(routines_section_);
+        auto label = lv_label_create(cont);
         lv_label_set_text(label, routine.c_str());
         lv_obj_set_flex_grow(label, 1);
         label = lv_label_create(cont);
         lv_label_set_text(label, LV_SYMBOL_RIGHT);
         lv_obj_set_style_text_color(
             label,
-            lv_color_darken(lv_obj_get_style_bg_color(routines_section, 0), 50),
+            lv_color_darken(lv_obj_get_style_bg_color(routines_section_, 0),
+                            50),
             0);
 
-        lv_menu_set_load_page_event(menu, cont, sub_page);
+        SetLazyLoadPageEvent(cont, sub_page.get());
       }
+      sub_pages_.push_back(std::move(sub_page));
     }
   }
 
+  void Destroy() override final {
+    // Deferred, as this can run from one of the screen's own event handlers.
+    lv_obj_delete_async(scr_);
+    scr_ = nullptr;
+    menu_ = nullptr;
+    routines_section_ = nullptr;
+    sub_pages_.clear();
+  }
+
   void Show() override final { lv_scr_load(scr_); }
 
 private:
   lv_obj_t *scr_;
+  lv_obj_t *menu_;
+  lv_obj_t *routines_section_;
+  BackEventPayload payload_;
+  std::vector<std::unique_ptr<LazyMenuPage>> sub_pages_;
 };
 } // namespace
 
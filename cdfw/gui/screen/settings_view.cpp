@@ -8,6 +8,7 @@
 #include "cdfw/core/version.h"
 #include "cdfw/core/wifi.h"
 #include "cdfw/gui/internal/color.h"
+#include "cdfw/gui/internal/menu.h"
 #include "cdfw/gui/internal/styles.h"
 
 // Third Party Headers
@@ -92,10 +93,20 @@ void AddLine(lv_obj_t *obj) {
 
 class SettingsViewImpl : public SettingsView {
 public:
-  SettingsViewImpl() : scr_(nullptr) {}
+  SettingsViewImpl()
+      : scr_(nullptr), menu_(nullptr), presenter_(nullptr),
+        payload_{nullptr, nullptr} {
+    wifi_page_.build = [this]() { return BuildWifiPage(); };
+    password_page_.build = [this]() { return BuildPasswordPage(); };
+    display_page_.build = [this]() { return BuildDisplayPage(); };
+    about_page_.build = [this]() { return BuildAboutPage(); };
+    device_info_page_.build = [this]() { return BuildDeviceInfoPage(); };
+    license_page_.build = [this]() { return BuildLicensePage(); };
+  }
   virtual ~SettingsViewImpl() = default;
 
   void Init(core::ui::SettingsPresenter *presenter) override final {
+    presenter_ = presenter;
     scr_ = lv_obj_create(NULL);
     // lv_obj_add_style(scr_, &Styles::GetInstance().style_scr, 0);
 
@@ -135,8 +146,8 @@ public:
       lv_obj_set_size(back_btn, 40, 40);
       lv_obj_set_flex_align(back_btn, LV_FLEX_ALIGN_CENTER,
                             LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-      static BackEventPayload payload = {menu, presenter};
-      lv_obj_add_event_cb(menu, BackEventHandler, LV_EVENT_CLICKED, &payload);
+      payload_ = {menu, presenter};
+      lv_obj_add_event_cb(menu, BackEventHandler, LV_EVENT_CLICKED, &payload_);
       // debug: show back_btn border
       // lv_obj_set_style_border_opa(back_btn, LV_OPA_COVER, 0);
       // lv_obj_set_style_border_width(back_btn, 1, 0);
@@ -149,257 +160,13 @@ public:
       lv_obj_set_style_border_opa(header_balance_obj, LV_OPA_TRANSP, 0);
       lv_obj_set_size(header_balance_obj, 40, 40);
     }
+    menu_ = menu;
 
-    // Now we work through the sub-pages.
-    // Setup Wi-Fi sub page.
-    auto sub_page_wifi = lv_menu_page_create(menu, "Wi-Fi");
-    {
-      lv_obj_set_style_pad_hor(
-          sub_page_wifi,
-          lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0), 0);
-
-      AddMenuSeparator(sub_page_wifi);
-      auto section = lv_menu_section_create(sub_page_wifi);
-      {
-        // Menu item for enabling/disabling Wi-Fi.
-        {
-          auto cont = lv_menu_cont_create(section);
-          auto img = lv_image_create(cont);
-          lv_image_set_src(img, LV_SYMBOL_WIFI);
-          auto label = lv_label_create(cont);
-          lv_label_set_text(label, "Wi-Fi");
-          lv_obj_set_flex_grow(label, 1);
-          auto toggle = lv_switch_create(cont);
-          lv_obj_add_state(toggle, LV_STATE_CHECKED);
-          lv_obj_add_event_cb(
-              toggle,
-              [](lv_event_t *e) {
-                lv_event_code_t code = lv_event_get_code(e);
-                auto obj = static_cast<lv_obj_t *>(lv_event_get_target(e));
-                if (code == LV_EVENT_PRESSED) {
-                  auto pres = static_cast<core::ui::SettingsPresenter *>(
-                      lv_event_get_user_data(e));
-                  pres->OnWifiEnabled(!lv_obj_has_state(obj, LV_STATE_CHECKED));
-                }
-              },
-              LV_EVENT_PRESSED, presenter);
-        }
-
-        AddLine(section);
-
-        // Menu item for displaying Wi-Fi status.
-        {
-          auto cont = lv_menu_cont_create(section);
-          auto led = lv_led_create(cont);
-          lv_led_set_color(led, lv_palette_main(LV_PALETTE_ORANGE));
-          lv_led_set_brightness(led, 195); // 75% of MAX
-          lv_obj_set_size(led, 10, 10);
-
-          auto label = lv_label_create(cont);
-          lv_label_set_text(label, "Not connected");
-          lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_GREY),
-                                      0);
-          lv_obj_set_flex_grow(label, 1);
-
-          // Menu item for connecting to a Wi-Fi network.
-          // TODO: Currently this is just a switch for playing with GUI event
-          // propagation, but otherwise the switch does nothing. Real
-          // implementation interfacing with business logic that uses the WiFi
-          // library will be added later.
-          // BUG: Set WiFi enabled, connect, disable, re-enable. WiFi icon is
-          // red (disconnected) despite WiFi being enabled and connected.
-          auto btn = lv_btn_create(cont);
-          label = lv_label_create(btn);
-          lv_label_set_text(label, "Connect");
-          lv_obj_add_event_cb(
-              btn,
-              [](lv_event_t *e) {
-                lv_event_code_t code = lv_event_get_code(e);
-                auto obj = static_cast<lv_obj_t *>(lv_event_get_target(e));
-                if (code == LV_EVENT_PRESSED) {
-                  auto pres = static_cast<core::ui::SettingsPresenter *>(
-                      lv_event_get_user_data(e));
-                  pres->OnWifiConnectRequest(
-                      !lv_obj_has_state(obj, LV_STATE_CHECKED));
-                }
-              },
-              LV_EVENT_PRESSED, presenter);
-        }
-      }
-
-      // Password sub-page of the Wi-Fi page.
-      auto sub_page_wifi_password = lv_menu_page_create(menu, "Password");
-      {
-        lv_obj_set_style_pad_hor(
-            sub_page_wifi_password,
-            lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0), 0);
-
-        AddMenuSeparator(sub_page_wifi_password);
-        auto section = lv_menu_section_create(sub_page_wifi_password);
-        {
-          // Menu item for entering a Wi-Fi password.
-          auto cont = lv_menu_cont_create(section);
-          auto ta = lv_textarea_create(cont);
-          lv_textarea_set_placeholder_text(ta, "Password");
-          lv_obj_set_flex_grow(ta, 1);
-          lv_textarea_set_one_line(ta, true);
-
-          // cont = lv_menu_cont_create(section);
-          auto btn = lv_btn_create(cont);
-          auto label = lv_label_create(btn);
-          lv_label_set_text(label, "Connect");
-          lv_obj_add_flag(btn, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK);
-
-          // cont = lv_menu_cont_create(sub_page_wifi_password);
-          // lv_obj_t * kb = lv_keyboard_create(cont);
-          lv_obj_t *kb = lv_keyboard_create(sub_page_wifi_password);
-          lv_obj_add_flag(kb, LV_OBJ_FLAG_IGNORE_LAYOUT);
-          lv_obj_align(kb, LV_ALIGN_BOTTOM_MID, 0, 0);
-          lv_keyboard_set_textarea(kb, ta);
-          lv_obj_add_event_cb(ta, TAEventHandler, LV_EVENT_ALL, kb);
-          lv_obj_set_flex_grow(kb, 1);
-        }
-      }
-
-      // TODO: Find a better way to implement this spacing.
-      AddMenuSeparator(sub_page_wifi);
-      AddMenuSeparator(sub_page_wifi);
-      AddMenuSeparator(sub_page_wifi);
-      auto label = lv_label_create(sub_page_wifi);
-      lv_label_set_text(label, "Available Networks");
-      AddMenuSeparator(sub_page_wifi);
-      section = lv_menu_section_create(sub_page_wifi);
-      {
-        // Create a fake list of available networks.
-        bool first_network = true;
-        for (int i = 0; i < 3; i++) {
-          if (!first_network) {
-            AddLine(section);
-          } else {
-            first_network = false;
-          }
-          auto cont = lv_menu_cont_create(section);
-          // lv_obj_add_flag(cont, LV_OBJ_FLAG_CLICKABLE);
-          auto label = lv_label_create(cont);
-          lv_label_set_text(
-              label, (std::string("Network ") + std::to_string(i)).c_str());
-          lv_obj_set_flex_grow(label, 1);
-          label = lv_label_create(cont);
-          lv_label_set_text(label, LV_SYMBOL_RIGHT);
-          lv_obj_set_style_text_color(
-              label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
-              0);
-          lv_menu_set_load_page_event(menu, cont, sub_page_wifi_password);
-          lv_obj_add_event_cb(cont, ConnectEventHandler, LV_EVENT_CLICKED,
-                              label);
-          // Cache wifi password sub page so that it's title can be updated.
-          s_password_page = sub_page_wifi_password;
-        }
-      }
-    }
-
-    // Setup Display sub page.
-    auto sub_page_display = lv_menu_page_create(menu, "Display");
-    {
-      lv_obj_set_style_pad_hor(
-          sub_page_display,
-          lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0), 0);
-
-      AddMenuSeparator(sub_page_display);
-      auto section = lv_menu_section_create(sub_page_display);
-      {
-        // Menu item for enabling/disabling auto brightness.
-        // TODO: Implement functionality.
-        auto cont = lv_menu_cont_create(section);
-        auto img = lv_image_create(cont);
-        // TODO: Find a better icon (e.g., sun).
-        lv_image_set_src(img, LV_SYMBOL_CHARGE);
-        auto label = lv_label_create(cont);
-        lv_label_set_text(label, "Auto adjust brightness");
-        lv_obj_set_flex_grow(label, 1);
-        auto toggle = lv_switch_create(cont);
-        lv_obj_add_state(toggle, LV_STATE_CHECKED);
-      }
-    }
-
-    // Setup About sub page.
-    auto sub_page_about = lv_menu_page_create(menu, "About");
-    {
-      // Device Information sub page.
-      auto sub_page_device_info =
-          lv_menu_page_create(menu, "Device Information");
-      {
-        lv_obj_set_style_pad_hor(
-            sub_page_device_info,
-            lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0), 0);
-
-        AddMenuSeparator(sub_page_device_info);
-        auto section = lv_menu_section_create(sub_page_device_info);
-
-        // Software info menu item.
-        // TODO: Should we get version from a model like the boot view? If not,
-        // then why are we doing it in the boot view?
-        auto cont = lv_menu_cont_create(section);
-        auto label = lv_label_create(cont);
-        lv_label_set_text(label, "Firmware Version");
-        lv_obj_set_flex_grow(label, 1);
-        label = lv_label_create(cont);
-        std::uint8_t buf_size = 8;
-        char str_buf[buf_size];
-        std::snprintf(str_buf, buf_size, "v%s", CDFW_VERSION);
-        lv_label_set_text(label, str_buf);
-      }
-
-      // License Information sub page.
-      auto sub_page_license_info = lv_menu_page_create(menu, "License");
-      {
-        lv_obj_set_style_pad_hor(
-            sub_page_license_info,
-            lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0), 0);
-
-        AddMenuSeparator(sub_page_license_info);
-        auto section = lv_menu_section_create(sub_page_license_info);
-
-        // License info menu item.
-        auto cont = lv_menu_cont_create(section);
-        auto label = lv_label_create(cont);
-        lv_label_set_text(label, "GNU General Public License (GPL) v3.0\n"
-                                 "Copyright (c) 2025 Ian Dinwoodie");
-      }
-
-      // Organize the About sub page.
-      lv_obj_set_style_pad_hor(
-          sub_page_about,
-          lv_obj_get_style_pad_left(lv_menu_get_main_header(menu), 0), 0);
-      AddMenuSeparator(sub_page_about);
-      auto section = lv_menu_section_create(sub_page_about);
-      {
-        // Device Information menu item.
-        auto cont = lv_menu_cont_create(section);
-        auto label = lv_label_create(cont);
-        lv_label_set_text(label, "Device Information");
-        lv_obj_set_flex_grow(label, 1);
-        label = lv_label_create(cont);
-        lv_label_set_text(label, LV_SYMBOL_RIGHT);
-        lv_obj_set_style_text_color(
-            label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
-            0);
-        lv_menu_set_load_page_event(menu, cont, sub_page_device_info);
-
-        AddLine(section);
-
-        // License Information menu item.
-        cont = lv_menu_cont_create(section);
-        label = lv_label_create(cont);
-        lv_label_set_text(label, "License");
-        lv_obj_set_flex_grow(label, 1);
-        label = lv_label_create(cont);
-        lv_label_set_text(label, LV_SYMBOL_RIGHT);
-        lv_obj_set_style_text_color(
-            label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
-            0);
-        lv_menu_set_load_page_event(menu, cont, sub_page_license_info);
-      }
+    // Sub-pages are built when they are first navigated to.
+    for (auto page : {&wifi_page_, &password_page_, &display_page_,
+                      &about_page_, &device_info_page_, &license_page_}) {
+      page->menu = menu;
+      page->page = nullptr;
     }
 
     // Initialize main menu page.
@@ -427,7 +194,7 @@ public:
           lv_obj_set_style_text_color(
               label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
               0);
-          lv_menu_set_load_page_event(menu, cont, sub_page_wifi);
+          SetLazyLoadPageEvent(cont, &wifi_page_);
         }
 
         AddLine(section);
@@ -446,7 +213,7 @@ public:
           lv_obj_set_style_text_color(
               label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
               0);
-          lv_menu_set_load_page_event(menu, cont, sub_page_display);
+          SetLazyLoadPageEvent(cont, &display_page_);
         }
       }
 
@@ -463,7 +230,7 @@ public:
         lv_obj_set_style_text_color(
             label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
             0);
-        lv_menu_set_load_page_event(menu, cont, sub_page_about);
+        SetLazyLoadPageEvent(cont, &about_page_);
       }
 
       // Set the initial menu page.
@@ -471,6 +238,19 @@ public:
     }
   }
 
+  void Destroy() override final {
+    // Deferred, as this can run from one of the screen's own event handlers.
+    lv_obj_delete_async(scr_);
+    scr_ = nullptr;
+    menu_ = nullptr;
+    for (auto page : {&wifi_page_, &password_page_, &display_page_,
+                      &about_page_, &device_info_page_, &license_page_}) {
+      page->menu = nullptr;
+      page->page = nullptr;
+    }
+    s_password_page = nullptr;
+  }
+
   void Show() override final { lv_scr_load(scr_); }
 
   virtual void SetWifiEnabled(bool enabled) override final {
@@ -488,6 +268,261 @@ public:
 
 private:
   lv_obj_t *scr_;
+  lv_obj_t *menu_;
+  core::ui::SettingsPresenter *presenter_;
+  BackEventPayload payload_;
+  LazyMenuPage wifi_page_;
+  LazyMenuPage password_page_;
+  LazyMenuPage display_page_;
+  LazyMenuPage about_page_;
+  LazyMenuPage device_info_page_;
+  LazyMenuPage license_page_;
+
+  // Creates an empty sub-page, padded to line up with the header.
+  lv_obj_t *CreatePage(const char *title) {
+    auto page = lv_menu_page_create(menu_, title);
+    lv_obj_set_style_pad_hor(
+        page, lv_obj_get_style_pad_left(lv_menu_get_main_header(menu_), 0), 0);
+    return page;
+  }
+
+  lv_obj_t *BuildWifiPage() {
+    auto sub_page_wifi = CreatePage("Wi-Fi");
+    auto presenter = presenter_;
+
+    AddMenuSeparator(sub_page_wifi);
+    auto section = lv_menu_section_create(sub_page_wifi);
+    {
+      // Menu item for enabling/disabling Wi-Fi.
+      {
+        auto cont = lv_menu_cont_create(section);
+        auto img = lv_image_create(cont);
+        lv_image_set_src(img, LV_SYMBOL_WIFI);
+        auto label = lv_label_create(cont);
+        lv_label_set_text(label, "Wi-Fi");
+        lv_obj_set_flex_grow(label, 1);
+        auto toggle = lv_switch_create(cont);
+        lv_obj_add_state(toggle, LV_STATE_CHECKED);
+        lv_obj_add_event_cb(
+            toggle,
+            [](lv_event_t *e) {
+              lv_event_code_t code = lv_event_get_code(e);
+              auto obj = static_cast<lv_obj_t *>(lv_event_get_target(e));
+              if (code == LV_EVENT_PRESSED) {
+                auto pres = static_cast<core::ui::SettingsPresenter *>(
+                    lv_event_get_user_data(e));
+                pres->OnWifiEnabled(!lv_obj_has_state(obj, LV_STATE_CHECKED));
+              }
+            },
+            LV_EVENT_PRESSED, presenter);
+      }
+
+      AddLine(section);
+
+      // Menu item for displaying Wi-Fi status.
+      {
+        auto cont = lv_menu_cont_create(section);
+        auto led = lv_led_create(cont);
+        lv_led_set_color(led, lv_palette_main(LV_PALETTE_ORANGE));
+        lv_led_set_brightness(led, 195); // 75% of MAX
+        lv_obj_set_size(led, 10, 10);
+
+        auto label = lv_label_create(cont);
+        lv_label_set_text(label, "Not connected");
+        lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_GREY),
+                                    0);
+        lv_obj_set_flex_grow(label, 1);
+
+        // Menu item for connecting to a Wi-Fi network.
+        // TODO: Currently this is just a switch for playing with GUI event
+        // propagation, but otherwise the switch does nothing. Real
+        // implementation interfacing with business logic that uses the WiFi
+        // library will be added later.
+        // BUG: Set WiFi enabled, connect, disable, re-enable. WiFi icon is
+        // red (disconnected) despite WiFi being enabled and connected.
+        auto btn = lv_btn_create(cont);
+        label = lv_label_create(btn);
+        lv_label_set_text(label, "Connect");
+        lv_obj_add_event_cb(
+            btn,
+            [](lv_event_t *e) {
+              lv_event_code_t code = lv_event_get_code(e);
+              auto obj = static_cast<lv_obj_t *>(lv_event_get_target(e));
+              if (code == LV_EVENT_PRESSED) {
+                auto pres = static_cast<core::ui::SettingsPresenter *>(
+                    lv_event_get_user_data(e));
+                pres->OnWifiConnectRequest(
+                    !lv_obj_has_state(obj, LV_STATE_CHECKED));
+              }
+            },
+            LV_EVENT_PRESSED, presenter);
+      }
+    }
+
+    // TODO: Find a better way to implement this spacing.
+    AddMenuSeparator(sub_page_wifi);
+    AddMenuSeparator(sub_page_wifi);
+    AddMenuSeparator(sub_page_wifi);
+    auto label = lv_label_create(sub_page_wifi);
+    lv_label_set_text(label, "Available Networks");
+    AddMenuSeparator(sub_page_wifi);
+    section = lv_menu_section_create(sub_page_wifi);
+    {
+      // Create a fake list of available networks.
+      bool first_network = true;
+      for (int i = 0; i < 3; i++) {
+        if (!first_network) {
+          AddLine(section);
+        } else {
+          first_network = false;
+        }
+        auto cont = lv_menu_cont_create(section);
+        // lv_obj_add_flag(cont, LV_OBJ_FLAG_CLICKABLE);
+        auto label = lv_label_create(cont);
+        lv_label_set_text(
+            label, (std::string("Network ") + std::to_string(i)).c_str());
+        lv_obj_set_flex_grow(label, 1);
+        label = lv_label_create(cont);
+        lv_label_set_text(label, LV_SYMBOL_RIGHT);
+        lv_obj_set_style_text_color(
+            label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
+            0);
+        // The password page is built before the handler below retitles it.
+        SetLazyLoadPageEvent(cont, &password_page_);
+        lv_obj_add_event_cb(cont, ConnectEventHandler, LV_EVENT_CLICKED,
+                            label);
+      }
+    }
+    return sub_page_wifi;
+  }
+
+  // Password sub-page of the Wi-Fi page.
+  lv_obj_t *BuildPasswordPage() {
+    auto sub_page_wifi_password = CreatePage("Password");
+
+    AddMenuSeparator(sub_page_wifi_password);
+    auto section = lv_menu_section_create(sub_page_wifi_password);
+    {
+      // Menu item for entering a Wi-Fi password.
+      auto cont = lv_menu_cont_create(section);
+      auto ta = lv_textarea_create(cont);
+      lv_textarea_set_placeholder_text(ta, "Password");
+      lv_obj_set_flex_grow(ta, 1);
+      lv_textarea_set_one_line(ta, true);
+
+      // cont = lv_menu_cont_create(section);
+      auto btn = lv_btn_create(cont);
+      auto label = lv_label_create(btn);
+      lv_label_set_text(label, "Connect");
+      lv_obj_add_flag(btn, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK);
+
+      // cont = lv_menu_cont_create(sub_page_wifi_password);
+      // lv_obj_t * kb = lv_keyboard_create(cont);
+      lv_obj_t *kb = lv_keyboard_create(sub_page_wifi_password);
+      lv_obj_add_flag(kb, LV_OBJ_FLAG_IGNORE_LAYOUT);
+      lv_obj_align(kb, LV_ALIGN_BOTTOM_MID, 0, 0);
+      lv_keyboard_set_textarea(kb, ta);
+      lv_obj_add_event_cb(ta, TAEventHandler, LV_EVENT_ALL, kb);
+      lv_obj_set_flex_grow(kb, 1);
+    }
+
+    // Cache wifi password sub page so that it's title can be updated.
+    s_password_page = sub_page_wifi_password;
+    return sub_page_wifi_password;
+  }
+
+  lv_obj_t *BuildDisplayPage() {
+    auto sub_page_display = CreatePage("Display");
+
+    AddMenuSeparator(sub_page_display);
+    auto section = lv_menu_section_create(sub_page_display);
+    {
+      // Menu item for enabling/disabling auto brightness.
+      // TODO: Implement functionality.
+      auto cont = lv_menu_cont_create(section);
+      auto img = lv_image_create(cont);
+      // TODO: Find a better icon (e.g., sun).
+      lv_image_set_src(img, LV_SYMBOL_CHARGE);
+      auto label = lv_label_create(cont);
+      lv_label_set_text(label, "Auto adjust brightness");
+      lv_obj_set_flex_grow(label, 1);
+      auto toggle = lv_switch_create(cont);
+      lv_obj_add_state(toggle, LV_STATE_CHECKED);
+    }
+    return sub_page_display;
+  }
+
+  lv_obj_t *BuildAboutPage() {
+    auto sub_page_about = CreatePage("About");
+
+    AddMenuSeparator(sub_page_about);
+    auto section = lv_menu_section_create(sub_page_about);
+    {
+      // Device Information menu item.
+      auto cont = lv_menu_cont_create(section);
+      auto label = lv_label_create(cont);
+      lv_label_set_text(label, "Device Information");
+      lv_obj_set_flex_grow(label, 1);
+      label = lv_label_create(cont);
+      lv_label_set_text(label, LV_SYMBOL_RIGHT);
+      lv_obj_set_style_text_color(
+          label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
+          0);
+      SetLazyLoadPageEvent(cont, &device_info_page_);
+
+      AddLine(section);
+
+      // License Information menu item.
+      cont = lv_menu_cont_create(section);
+      label = lv_label_create(cont);
+      lv_label_set_text(label, "License");
+      lv_obj_set_flex_grow(label, 1);
+      label = lv_label_create(cont);
+      lv_label_set_text(label, LV_SYMBOL_RIGHT);
+      lv_obj_set_style_text_color(
+          label, lv_color_darken(lv_obj_get_style_bg_color(section, 0), 50),
+          0);
+      SetLazyLoadPageEvent(cont, &license_page_);
+    }
+    return sub_page_about;
+  }
+
+  // Device Information sub-page of the About page.
+  lv_obj_t *BuildDeviceInfoPage() {
+    auto sub_page_device_info = CreatePage("Device Information");
+
+    AddMenuSeparator(sub_page_device_info);
+    auto section = lv_menu_section_create(sub_page_device_info);
+
+    // Software info menu item.
+    // TODO: Should we get version from a model like the boot view? If not,
+    // then why are we doing it in the boot view?
+    auto cont = lv_menu_cont_create(section);
+    auto label = lv_label_create(cont);
+    lv_label_set_text(label, "Firmware Version");
+    lv_obj_set_flex_grow(label, 1);
+    label = lv_label_create(cont);
+    std::uint8_t buf_size = 8;
+    char str_buf[buf_size];
+    std::snprintf(str_buf, buf_size, "v%s", CDFW_VERSION);
+    lv_label_set_text(label, str_buf);
+    return sub_page_device_info;
+  }
+
+  // License Information sub-page of the About page.
+  lv_obj_t *BuildLicensePage() {
+    auto sub_page_license_info = CreatePage("License");
+
+    AddMenuSeparator(sub_page_license_info);
+    auto section = lv_menu_section_create(sub_page_license_info);
+
+    // License info menu item.
+    auto cont = lv_menu_cont_create(section);
+    auto label = lv_label_create(cont);
+    lv_label_set_text(label, "GNU General Public License (GPL) v3.0\n"
+                             "Copyright (c) 2025 Ian Dinwoodie");
+    return sub_page_license_info;
+  }
 };
 } // namespace
 
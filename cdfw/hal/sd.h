@@ -15,6 +15,12 @@
 
 #define CDFW_SD_VOLUME_NAME "sd"
 
+// SPI clock for the card, in Hz. Overridable at build time, e.g. to compare
+// clocks with the storage benchmarks.
+#ifndef CDFW_SD_SPI_FREQUENCY
+#define CDFW_SD_SPI_FREQUENCY 80000000
+#endif
+
 namespace cdfw {
 namespace hal {
 // Representation of the SD device.
@@ -6,7 +6,9 @@
 
 // Local Headers
 #include "cdfw/compat/arduino.h"
+#include "cdfw/core/path_buf.h"
 #include "cdfw/core/vfs.h"
+#include "cdfw/core/vfs_tree.h"
 #include "cdfw/hal/sd.h"
 
 // Third Party Headers
@@ -15,9 +17,14 @@
 #include <SPI.h>
 
 // C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
-#include <iostream>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 #define TO_MOUNT_POINT "/" CDFW_SD_VOLUME_NAME
 
@@ -27,33 +34,90 @@ namespace {
 namespace ardfs = ::fs;
 namespace stdfs = std::filesystem;
 
+// Arduino file on the card. fs::File reads and writes go straight between the
+// caller's memory and FATFS once stdio buffering is turned off.
+class RawFileImpl : public vfs::RawFile {
+public:
+  RawFileImpl(ardfs::File file) : file_(file) { file_.setBufferSize(0); }
+  virtual ~RawFileImpl() { file_.close(); }
+
+  virtual std::size_t ReadAt(std::uint64_t offset,
+                             ByteSpan buf) override final {
+    if (!SeekTo(offset)) {
+      return 0;
+    }
+    return file_.read(buf.data(), buf.size());
+  }
+
+  virtual std::size_t WriteAt(std::uint64_t offset,
+                              ConstByteSpan data) override final {
+    if (!SeekTo(offset)) {
+      return 0;
+    }
+    return file_.write(data.data(), data.size());
+  }
+
+  virtual std::uint64_t Size() override final { return file_.size(); }
+
+  virtual bool Sync() override final {
+    file_.flush();
+    return true;
+  }
+
+private:
+  ardfs::File file_;
+
+  bool SeekTo(std::uint64_t offset) {
+    // FAT32 files are limited to 4 GiB, as is fs::File.
+    if (offset > UINT32_MAX) {
+      return false;
+    }
+    return file_.position() == offset ||
+           file_.seek(static_cast<std::uint32_t>(offset), ardfs::SeekSet);
+  }
+};
+
 class SDImpl : public hal::SD {
 public:
   SDImpl() : spi_(SPIClass(VSPI)), sd_(::SD) {}
   virtual ~SDImpl() { sd_.end(); }
 
   void Init() {
-    if (!sd_.begin(SS, spi_, 80000000, TO_MOUNT_POINT)) {
+    if (!sd_.begin(SS, spi_, CDFW_SD_SPI_FREQUENCY, TO_MOUNT_POINT)) {
       Serial.println("Error: Failed to mount card.");
       return;
     }
   }
 
-  virtual std::uint64_t Capacity() override final {
-    std::cout << "Capacity: " << sd_.cardSize() << std::endl;
-    return sd_.cardSize();
-  }
+  // Sizes are those of the FAT volume rather than the raw card, so that the
+  // three add up. usedBytes() counts free clusters and is slow on big cards.
+  virtual std::uint64_t Capacity() override final { return sd_.totalBytes(); }
   virtual std::uint64_t Available() override final {
-    std::cout << "Available: " << sd_.totalBytes() << std::endl;
-    return sd_.totalBytes();
+    return sd_.totalBytes() - sd_.usedBytes();
   }
-  virtual std::uint64_t Used() override final {
-    return Capacity() - Available();
+  virtual std::uint64_t Used() override final { return sd_.usedBytes(); }
+  virtual vfs::VolumeStats Stats() override final {
+    vfs::VolumeStats stats;
+    stats.capacity = sd_.totalBytes();
+    stats.used = sd_.usedBytes();
+    stats.available = stats.capacity - stats.used;
+    return stats;
   }
   virtual vfs::Path MountPoint() override final { return sd_.mountpoint(); }
   virtual vfs::Path TempDir() override final { return MountPoint() / "tmp"; }
-  virtual bool Exists(const vfs::Path &path) const override final {
-    return stdfs::exists(path.native());
+  virtual bool Exists(vfs::PathView path) const override final {
+    std::error_code ec;
+    return stdfs::exists(stdfs::path(path), ec);
+  }
+  virtual bool List(const vfs::Path &dir,
+                    std::vector<vfs::DirEntry> &entries) override final {
+    entries.clear();
+    std::error_code ec;
+    for (stdfs::directory_iterator it(dir.native(), ec), end; !ec && it != end;
+         it.increment(ec)) {
+      entries.push_back({it->path().filename(), it->is_directory(ec)});
+    }
+    return !ec;
   }
 
   virtual bool CreateDirs(const vfs::Path &path) override final {
@@ -62,24 +126,75 @@ public:
   virtual bool Remove(const vfs::Path &path) override final {
     return stdfs::remove(path.native());
   }
-  virtual bool RemoveAll(const vfs::Path &path) override final {
-    WalkWithCB(path.native(), [](stdfs::path p) { stdfs::remove(p); });
-    return Remove(path);
+  virtual bool RemoveAll(const vfs::Path &path,
+                         const vfs::RemoveProgress &progress) override final {
+    return vfs::RemoveTree(path.native(), progress);
+  }
+  virtual bool Rename(const vfs::Path &from,
+                      const vfs::Path &to) override final {
+    // FAT will not rename over an existing file, so there is a moment where
+    // `to` is missing. AtomicBatch's manifest covers it.
+    std::error_code ec;
+    if (stdfs::exists(to.native(), ec)) {
+      stdfs::remove(to.native(), ec);
+    }
+    stdfs::rename(from.native(), to.native(), ec);
+    return !ec;
+  }
+
+  // FATFS has no cache beyond the open files; closing a file commits it.
+  virtual bool Sync() override final { return true; }
+
+  virtual std::unique_ptr<vfs::RawFile>
+  Open(vfs::PathView path, vfs::OpenMode mode) override final {
+    auto card_path = CardPath(path);
+    if (card_path.empty()) {
+      return nullptr;
+    }
+
+    ardfs::File file;
+    switch (mode) {
+    case vfs::OpenMode::kREAD:
+      file = sd_.open(card_path.c_str(), FILE_READ);
+      break;
+    case vfs::OpenMode::kTRUNCATE:
+      // Opened for update so that File can read back what it wrote.
+      file = sd_.open(card_path.c_str(), "w+");
+      break;
+    case vfs::OpenMode::kAPPEND:
+      // Not "a+": File positions every write itself.
+      file = sd_.open(card_path.c_str(),
+                      sd_.exists(card_path.c_str()) ? "r+" : "w+");
+      break;
+    }
+
+    if (!file || file.isDirectory()) {
+      return nullptr;
+    }
+    return std::make_unique<RawFileImpl>(file);
+  }
+
+  // Only flash partitions can be memory mapped on the ESP32, so MappedFile
+  // falls back to paged reads.
+  virtual std::unique_ptr<vfs::RawMapping>
+  MapFile(const vfs::Path &path) override final {
+    return nullptr;
   }
 
 private:
   SPIClass spi_;
   ardfs::SDFS &sd_;
 
-  void WalkWithCB(stdfs::path p, std::function<void(stdfs::path)> cb) {
-    for (const auto &entry : stdfs::directory_iterator(p)) {
-      if (entry.is_directory()) {
-        WalkWithCB(entry.path(), cb);
-      } else {
-        cb(entry.path());
-      }
-      cb(entry.path());
+  // fs::FS paths are relative to the mount point. Returns an empty path for
+  // paths outside of it. Built on the stack, as fs::FS wants a C string.
+  vfs::PathBuf<> CardPath(vfs::PathView path) {
+    auto p = path.native();
+    std::string_view mp = sd_.mountpoint();
+    if (p.compare(0, mp.size(), mp) != 0 || p.size() <= mp.size() ||
+        p[mp.size()] != '/') {
+      return vfs::PathBuf<>();
     }
+    return vfs::PathBuf<>(p.substr(mp.size()));
   }
 };
 } // namespace
@@ -7,18 +7,100 @@
 // Local Headers
 #include "cdfw/compat/arduino.h"
 #include "cdfw/core/vfs.h"
+#include "cdfw/core/vfs_tree.h"
 #include "cdfw/hal/sd.h"
 
+// C Standard Library Headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 // C++ Standard Library Headers
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <system_error>
+#include <vector>
 
 namespace cdfw {
 namespace hal {
 namespace {
 namespace stdfs = std::filesystem;
 
+// POSIX file descriptor; reads and writes go straight between the caller's
+// memory and the kernel.
+class RawFileImpl : public vfs::RawFile {
+public:
+  RawFileImpl(int fd) : fd_(fd) {}
+  virtual ~RawFileImpl() { ::close(fd_); }
+
+  virtual std::size_t ReadAt(std::uint64_t offset,
+                             ByteSpan buf) override final {
+    std::size_t done = 0;
+    while (done < buf.size()) {
+      auto n = ::pread(fd_, buf.data() + done, buf.size() - done,
+                       static_cast<off_t>(offset + done));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      } else if (n <= 0) {
+        break;
+      }
+      done += static_cast<std::size_t>(n);
+    }
+    return done;
+  }
+
+  virtual std::size_t WriteAt(std::uint64_t offset,
+                              ConstByteSpan data) override final {
+    std::size_t done = 0;
+    while (done < data.size()) {
+      auto n = ::pwrite(fd_, data.data() + done, data.size() - done,
+                        static_cast<off_t>(offset + done));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      } else if (n <= 0) {
+        break;
+      }
+      done += static_cast<std::size_t>(n);
+    }
+    return done;
+  }
+
+  virtual std::uint64_t Size() override final {
+    struct stat st;
+    return ::fstat(fd_, &st) == 0 ? static_cast<std::uint64_t>(st.st_size)
+                                  : 0;
+  }
+
+  virtual bool Sync() override final { return ::fsync(fd_) == 0; }
+
+private:
+  int fd_;
+};
+
+// Read-only mmap(2) of a whole file. Empty files are not mapped.
+class RawMappingImpl : public vfs::RawMapping {
+public:
+  RawMappingImpl(void *addr, std::size_t size) : addr_(addr), size_(size) {}
+  virtual ~RawMappingImpl() {
+    if (size_ > 0) {
+      ::munmap(addr_, size_);
+    }
+  }
+
+  virtual ConstByteSpan Data() override final {
+    return ConstByteSpan(static_cast<const std::uint8_t *>(addr_), size_);
+  }
+
+private:
+  void *addr_;
+  std::size_t size_;
+};
+
 class SDImpl : public hal::SD {
 public:
   SDImpl() = default;
@@ -38,10 +120,29 @@ public:
   virtual std::uint64_t Used() override final {
     return Capacity() - Available();
   }
+  virtual vfs::VolumeStats Stats() override final {
+    auto space = stdfs::space(mp_dir_);
+    vfs::VolumeStats stats;
+    stats.capacity = space.capacity;
+    stats.available = space.available;
+    stats.used = space.capacity - space.available;
+    return stats;
+  }
   virtual vfs::Path MountPoint() override final { return mp_dir_.string(); }
   virtual vfs::Path TempDir() override final { return MountPoint() / "tmp"; }
-  virtual bool Exists(const vfs::Path &path) const override final {
-    return stdfs::exists(path.native());
+  virtual bool Exists(vfs::PathView path) const override final {
+    std::error_code ec;
+    return stdfs::exists(stdfs::path(path), ec);
+  }
+  virtual bool List(const vfs::Path &dir,
+                    std::vector<vfs::DirEntry> &entries) override final {
+    entries.clear();
+    std::error_code ec;
+    for (stdfs::directory_iterator it(dir.native(), ec), end; !ec && it != end;
+         it.increment(ec)) {
+      entries.push_back({it->path().filename(), it->is_directory(ec)});
+    }
+    return !ec;
   }
 
   virtual bool CreateDirs(const vfs::Path &path) override final {
@@ -50,8 +151,66 @@ public:
   virtual bool Remove(const vfs::Path &path) override final {
     return stdfs::remove(path.native());
   }
-  virtual bool RemoveAll(const vfs::Path &path) override final {
-    return stdfs::remove_all(path.native());
+  virtual bool RemoveAll(const vfs::Path &path,
+                         const vfs::RemoveProgress &progress) override final {
+    return vfs::RemoveTree(path.native(), progress);
+  }
+  virtual bool Rename(const vfs::Path &from,
+                      const vfs::Path &to) override final {
+    // rename(2) replaces `to` atomically.
+    std::error_code ec;
+    stdfs::rename(from.native(), to.native(), ec);
+    return !ec;
+  }
+
+  virtual bool Sync() override final {
+    ::sync();
+    return true;
+  }
+
+  virtual std::unique_ptr<vfs::RawFile>
+  Open(vfs::PathView path, vfs::OpenMode mode) override final {
+    int flags = O_CLOEXEC;
+    switch (mode) {
+    case vfs::OpenMode::kREAD:
+      flags |= O_RDONLY;
+      break;
+    case vfs::OpenMode::kTRUNCATE:
+      flags |= O_RDWR | O_CREAT | O_TRUNC;
+      break;
+    case vfs::OpenMode::kAPPEND:
+      // Not O_APPEND: File positions every write itself.
+      flags |= O_RDWR | O_CREAT;
+      break;
+    }
+
+    int fd = ::open(stdfs::path(path).c_str(), flags, 0644);
+    if (fd < 0) {
+      return nullptr;
+    }
+    return std::make_unique<RawFileImpl>(fd);
+  }
+
+  virtual std::unique_ptr<vfs::RawMapping>
+  MapFile(const vfs::Path &path) override final {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    // The mapping outlives the descriptor.
+    struct stat st;
+    void *addr = nullptr;
+    std::size_t size = 0;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      size = static_cast<std::size_t>(st.st_size);
+      addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::make_unique<RawMappingImpl>(addr, size);
   }
 
 private:
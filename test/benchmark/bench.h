@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_TEST_BENCHMARK_BENCH_H
+#define CDFW_TEST_BENCHMARK_BENCH_H
+
+// Minimal micro-benchmark harness for the native build, on top of googletest.
+//
+// Each measurement runs the operation in batches of growing size until a
+// batch takes at least kMinBatchTime, then reports the cost of one operation
+// from that batch, along with the rates it implies (operations and megabytes
+// per second). Results are printed as one JSON object per line, prefixed
+// with "BENCH ", and recorded as test properties so that they also appear in
+// googletest's XML/JSON output. Allocations are counted with the runner's
+// allocation tracker.
+
+// Local Headers
+#include "test/support/alloc_tracker.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace cdfw {
+namespace bench {
+constexpr std::chrono::milliseconds kMinBatchTime(100);
+constexpr std::size_t kMaxIterations = 1 << 24;
+
+struct Result {
+  std::string name;
+  std::size_t iterations;
+  double ns_per_op;
+  double bytes_per_op;
+  double allocs_per_op;
+};
+
+// Keeps the compiler from discarding a value that is otherwise unused.
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Measures `fn`, which processes `bytes_per_op` bytes per call.
+template <typename Fn>
+Result Run(const std::string &name, std::size_t bytes_per_op, Fn &&fn) {
+  typedef std::chrono::steady_clock Clock;
+
+  // Warm up lazily built state (filters, arenas, string capacity).
+  fn();
+
+  for (std::size_t iterations = 1;; iterations *= 2) {
+    test::AllocationCounter counter;
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+      fn();
+    }
+    auto elapsed = Clock::now() - start;
+    std::size_t allocs = counter.Allocations();
+
+    if (elapsed >= kMinBatchTime || iterations >= kMaxIterations) {
+      double ns =
+          std::chrono::duration<double, std::nano>(elapsed).count();
+      return Result{name, iterations, ns / iterations,
+                    static_cast<double>(bytes_per_op),
+                    static_cast<double>(allocs) / iterations};
+    }
+  }
+}
+
+// Like Run(), but calls `setup` before every call to `fn`, outside of the
+// timing and the allocation count. For operations that use up their input,
+// e.g. removing a tree that `setup` built.
+template <typename Setup, typename Fn>
+Result RunWithSetup(const std::string &name, std::size_t bytes_per_op,
+                    Setup &&setup, Fn &&fn) {
+  typedef std::chrono::steady_clock Clock;
+
+  setup();
+  fn();
+
+  for (std::size_t iterations = 1;; iterations *= 2) {
+    Clock::duration elapsed = Clock::duration::zero();
+    std::size_t allocs = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+      setup();
+      test::AllocationCounter counter;
+      auto start = Clock::now();
+      fn();
+      elapsed += Clock::now() - start;
+      allocs += counter.Allocations();
+    }
+
+    if (elapsed >= kMinBatchTime || iterations >= kMaxIterations) {
+      double ns =
+          std::chrono::duration<double, std::nano>(elapsed).count();
+      return Result{name, iterations, ns / iterations,
+                    static_cast<double>(bytes_per_op),
+                    static_cast<double>(allocs) / iterations};
+    }
+  }
+}
+
+inline double OpsPerSecond(const Result &result) {
+  return result.ns_per_op > 0 ? 1e9 / result.ns_per_op : 0;
+}
+
+// Decimal megabytes, as storage is rated.
+inline double MegabytesPerSecond(const Result &result) {
+  return OpsPerSecond(result) * result.bytes_per_op / 1e6;
+}
+
+// Prints the result as a JSON line and records it on the current test.
+inline void Report(const Result &result) {
+  std::printf("BENCH {\"name\":\"%s\",\"iterations\":%zu,\"ns_per_op\":%.1f,"
+              "\"bytes_per_op\":%.1f,\"allocs_per_op\":%.2f,"
+              "\"ops_per_s\":%.1f,\"mb_per_s\":%.2f}\n",
+              result.name.c_str(), result.iterations, result.ns_per_op,
+              result.bytes_per_op, result.allocs_per_op, OpsPerSecond(result),
+              MegabytesPerSecond(result));
+  std::fflush(stdout);
+
+  ::testing::Test::RecordProperty(result.name + ".ns_per_op",
+                                  std::to_string(result.ns_per_op));
+  ::testing::Test::RecordProperty(result.name + ".bytes_per_op",
+                                  std::to_string(result.bytes_per_op));
+  ::testing::Test::RecordProperty(result.name + ".allocs_per_op",
+                                  std::to_string(result.allocs_per_op));
+  ::testing::Test::RecordProperty(result.name + ".ops_per_s",
+                                  std::to_string(OpsPerSecond(result)));
+  ::testing::Test::RecordProperty(result.name + ".mb_per_s",
+                                  std::to_string(MegabytesPerSecond(result)));
+}
+
+template <typename Fn>
+Result RunAndReport(const std::string &name, std::size_t bytes_per_op,
+                    Fn &&fn) {
+  Result result = Run(name, bytes_per_op, fn);
+  Report(result);
+  return result;
+}
+
+template <typename Setup, typename Fn>
+Result RunWithSetupAndReport(const std::string &name, std::size_t bytes_per_op,
+                             Setup &&setup, Fn &&fn) {
+  Result result = RunWithSetup(name, bytes_per_op, setup, fn);
+  Report(result);
+  return result;
+}
+} // namespace bench
+} // namespace cdfw
+
+#endif // CDFW_TEST_BENCHMARK_BENCH_H
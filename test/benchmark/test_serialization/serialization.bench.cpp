@@ -0,0 +1,235 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Cost of the station and routine codecs. Run with `pio test -e macos-bench`;
+// results are printed as "BENCH {...}" JSON lines.
+
+// Local Headers
+#include "cdfw/core/json_arena.h"
+#include "cdfw/core/routine.h"
+#include "cdfw/core/station.h"
+#include "test/benchmark/bench.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace cdfw {
+namespace {
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+const std::size_t kNameLengths[] = {4, 16, kMaxConfigNameLength};
+const std::size_t kLibrarySizes[] = {1, 10, 100, 500};
+
+// Output stream that discards its input, so that writing costs nothing and
+// allocates nothing.
+class NullBuf : public std::streambuf {
+protected:
+  int overflow(int c) override { return traits_type::not_eof(c); }
+  std::streamsize xsputn(const char *, std::streamsize n) override {
+    return n;
+  }
+};
+
+// Input stream over a string that can be rewound without copying.
+class StringBuf : public std::streambuf {
+public:
+  explicit StringBuf(const std::string &str) : str_(str) { Rewind(); }
+
+  void Rewind() {
+    char *begin = const_cast<char *>(str_.data());
+    setg(begin, begin, begin + str_.size());
+  }
+
+private:
+  const std::string &str_;
+};
+
+std::string Name(std::size_t length, char c = 'n') {
+  return std::string(length, c);
+}
+
+Routine MakeRoutine(std::size_t name_length) {
+  return Routine::GetConfigured(
+      Name(name_length, 'r'),
+      WetStation::GetConfigured(Name(name_length, 'a'), 120,
+                                WetStation::AgitationLevel::kLOW),
+      WetStation::GetConfigured(Name(name_length, 'b'), 60,
+                                WetStation::AgitationLevel::kMEDIUM),
+      WetStation::GetConfigured(Name(name_length, 'c'), 60,
+                                WetStation::AgitationLevel::kMEDIUM),
+      WetStation::GetConfigured(Name(name_length, 'd'), 60,
+                                WetStation::AgitationLevel::kHIGH),
+      DryStation::GetConfigured(Name(name_length, 'e'), 300,
+                                DryStation::SpinType::kBIDIRECTIONAL));
+}
+
+std::string Suffix(const char *key, std::size_t value) {
+  return std::string("/") + key + "=" + std::to_string(value);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+TEST(SerializationBenchmarks, WetStation) {
+  auto serializer = StationSerializer::Create();
+  RoutineError error{};
+  for (std::size_t length : kNameLengths) {
+    WetStation station = WetStation::GetConfigured(
+        Name(length), 120, WetStation::AgitationLevel::kMEDIUM);
+    std::string json = serializer->Serialize(station);
+    std::string suffix = Suffix("name", length);
+
+    bench::RunAndReport("wet_station/serialize" + suffix, json.size(), [&] {
+      bench::DoNotOptimize(serializer->Serialize(station));
+    });
+    bench::RunAndReport("wet_station/deserialize" + suffix, json.size(), [&] {
+      bench::DoNotOptimize(serializer->DeserializeWet(json, error));
+    });
+  }
+}
+
+TEST(SerializationBenchmarks, DryStation) {
+  auto serializer = StationSerializer::Create();
+  RoutineError error{};
+  for (std::size_t length : kNameLengths) {
+    DryStation station = DryStation::GetConfigured(
+        Name(length), 300, DryStation::SpinType::kUNIDIRECTIONAL);
+    std::string json = serializer->Serialize(station);
+    std::string suffix = Suffix("name", length);
+
+    bench::RunAndReport("dry_station/serialize" + suffix, json.size(), [&] {
+      bench::DoNotOptimize(serializer->Serialize(station));
+    });
+    bench::RunAndReport("dry_station/deserialize" + suffix, json.size(), [&] {
+      bench::DoNotOptimize(serializer->DeserializeDry(json, error));
+    });
+  }
+}
+
+TEST(SerializationBenchmarks, Routine) {
+  struct Codec {
+    const char *name;
+    std::shared_ptr<RoutineSerializer> serializer;
+  };
+  Codec codecs[] = {
+      {"json", RoutineSerializer::Create(RoutineSerializer::Format::kJSON)},
+      {"json_arena",
+       RoutineSerializer::Create(
+           RoutineSerializer::Format::kJSON,
+           std::make_shared<StaticJsonArena<RoutineJsonCodec::kArenaSize>>())},
+      {"binary",
+       RoutineSerializer::Create(RoutineSerializer::Format::kBINARY)},
+  };
+
+  for (const Codec &codec : codecs) {
+    for (std::size_t length : kNameLengths) {
+      Routine routine = MakeRoutine(length);
+      std::string data = codec.serializer->Serialize(routine);
+      std::string prefix = std::string("routine/") + codec.name;
+      std::string suffix = Suffix("name", length);
+
+      bench::RunAndReport(prefix + "/serialize" + suffix, data.size(), [&] {
+        bench::DoNotOptimize(codec.serializer->Serialize(routine));
+      });
+      bench::RunAndReport(prefix + "/deserialize" + suffix, data.size(), [&] {
+        bench::DoNotOptimize(codec.serializer->Deserialize(data));
+      });
+
+      StringBuf buf(data);
+      std::istream input(&buf);
+      bench::RunAndReport(
+          prefix + "/deserialize_stream" + suffix, data.size(), [&] {
+            buf.Rewind();
+            input.clear();
+            Routine parsed = Routine::GetDisabled();
+            RoutineError error{};
+            codec.serializer->Deserialize(input, parsed, error);
+            bench::DoNotOptimize(parsed);
+          });
+    }
+  }
+}
+
+TEST(SerializationBenchmarks, RoutineJsonCodec) {
+  StaticJsonArena<RoutineJsonCodec::kArenaSize> arena;
+  RoutineJsonCodec codec(arena);
+  for (std::size_t length : kNameLengths) {
+    Routine routine = MakeRoutine(length);
+    char buf[1024];
+    std::size_t size = codec.Write(routine, buf, sizeof(buf));
+    std::string suffix = Suffix("name", length);
+
+    bench::RunAndReport("routine/codec/write" + suffix, size, [&] {
+      bench::DoNotOptimize(codec.Write(routine, buf, sizeof(buf)));
+    });
+    bench::RunAndReport("routine/codec/read" + suffix, size, [&] {
+      Routine parsed = Routine::GetDisabled();
+      RoutineError error{};
+      codec.Read(parsed, error, static_cast<const char *>(buf), size);
+      bench::DoNotOptimize(parsed);
+    });
+  }
+}
+
+TEST(SerializationBenchmarks, Library) {
+  struct Batch {
+    const char *name;
+    RoutineSerializer::Format format;
+    RoutineSerializer::Layout layout;
+  };
+  const Batch batches[] = {
+      {"json_array", RoutineSerializer::Format::kJSON,
+       RoutineSerializer::Layout::kARRAY},
+      {"ndjson", RoutineSerializer::Format::kJSON,
+       RoutineSerializer::Layout::kNDJSON},
+      {"binary", RoutineSerializer::Format::kBINARY,
+       RoutineSerializer::Layout::kARRAY},
+  };
+
+  for (const Batch &batch : batches) {
+    auto serializer = RoutineSerializer::Create(batch.format);
+    for (std::size_t size : kLibrarySizes) {
+      std::vector<Routine> library(size, MakeRoutine(16));
+      std::ostringstream encoded;
+      serializer->SerializeMany(library, batch.layout, encoded);
+      std::string data = encoded.str();
+      std::string prefix = std::string("library/") + batch.name;
+      std::string suffix = Suffix("routines", size);
+
+      NullBuf null_buf;
+      std::ostream output(&null_buf);
+      bench::RunAndReport(prefix + "/serialize" + suffix, data.size(), [&] {
+        bench::DoNotOptimize(
+            serializer->SerializeMany(library, batch.layout, output));
+      });
+
+      StringBuf buf(data);
+      std::istream input(&buf);
+      std::size_t read = 0;
+      auto on_routine = [&](std::size_t, const Routine &) { ++read; };
+      bench::RunAndReport(prefix + "/deserialize" + suffix, data.size(), [&] {
+        buf.Rewind();
+        input.clear();
+        bench::DoNotOptimize(serializer->DeserializeMany(
+            input, batch.layout, on_routine, nullptr));
+      });
+      EXPECT_GT(read, 0);
+    }
+  }
+}
+} // namespace
+} // namespace cdfw
@@ -0,0 +1,218 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Throughput of the storage stack, on every volume backend. Run with
+// `pio test -e macos-bench`; results are printed as "BENCH {...}" JSON lines
+// with their ops/s and MB/s.
+//
+// On the native build the SD backend is the host file system under its page
+// cache, so its numbers are an upper bound. Flashed to the CYD it measures the
+// card itself; build with -DCDFW_SD_SPI_FREQUENCY=... to compare SPI clocks.
+//
+// Backends are used without the metadata cache of Volume::Create(), so that
+// listings and removals reach the storage.
+
+// Local Headers
+#include "cdfw/core/ram_volume.h"
+#include "cdfw/core/span.h"
+#include "cdfw/core/vfs.h"
+#include "cdfw/hal/sd.h"
+#include "test/benchmark/bench.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cdfw {
+namespace {
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+#ifdef CDFW_NATIVE
+constexpr std::size_t kFileSize = 1024 * 1024;
+#else
+// Leaves room in the CYD's heap for the RAM volume's copy of the file.
+constexpr std::size_t kFileSize = 64 * 1024;
+#endif
+
+// Bytes per File::Read/Write call, and the File buffer in front of them (0 is
+// unbuffered). Together they show what a buffer buys at each transfer size.
+const std::size_t kBlockSizes[] = {64, 512, 4096, 32768};
+const std::size_t kBufferSizes[] = {0, 512, 4096};
+
+constexpr std::size_t kSmallFileSize = 64;
+const std::size_t kDirSizes[] = {16, 128};
+constexpr std::size_t kTreeDirs = 4;
+constexpr std::size_t kTreeFilesPerDir = 16;
+
+struct Backend {
+  const char *name;
+  std::function<std::unique_ptr<vfs::Volume>()> create;
+};
+
+class StorageBenchmarks : public ::testing::TestWithParam<Backend> {
+protected:
+  std::unique_ptr<vfs::Volume> volume = nullptr;
+  vfs::Path dir;
+
+  void SetUp() override final {
+    volume = GetParam().create();
+    dir = volume->TempDir() / "bench";
+    if (volume->Exists(dir)) {
+      volume->RemoveAll(dir);
+    }
+    ASSERT_TRUE(volume->CreateDirs(dir));
+  }
+
+  void TearDown() override final { volume->RemoveAll(volume->TempDir()); }
+
+  std::string Prefix(const char *op) const {
+    return std::string("storage/") + GetParam().name + "/" + op;
+  }
+
+  // Writes `size` bytes of `fill` to a new file at `path`.
+  bool WriteFile(const vfs::Path &path, std::size_t size,
+                 std::uint8_t fill = 0xa5) {
+    std::vector<std::uint8_t> data(size, fill);
+    auto file = volume->OpenWrite(path);
+    file.Write(ConstByteSpan(data.data(), data.size()));
+    return file.Close();
+  }
+
+  // Fills `root` with kTreeDirs dirs of kTreeFilesPerDir small files each.
+  bool BuildTree(const vfs::Path &root) {
+    bool ok = true;
+    for (std::size_t d = 0; d < kTreeDirs; ++d) {
+      auto sub = root / ("d" + std::to_string(d));
+      ok &= volume->CreateDirs(sub);
+      for (std::size_t f = 0; f < kTreeFilesPerDir; ++f) {
+        ok &= WriteFile(sub / ("f" + std::to_string(f)), kSmallFileSize);
+      }
+    }
+    return ok;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Backends, StorageBenchmarks,
+    ::testing::Values(
+        Backend{"sd", []() { return hal::SD::Create(); }},
+        Backend{"ram", []() { return vfs::RamVolume::Create(); }}),
+    [](const ::testing::TestParamInfo<Backend> &info) {
+      return info.param.name;
+    });
+
+std::string Suffix(const char *key, std::size_t value) {
+  return std::string("/") + key + "=" + std::to_string(value);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+TEST_P(StorageBenchmarks, SequentialWrite) {
+  auto path = dir / "seq.bin";
+  std::vector<std::uint8_t> data(kFileSize, 0xa5);
+  for (std::size_t buffer_size : kBufferSizes) {
+    std::vector<std::uint8_t> buffer(buffer_size);
+    for (std::size_t block : kBlockSizes) {
+      bool ok = true;
+      bench::RunAndReport(Prefix("write") + Suffix("block", block) +
+                              Suffix("buffer", buffer_size),
+                          kFileSize, [&] {
+                            auto file = volume->OpenWrite(
+                                path, ByteSpan(buffer.data(), buffer.size()));
+                            for (std::size_t offset = 0; offset < kFileSize;
+                                 offset += block) {
+                              file.Write(
+                                  ConstByteSpan(data.data() + offset, block));
+                            }
+                            ok &= file.Close();
+                          });
+      EXPECT_TRUE(ok);
+    }
+  }
+}
+
+TEST_P(StorageBenchmarks, SequentialRead) {
+  auto path = dir / "seq.bin";
+  ASSERT_TRUE(WriteFile(path, kFileSize));
+  std::vector<std::uint8_t> data(kFileSize);
+  for (std::size_t buffer_size : kBufferSizes) {
+    std::vector<std::uint8_t> buffer(buffer_size);
+    for (std::size_t block : kBlockSizes) {
+      std::size_t read = kFileSize;
+      bench::RunAndReport(Prefix("read") + Suffix("block", block) +
+                              Suffix("buffer", buffer_size),
+                          kFileSize, [&] {
+                            auto file = volume->OpenRead(
+                                path, ByteSpan(buffer.data(), buffer.size()));
+                            std::size_t n = 0;
+                            for (std::size_t offset = 0; offset < kFileSize;
+                                 offset += block) {
+                              n += file.Read(
+                                  ByteSpan(data.data() + offset, block));
+                            }
+                            read = std::min(read, n);
+                          });
+      EXPECT_EQ(read, kFileSize);
+    }
+  }
+}
+
+TEST_P(StorageBenchmarks, SmallFiles) {
+  auto path = dir / "small.bin";
+  bool ok = true;
+  bench::RunWithSetupAndReport(
+      Prefix("small_file/create"), kSmallFileSize,
+      [&] { volume->Remove(path); },
+      [&] { ok &= WriteFile(path, kSmallFileSize); });
+  bench::RunWithSetupAndReport(
+      Prefix("small_file/remove"), 0,
+      [&] { ok &= WriteFile(path, kSmallFileSize); },
+      [&] { ok &= volume->Remove(path); });
+  EXPECT_TRUE(ok);
+}
+
+TEST_P(StorageBenchmarks, List) {
+  for (std::size_t size : kDirSizes) {
+    auto list_dir = dir / ("list" + std::to_string(size));
+    ASSERT_TRUE(volume->CreateDirs(list_dir));
+    for (std::size_t i = 0; i < size; ++i) {
+      ASSERT_TRUE(
+          WriteFile(list_dir / ("f" + std::to_string(i)), kSmallFileSize));
+    }
+
+    // ops/s is listings per second; multiply by `entries` for entries/s.
+    std::vector<vfs::DirEntry> entries;
+    bool ok = true;
+    bench::RunAndReport(Prefix("list") + Suffix("entries", size), 0, [&] {
+      ok &= volume->List(list_dir, entries);
+    });
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(entries.size(), size);
+  }
+}
+
+TEST_P(StorageBenchmarks, RemoveAll) {
+  auto root = dir / "tree";
+  bool ok = true;
+  bench::RunWithSetupAndReport(
+      Prefix("remove_all") + Suffix("files", kTreeDirs * kTreeFilesPerDir),
+      0, [&] { ok &= BuildTree(root); },
+      [&] { ok &= volume->RemoveAll(root); });
+  EXPECT_TRUE(ok);
+  EXPECT_FALSE(volume->Exists(root));
+}
+} // namespace
+} // namespace cdfw
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/compat/arduino.h"
+#include "cdfw/core/boot_profiler.h"
+#include "cdfw/core/boot_storage.h"
+#include "cdfw/core/ram_volume.h"
+#include "cdfw/core/routine.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace cdfw {
+namespace {
+// 2024-01-01T00:00:00Z.
+constexpr std::uint32_t kJan1 = 1704067200;
+
+// A well used card: a routine per slot of the routines menu and a year of
+// daily runs spread over them.
+constexpr std::size_t kRoutines = 32;
+constexpr std::size_t kRuns = 4 * 365;
+
+// The most each storage phase of boot may take on the native build. They are
+// about ten times what a sanitized debug build takes, so that a slow CI runner
+// passes but a change in complexity does not.
+struct PhaseBudget {
+  const char *name;
+  std::uint32_t max_us;
+};
+constexpr PhaseBudget kBudgets[] = {
+    {"dirs", 2000},     {"recover", 2000},   {"routines", 2000},
+    {"run_log", 10000}, {"run_stats", 5000},
+};
+
+class BootBudgetTests : public ::testing::Test {
+protected:
+  std::shared_ptr<vfs::Volume> volume = vfs::RamVolume::CreateVolume();
+
+  // Fills the card through the stores, as the firmware would have.
+  void SetUp() override final {
+#if defined(ARDUINO)
+    // The card image does not fit the device's heap, and the budgets are for
+    // the native build.
+    GTEST_SKIP() << "Boot budgets are checked on the native build only.";
+#endif
+    auto seed = BootProfiler::Create([]() { return std::uint32_t{0}; },
+                                     []() { return std::size_t{0}; });
+    auto storage = LoadBootStorage(volume, *seed);
+    Routine routine = Routine::GetDefault();
+    for (std::size_t i = 1; i < kRoutines; ++i) {
+      routine.name = "Routine " + std::to_string(i);
+      ASSERT_NE(storage.routine_store->Put(routine),
+                RoutineStore::kInvalidId);
+    }
+    for (std::size_t i = 0; i < kRuns; ++i) {
+      RunRecord run{};
+      run.routine_id = storage.routine_store->List()[i % kRoutines].id;
+      run.start_time = kJan1 + static_cast<std::uint32_t>(i) * 6 * 60 * 60;
+      run.end_time = run.start_time + 900;
+      ASSERT_TRUE(storage.run_log->Append(run));
+      ASSERT_TRUE(storage.run_stats->Record(run));
+    }
+  }
+};
+
+TEST_F(BootBudgetTests, StoragePhasesWithinBudget) {
+  auto profiler = BootProfiler::Create(
+      []() { return static_cast<std::uint32_t>(micros()); },
+      []() { return std::size_t{0}; });
+  auto storage = LoadBootStorage(volume, *profiler);
+  EXPECT_EQ(storage.routine_store->List().size(), kRoutines);
+  EXPECT_GT(storage.run_log->Count(), 0);
+  EXPECT_EQ(storage.run_stats->Totals().size(), kRoutines);
+
+  profiler->Print();
+  const auto &phases = profiler->Phases();
+  ASSERT_EQ(phases.size(), std::size(kBudgets));
+  for (std::size_t i = 0; i < phases.size(); ++i) {
+    EXPECT_EQ(phases[i].name, kBudgets[i].name);
+    EXPECT_LE(phases[i].duration_us, kBudgets[i].max_us) << kBudgets[i].name;
+  }
+}
+} // namespace
+} // namespace cdfw
@@ -4,17 +4,57 @@
 
 // Local Headers
 #include "cdfw/hal/sd.h"
+#include "cdfw/core/ram_volume.h"
+#include "cdfw/core/vfs_tree.h"
 
 // Third Party Headers
 #include <gtest/gtest.h>
 
 // C++ Standard Library Headers
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace cdfw {
 namespace hal {
 namespace {
+// Every backend must pass VolumeTests. SDTests holds the checks that only make
+// sense for the card.
+struct Backend {
+  const char *name;
+  std::function<std::unique_ptr<vfs::Volume>()> create;
+};
+
+class VolumeTests : public ::testing::TestWithParam<Backend> {
+protected:
+  std::unique_ptr<vfs::Volume> volume = nullptr;
+  vfs::Path tmp_dir;
+
+  void SetUp() override final {
+    volume = GetParam().create();
+    tmp_dir = volume->TempDir();
+  }
+
+  void TearDown() override final {
+    if (volume->Exists(tmp_dir)) {
+      volume->RemoveAll(tmp_dir);
+    }
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Backends, VolumeTests,
+    ::testing::Values(
+        Backend{"SD", []() { return SD::Create(); }},
+        Backend{"Ram", []() { return vfs::RamVolume::Create(); }}),
+    [](const ::testing::TestParamInfo<Backend> &info) {
+      return info.param.name;
+    });
+
 class SDTests : public ::testing::Test {
 protected:
   std::unique_ptr<SD> sd = nullptr;
@@ -34,61 +74,210 @@ protected:
 
 TEST_F(SDTests, Type_SanityCheck) { EXPECT_TRUE(sd->IsSD()); }
 
-TEST_F(SDTests, Size_SanityCheck) {
-  EXPECT_GT(sd->Capacity(), 0);
-  EXPECT_GT(sd->Available(), 0); // Seems safe to assume the SD is not full.
-  EXPECT_GE(sd->Capacity(), sd->Available());
-  EXPECT_GE(sd->Capacity(), sd->Used());
-  EXPECT_TRUE(true);
+TEST_F(SDTests, MountPoint) { EXPECT_EQ(sd->MountPoint().filename(), "sd"); }
+
+TEST_F(SDTests, WalkTree) {
+  sd->CreateDirs(tmp_dir / "a" / "b");
+  EXPECT_TRUE(sd->OpenWrite(tmp_dir / "a" / "b" / "f").Close());
+
+  int entries = 0;
+  std::size_t max_depth = 0;
+  EXPECT_TRUE(vfs::WalkTree(
+      tmp_dir.native(),
+      [&](const std::filesystem::directory_entry &entry, std::size_t depth) {
+        ++entries;
+        max_depth = std::max(max_depth, depth);
+      }));
+  EXPECT_EQ(entries, 3);
+  EXPECT_EQ(max_depth, 2);
+  EXPECT_FALSE(vfs::WalkTree((tmp_dir / "missing").native(),
+                             [](const std::filesystem::directory_entry &,
+                                std::size_t) {}));
 }
 
-TEST_F(SDTests, MountPoint) { EXPECT_EQ(sd->MountPoint().filename(), "sd"); }
+TEST_P(VolumeTests, Size_SanityCheck) {
+  EXPECT_GT(volume->Capacity(), 0);
+  EXPECT_GT(volume->Available(), 0); // Seems safe to assume the SD is not full.
+  EXPECT_GE(volume->Capacity(), volume->Available());
+  EXPECT_GE(volume->Capacity(), volume->Used());
+  EXPECT_TRUE(true);
+}
 
-TEST_F(SDTests, TempDir) { EXPECT_EQ(sd->TempDir().filename(), "tmp"); }
+TEST_P(VolumeTests, TempDir) { EXPECT_EQ(volume->TempDir().filename(), "tmp"); }
 
-TEST_F(SDTests, CreateDirs_And_Exists) {
+TEST_P(VolumeTests, CreateDirs_And_Exists) {
   vfs::Path p_a = tmp_dir / "a";
   vfs::Path p_child = p_a / "child";
   vfs::Path p_b = tmp_dir / "b";
   vfs::Path path_not_exists = tmp_dir / "c";
-  EXPECT_FALSE(sd->Exists(p_a));
-  EXPECT_FALSE(sd->Exists(p_child));
-  EXPECT_FALSE(sd->Exists(p_b));
-  EXPECT_FALSE(sd->Exists(path_not_exists));
-
-  sd->CreateDirs(p_a);
-  sd->CreateDirs(p_child);
-  sd->CreateDirs(p_b);
-  EXPECT_TRUE(sd->Exists(p_a));
-  EXPECT_TRUE(sd->Exists(p_child));
-  EXPECT_TRUE(sd->Exists(p_b));
-  EXPECT_FALSE(sd->Exists(path_not_exists));
+  EXPECT_FALSE(volume->Exists(p_a));
+  EXPECT_FALSE(volume->Exists(p_child));
+  EXPECT_FALSE(volume->Exists(p_b));
+  EXPECT_FALSE(volume->Exists(path_not_exists));
+
+  volume->CreateDirs(p_a);
+  volume->CreateDirs(p_child);
+  volume->CreateDirs(p_b);
+  EXPECT_TRUE(volume->Exists(p_a));
+  EXPECT_TRUE(volume->Exists(p_child));
+  EXPECT_TRUE(volume->Exists(p_b));
+  EXPECT_FALSE(volume->Exists(path_not_exists));
 }
 
-TEST_F(SDTests, Remove) {
+TEST_P(VolumeTests, Remove) {
   vfs::Path p = tmp_dir / "a";
-  sd->CreateDirs(p);
-  EXPECT_TRUE(sd->Exists(p));
+  volume->CreateDirs(p);
+  EXPECT_TRUE(volume->Exists(p));
 
-  sd->Remove(p);
-  EXPECT_FALSE(sd->Exists(p));
+  volume->Remove(p);
+  EXPECT_FALSE(volume->Exists(p));
 }
 
-TEST_F(SDTests, RemoveAll) {
+TEST_P(VolumeTests, RemoveAll) {
   vfs::Path p_a = tmp_dir / "a";
   vfs::Path p_child = p_a / "child";
   vfs::Path p_b = tmp_dir / "b";
-  sd->CreateDirs(p_a);
-  sd->CreateDirs(p_child);
-  sd->CreateDirs(p_b);
-  EXPECT_TRUE(sd->Exists(p_a));
-  EXPECT_TRUE(sd->Exists(p_child));
-  EXPECT_TRUE(sd->Exists(p_b));
-
-  sd->RemoveAll(p_a);
-  EXPECT_FALSE(sd->Exists(p_a));
-  EXPECT_FALSE(sd->Exists(p_child));
-  EXPECT_TRUE(sd->Exists(p_b));
+  volume->CreateDirs(p_a);
+  volume->CreateDirs(p_child);
+  volume->CreateDirs(p_b);
+  EXPECT_TRUE(volume->Exists(p_a));
+  EXPECT_TRUE(volume->Exists(p_child));
+  EXPECT_TRUE(volume->Exists(p_b));
+
+  volume->RemoveAll(p_a);
+  EXPECT_FALSE(volume->Exists(p_a));
+  EXPECT_FALSE(volume->Exists(p_child));
+  EXPECT_TRUE(volume->Exists(p_b));
+}
+
+TEST_P(VolumeTests, RemoveAll_ManyFiles) {
+  vfs::Path p = tmp_dir / "data";
+  for (int d = 0; d < 3; ++d) {
+    auto dir = p / std::to_string(d) / "nested";
+    volume->CreateDirs(dir);
+    for (int f = 0; f < 100; ++f) {
+      EXPECT_TRUE(volume->OpenWrite(dir / std::to_string(f)).Close());
+    }
+  }
+
+  int calls = 0;
+  vfs::RemoveStats last{};
+  EXPECT_TRUE(volume->RemoveAll(p, [&](const vfs::RemoveStats &stats) {
+    ++calls;
+    EXPECT_GE(stats.files + stats.dirs, last.files + last.dirs);
+    last = stats;
+    return true;
+  }));
+  EXPECT_FALSE(volume->Exists(p));
+  EXPECT_EQ(last.files, 300);
+  EXPECT_EQ(last.dirs, 7);
+  EXPECT_GE(calls, 300 / static_cast<int>(vfs::kRemoveBatchSize));
+}
+
+TEST_P(VolumeTests, RemoveAll_Cancelled) {
+  vfs::Path p = tmp_dir / "data";
+  volume->CreateDirs(p);
+  for (int f = 0; f < 100; ++f) {
+    EXPECT_TRUE(volume->OpenWrite(p / std::to_string(f)).Close());
+  }
+
+  EXPECT_FALSE(volume->RemoveAll(
+      p, [](const vfs::RemoveStats &stats) { return false; }));
+  EXPECT_TRUE(volume->Exists(p));
+}
+
+TEST_P(VolumeTests, RemoveAll_DepthCap) {
+  vfs::Path deep = tmp_dir;
+  for (std::size_t i = 0; i <= vfs::kMaxTreeDepth; ++i) {
+    deep /= "d";
+  }
+  volume->CreateDirs(deep);
+  EXPECT_FALSE(volume->RemoveAll(tmp_dir / "d"));
+  EXPECT_TRUE(volume->Exists(deep));
+
+  // The same tree one level shallower is removed.
+  EXPECT_TRUE(volume->Rename(deep, tmp_dir / "leaf"));
+  EXPECT_TRUE(volume->RemoveAll(tmp_dir / "d"));
+  EXPECT_FALSE(volume->Exists(tmp_dir / "d"));
+}
+
+TEST_P(VolumeTests, File_RoundTrip) {
+  volume->CreateDirs(tmp_dir);
+  vfs::Path p = tmp_dir / "file.bin";
+  EXPECT_FALSE(volume->OpenRead(p).IsOpen());
+
+  std::uint8_t buffer[vfs::File::kSectorSize];
+  std::vector<std::uint8_t> bytes(3000);
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<std::uint8_t>(i * 7);
+  }
+  auto file = volume->OpenWrite(p, buffer);
+  ASSERT_TRUE(file.IsOpen());
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), 100)), 100);
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data() + 100, 2900)), 2900);
+  EXPECT_TRUE(file.Sync());
+  EXPECT_TRUE(file.Close());
+  EXPECT_TRUE(volume->Exists(p));
+
+  file = volume->OpenAppend(p, buffer);
+  EXPECT_EQ(file.Position(), bytes.size());
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), 1)), 1);
+  EXPECT_TRUE(file.Close());
+
+  std::vector<std::uint8_t> out(bytes.size() + 1);
+  file = volume->OpenRead(p, buffer);
+  EXPECT_EQ(file.Size(), out.size());
+  EXPECT_EQ(file.Read(ByteSpan(out.data(), 1)), 1);
+  EXPECT_EQ(file.Read(ByteSpan(out.data() + 1, out.size() - 1)),
+            out.size() - 1);
+  bytes.push_back(bytes[0]);
+  EXPECT_EQ(out, bytes);
+}
+
+TEST_P(VolumeTests, WriteAtomic) {
+  volume->CreateDirs(tmp_dir);
+  vfs::Path p = tmp_dir / "file.bin";
+  std::uint8_t old_bytes[] = {1, 2, 3};
+  std::uint8_t new_bytes[] = {4, 5};
+  EXPECT_TRUE(volume->WriteAtomic(p, old_bytes));
+  EXPECT_TRUE(volume->WriteAtomic(p, new_bytes));
+  EXPECT_EQ(volume->RecoverAtomicWrites(), 0);
+
+  std::uint8_t out[4] = {};
+  auto file = volume->OpenRead(p);
+  EXPECT_EQ(file.Read(out), sizeof(new_bytes));
+  EXPECT_EQ(out[0], 4);
+  EXPECT_EQ(out[1], 5);
+}
+
+TEST_P(VolumeTests, Map) {
+  volume->CreateDirs(tmp_dir);
+  vfs::Path p = tmp_dir / "file.bin";
+  std::vector<std::uint8_t> bytes(3000, 7);
+  bytes.back() = 9;
+  EXPECT_TRUE(
+      volume->WriteAtomic(p, ConstByteSpan(bytes.data(), bytes.size())));
+
+  std::uint8_t cache[vfs::File::kSectorSize * 2];
+  auto file = volume->Map(p, cache);
+  ASSERT_TRUE(file.IsOpen());
+  EXPECT_EQ(file.Size(), bytes.size());
+  auto view = file.View(bytes.size() - 1, 10);
+  ASSERT_EQ(view.size(), 1);
+  EXPECT_EQ(view[0], 9);
+}
+
+TEST_P(VolumeTests, List) {
+  volume->CreateDirs(tmp_dir / "a");
+  EXPECT_TRUE(volume->OpenWrite(tmp_dir / "b").Close());
+
+  std::vector<vfs::DirEntry> entries;
+  EXPECT_FALSE(volume->List(tmp_dir / "missing", entries));
+  ASSERT_TRUE(volume->List(tmp_dir, entries));
+  ASSERT_EQ(entries.size(), 2);
+  for (const auto &entry : entries) {
+    EXPECT_EQ(entry.is_dir, entry.name == "a");
+  }
 }
 } // namespace
 } // namespace hal
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_TEST_MOCKS_ROUTINE_STORE_H
+#define CDFW_TEST_MOCKS_ROUTINE_STORE_H
+
+// Local Headers
+#include "cdfw/core/routine_store.h"
+#include "cdfw/core/vfs.h"
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <initializer_list>
+#include <map>
+#include <vector>
+
+namespace cdfw {
+class MockRoutineStoreFiles : public RoutineStoreFiles {
+public:
+  struct Data {
+    std::map<vfs::Path, std::vector<std::uint8_t>> files;
+    std::size_t reads;
+    std::size_t writes;  // Files written.
+    std::size_t commits; // Calls to Write().
+    bool fail_writes;    // Write() changes nothing and returns false.
+
+    Data() { Reset(); }
+
+    void Reset() {
+      files.clear();
+      reads = 0;
+      writes = 0;
+      commits = 0;
+      fail_writes = false;
+    }
+  };
+  Data &data;
+
+  MockRoutineStoreFiles(Data &data) : data(data) {}
+  virtual ~MockRoutineStoreFiles() = default;
+
+  virtual std::size_t Read(vfs::PathView path, std::size_t offset, void *buf,
+                           std::size_t size) override final {
+    ++data.reads;
+    auto it = data.files.find(vfs::Path(path));
+    if (it == data.files.end() || offset > it->second.size()) {
+      return 0;
+    }
+    auto n = std::min(size, it->second.size() - offset);
+    std::memcpy(buf, it->second.data() + offset, n);
+    return n;
+  }
+
+  virtual bool Write(std::initializer_list<Contents> files) override final {
+    ++data.commits;
+    if (data.fail_writes) {
+      return false;
+    }
+    for (const auto &file : files) {
+      ++data.writes;
+      auto &contents = data.files[vfs::Path(file.path)];
+      contents.assign(file.data.begin(), file.data.end());
+    }
+    return true;
+  }
+
+  virtual bool Remove(vfs::PathView path) override final {
+    return data.files.erase(vfs::Path(path)) > 0;
+  }
+
+  virtual std::vector<vfs::Path> List(const vfs::Path &dir) override final {
+    std::vector<vfs::Path> names;
+    for (const auto &file : data.files) {
+      auto p = std::filesystem::path(file.first.native());
+      if (p.parent_path() == dir.native()) {
+        names.push_back(p.filename());
+      }
+    }
+    return names;
+  }
+};
+} // namespace cdfw
+
+#endif // CDFW_TEST_MOCKS_ROUTINE_STORE_H
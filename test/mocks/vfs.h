@@ -9,12 +9,19 @@
 #include "cdfw/core/vfs.h"
 
 // C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace cdfw {
 namespace vfs {
@@ -44,6 +51,25 @@ public:
     std::uint64_t used;
     MockPath mount_point;
     std::set<vfs::Path> paths;
+    // File contents. Every file also has an entry in `paths`.
+    std::map<vfs::Path, std::vector<std::uint8_t>> files;
+    // Whether MapFile() maps files or leaves MappedFile to read pages.
+    bool mappable;
+    // Backend calls made through RawFile. `syncs` also counts Volume::Sync().
+    std::size_t reads;
+    std::size_t writes;
+    std::size_t syncs;
+    std::size_t renames;
+    // Metadata queries that reached the mock.
+    std::size_t exists_calls;
+    std::size_t list_calls;
+    // Space queries that reached the mock through Stats().
+    std::size_t stats_calls;
+    // Volume::Sync() calls that succeed before the rest fail.
+    std::size_t volume_syncs_left;
+    // Called by Remove() before it changes anything, to stand in for another
+    // thread that runs while the backend call is in flight.
+    std::function<void()> on_remove;
 
     Data() { Reset(); }
 
@@ -55,10 +81,82 @@ public:
       paths.clear();
       paths.insert(
           mount_point.native()); // Volume mount point is always present.
+      files.clear();
+      mappable = false;
+      reads = 0;
+      writes = 0;
+      syncs = 0;
+      renames = 0;
+      exists_calls = 0;
+      list_calls = 0;
+      stats_calls = 0;
+      volume_syncs_left = std::numeric_limits<std::size_t>::max();
+      on_remove = nullptr;
     }
   };
+
+  class MockRawFile : public RawFile {
+  public:
+    MockRawFile(Data &data, const vfs::Path &path) : data(data), path(path) {}
+    virtual ~MockRawFile() = default;
+
+    virtual std::size_t ReadAt(std::uint64_t offset,
+                               ByteSpan buf) override final {
+      ++data.reads;
+      auto it = data.files.find(path);
+      if (it == data.files.end() || offset >= it->second.size()) {
+        return 0;
+      }
+      auto n = std::min<std::size_t>(buf.size(), it->second.size() - offset);
+      std::memcpy(buf.data(), it->second.data() + offset, n);
+      return n;
+    }
+
+    virtual std::size_t WriteAt(std::uint64_t offset,
+                                ConstByteSpan data_in) override final {
+      ++data.writes;
+      auto it = data.files.find(path);
+      if (it == data.files.end()) {
+        return 0; // Removed while open.
+      }
+      auto &bytes = it->second;
+      if (bytes.size() < offset + data_in.size()) {
+        bytes.resize(offset + data_in.size());
+      }
+      std::copy(data_in.begin(), data_in.end(), bytes.begin() + offset);
+      return data_in.size();
+    }
+
+    virtual std::uint64_t Size() override final {
+      auto it = data.files.find(path);
+      return it == data.files.end() ? 0 : it->second.size();
+    }
+
+    virtual bool Sync() override final {
+      ++data.syncs;
+      return true;
+    }
+
+  private:
+    Data &data;
+    vfs::Path path;
+  };
+
   Data &data;
 
+  class MockRawMapping : public RawMapping {
+  public:
+    MockRawMapping(const std::vector<std::uint8_t> &bytes) : bytes(bytes) {}
+    virtual ~MockRawMapping() = default;
+
+    virtual ConstByteSpan Data() override final {
+      return ConstByteSpan(bytes.data(), bytes.size());
+    }
+
+  private:
+    const std::vector<std::uint8_t> &bytes;
+  };
+
   MockVolume(Data &data) : data(data) {}
   virtual ~MockVolume() = default;
 
@@ -69,12 +167,17 @@ public:
     return Capacity() - Used();
   }
   virtual std::uint64_t Used() override final { return data.used; }
+  virtual VolumeStats Stats() override final {
+    ++data.stats_calls;
+    return VolumeStats{Capacity(), Available(), Used()};
+  }
 
   virtual vfs::Path MountPoint() override final { return data.mount_point; }
   virtual vfs::Path TempDir() override final {
     return data.mount_point / "tmp";
   }
-  virtual bool Exists(const vfs::Path &path) const override final {
+  virtual bool Exists(PathView path) const override final {
+    ++data.exists_calls;
     for (const auto &p : data.paths) {
       if (p == path) {
         return true;
@@ -83,6 +186,22 @@ public:
     return false;
   }
 
+  virtual bool List(const vfs::Path &dir,
+                    std::vector<DirEntry> &entries) override final {
+    ++data.list_calls;
+    entries.clear();
+    if (!data.paths.count(dir) || data.files.count(dir)) {
+      return false;
+    }
+    for (const auto &p : data.paths) {
+      auto path = stdfs::path(p.native());
+      if (path.parent_path() == dir.native() && !(p == dir)) {
+        entries.push_back({path.filename(), data.files.count(p) == 0});
+      }
+    }
+    return true;
+  }
+
   virtual bool CreateDirs(const vfs::Path &path) override final {
     auto p = stdfs::path(path.native());
     // Starting at the child, walk up the tree to the root.
@@ -95,6 +214,10 @@ public:
   }
 
   virtual bool Remove(const vfs::Path &path) override final {
+    if (data.on_remove) {
+      data.on_remove();
+    }
+    data.files.erase(path);
     // Reverse iterate through the data.paths set so that children are
     // encountered first. If the requested path has children, do not remove.
     for (auto it = data.paths.rbegin(), end = data.paths.rend(); it != end;
@@ -109,18 +232,80 @@ public:
 
     return false;
   }
-  virtual bool RemoveAll(const vfs::Path &path) override final {
+  virtual bool
+  RemoveAll(const vfs::Path &path,
+            const RemoveProgress &progress = nullptr) override final {
     // Loop through the data.paths set; any entry that starts with the given
     // path should be removed from the set.
+    RemoveStats stats{};
     for (auto it = data.paths.begin(), end = data.paths.end(); it != end;) {
       if (it->native().find(path.native()) == 0) {
+        if (data.files.erase(*it)) {
+          ++stats.files;
+        } else {
+          ++stats.dirs;
+        }
         it = data.paths.erase(it);
       } else {
         ++it;
       }
     }
+    return !progress || progress(stats);
+  }
+
+  virtual bool Rename(const vfs::Path &from,
+                      const vfs::Path &to) override final {
+    auto it = data.files.find(from);
+    auto parent = stdfs::path(to.native()).parent_path();
+    if (it == data.files.end() || !Exists(parent)) {
+      return false;
+    }
+    ++data.renames;
+    data.files[to] = std::move(it->second);
+    data.files.erase(from);
+    data.paths.erase(from);
+    data.paths.insert(to);
+    return true;
+  }
+
+  virtual bool Sync() override final {
+    ++data.syncs;
+    if (data.volume_syncs_left == 0) {
+      return false;
+    }
+    --data.volume_syncs_left;
     return true;
   }
+
+  virtual std::unique_ptr<RawMapping>
+  MapFile(const vfs::Path &path) override final {
+    auto it = data.files.find(path);
+    if (!data.mappable || it == data.files.end()) {
+      return nullptr;
+    }
+    return std::make_unique<MockRawMapping>(it->second);
+  }
+
+  virtual std::unique_ptr<RawFile> Open(PathView view,
+                                        OpenMode mode) override final {
+    Path path(view);
+    auto it = data.files.find(path);
+    if (mode == OpenMode::kREAD) {
+      if (it == data.files.end()) {
+        return nullptr;
+      }
+    } else if (it == data.files.end()) {
+      auto parent = stdfs::path(path.native()).parent_path();
+      if (!Exists(parent) || Exists(path)) {
+        return nullptr; // No parent dir, or `path` is a dir.
+      }
+      data.paths.insert(path);
+      data.files[path];
+    } else if (mode == OpenMode::kTRUNCATE) {
+      it->second.clear();
+    }
+    return std::make_unique<MockRawFile>(data, path);
+  }
 };
 } // namespace vfs
 } // namespace cdfw
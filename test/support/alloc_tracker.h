@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+#ifndef CDFW_TEST_SUPPORT_ALLOC_TRACKER_H
+#define CDFW_TEST_SUPPORT_ALLOC_TRACKER_H
+
+// Heap allocation tracking for tests.
+//
+// test/test_runner.cpp replaces the global operator new/delete with versions
+// that count, per thread, every allocation and free. A test opts in by
+// opening an AllocationCounter around the code under test:
+//
+//   AllocationCounter counter;
+//   model->WifiStateChanged();
+//   EXPECT_EQ(counter.Allocations(), 0);
+//
+// Memory obtained with malloc() directly is not seen, except for JSON
+// documents on the general heap: the runner hands them an allocator that
+// counts (see SetHeapAllocator() in cdfw/core/json_arena.h). Counting is only
+// available on the native build; on the device Available() is false and
+// tests should skip their allocation assertions (see SKIP_WITHOUT_ALLOC_
+// TRACKING below).
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+
+namespace cdfw {
+namespace test {
+// Running totals for the calling thread.
+struct AllocationStats {
+  std::size_t allocations;
+  std::size_t frees;
+  std::size_t bytes; // Bytes requested by the allocations.
+};
+
+// Counts the heap activity of the calling thread between construction and
+// each query. Counters may be nested.
+class AllocationCounter {
+public:
+  AllocationCounter();
+  AllocationCounter(const AllocationCounter &) = delete;
+  AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+  // Whether the runner's hooks are installed in this build.
+  static bool Available();
+
+  // Totals for the calling thread since it started.
+  static AllocationStats ThreadTotals();
+
+  std::size_t Allocations() const;
+  std::size_t Frees() const;
+  std::size_t Bytes() const;
+
+  // Restarts counting from now.
+  void Reset();
+
+private:
+  AllocationStats start_;
+};
+} // namespace test
+} // namespace cdfw
+
+// Skips the rest of the current test if allocations cannot be counted.
+#define SKIP_WITHOUT_ALLOC_TRACKING()                                          \
+  do {                                                                         \
+    if (!::cdfw::test::AllocationCounter::Available()) {                       \
+      GTEST_SKIP() << "Allocation tracking is not available.";                 \
+    }                                                                          \
+  } while (0)
+
+#endif // CDFW_TEST_SUPPORT_ALLOC_TRACKER_H
@@ -2,11 +2,142 @@
 // Use of this source code is governed by a GPLv3 license that can be found in
 // the LICENSE file.
 
-// Platform-specific testing main entry points.
+// Platform-specific testing main entry points, and the allocation hooks behind
+// test/support/alloc_tracker.h.
+
+// Local Headers
+#include "cdfw/core/json_arena.h"
+#include "test/support/alloc_tracker.h"
 
 // Third Party Headers
 #include <gtest/gtest.h>
 
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// ---------------------------------------------------------------------------
+// Allocation Tracking
+// ---------------------------------------------------------------------------
+
+#if !defined(ARDUINO)
+namespace {
+// Zero-initialized, so touching it never allocates.
+thread_local cdfw::test::AllocationStats thread_stats;
+
+void *CountedAlloc(std::size_t size) noexcept {
+  ++thread_stats.allocations;
+  thread_stats.bytes += size;
+  return std::malloc(size ? size : 1);
+}
+
+void CountedFree(void *ptr) noexcept {
+  if (ptr != nullptr) {
+    ++thread_stats.frees;
+    std::free(ptr);
+  }
+}
+
+// Stands in for the general-heap allocator of JSON documents, which calls
+// malloc() directly. A realloc() that moves the block counts as a new
+// allocation and a free.
+class CountedJsonAllocator : public ArduinoJson::Allocator {
+public:
+  void *allocate(std::size_t size) override {
+    ++thread_stats.allocations;
+    thread_stats.bytes += size;
+    return std::malloc(size);
+  }
+
+  void deallocate(void *ptr) override {
+    if (ptr != nullptr) {
+      ++thread_stats.frees;
+    }
+    std::free(ptr);
+  }
+
+  void *reallocate(void *ptr, std::size_t new_size) override {
+    if (ptr == nullptr) {
+      return allocate(new_size);
+    }
+    const auto old_addr = reinterpret_cast<std::uintptr_t>(ptr);
+    void *moved = std::realloc(ptr, new_size);
+    if (moved != nullptr &&
+        reinterpret_cast<std::uintptr_t>(moved) != old_addr) {
+      ++thread_stats.allocations;
+      ++thread_stats.frees;
+      thread_stats.bytes += new_size;
+    }
+    return moved;
+  }
+};
+
+CountedJsonAllocator json_allocator;
+} // namespace
+
+void *operator new(std::size_t size) {
+  if (void *ptr = CountedAlloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAlloc(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAlloc(size);
+}
+void operator delete(void *ptr) noexcept { CountedFree(ptr); }
+void operator delete[](void *ptr) noexcept { CountedFree(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { CountedFree(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { CountedFree(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  CountedFree(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  CountedFree(ptr);
+}
+#endif
+
+namespace cdfw {
+namespace test {
+AllocationCounter::AllocationCounter() { Reset(); }
+
+bool AllocationCounter::Available() {
+#if !defined(ARDUINO)
+  return true;
+#else
+  return false;
+#endif
+}
+
+AllocationStats AllocationCounter::ThreadTotals() {
+#if !defined(ARDUINO)
+  return thread_stats;
+#else
+  return AllocationStats{0, 0, 0};
+#endif
+}
+
+std::size_t AllocationCounter::Allocations() const {
+  return ThreadTotals().allocations - start_.allocations;
+}
+
+std::size_t AllocationCounter::Frees() const {
+  return ThreadTotals().frees - start_.frees;
+}
+
+std::size_t AllocationCounter::Bytes() const {
+  return ThreadTotals().bytes - start_.bytes;
+}
+
+void AllocationCounter::Reset() { start_ = ThreadTotals(); }
+} // namespace test
+} // namespace cdfw
+
 #if defined(ARDUINO)
 #include <Arduino.h>
 
@@ -32,6 +163,7 @@ void loop() {
 #else
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
+  cdfw::SetHeapAllocator(&json_allocator);
   // if you plan to use GMock, replace the line above with
   // ::testing::InitGoogleMock(&argc, argv);
 
@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/boot_profiler.h"
+#include "test/mocks/vfs.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cdfw {
+namespace {
+class BootProfilerTests : public ::testing::Test {
+protected:
+  std::uint32_t now_us = 5000;
+  std::size_t heap = 1000;
+  std::unique_ptr<BootProfiler> profiler = BootProfiler::Create(
+      [this]() { return now_us; }, [this]() { return heap; });
+
+  vfs::MockVolume::Data data;
+  std::shared_ptr<vfs::Volume> volume =
+      std::make_shared<vfs::MockVolume>(data);
+  vfs::Path path = "/mp/boot.bin";
+
+  void SetUp() override final { volume->CreateDirs("/mp"); }
+
+  // Three phases over 600 us.
+  void Boot() {
+    profiler->Begin("lvgl");
+    now_us += 100;
+    heap += 400;
+    profiler->Begin("sd_mount");
+    now_us += 200;
+    heap -= 50;
+    profiler->Begin("routines");
+    now_us += 300;
+    profiler->End();
+  }
+};
+
+TEST_F(BootProfilerTests, Phases) {
+  Boot();
+  const auto &phases = profiler->Phases();
+  ASSERT_EQ(phases.size(), 3);
+  EXPECT_EQ(phases[0].name, "lvgl");
+  EXPECT_EQ(phases[0].start_us, 0);
+  EXPECT_EQ(phases[0].duration_us, 100);
+  EXPECT_EQ(phases[0].heap_delta, 400);
+  EXPECT_EQ(phases[1].name, "sd_mount");
+  EXPECT_EQ(phases[1].start_us, 100);
+  EXPECT_EQ(phases[1].duration_us, 200);
+  EXPECT_EQ(phases[1].heap_delta, -50);
+  EXPECT_EQ(phases[2].start_us, 300);
+  EXPECT_EQ(phases[2].duration_us, 300);
+  EXPECT_EQ(profiler->TotalUs(), 600);
+}
+
+TEST_F(BootProfilerTests, Phases_TimedFromCreation) {
+  now_us += 250;
+  Boot();
+  EXPECT_EQ(profiler->OriginUs(), 5000);
+  EXPECT_EQ(profiler->Phases()[0].start_us, 250);
+  EXPECT_EQ(profiler->TotalUs(), 850);
+}
+
+TEST_F(BootProfilerTests, Mark) {
+  profiler->Begin("lvgl");
+  now_us += 100;
+  EXPECT_EQ(profiler->Mark("first_pixel"), 100);
+  now_us += 50;
+  profiler->End();
+
+  // The mark started after the phase it fell in.
+  const auto &phases = profiler->Phases();
+  ASSERT_EQ(phases.size(), 2);
+  EXPECT_EQ(phases[0].name, "lvgl");
+  EXPECT_EQ(phases[0].duration_us, 150);
+  EXPECT_EQ(phases[1].name, "first_pixel");
+  EXPECT_EQ(phases[1].start_us, 100);
+  EXPECT_EQ(phases[1].duration_us, 0);
+}
+
+TEST_F(BootProfilerTests, Merge) {
+  now_us += 10;
+  auto worker = BootProfiler::Create([this]() { return now_us; },
+                                     [this]() { return heap; });
+  worker->Begin("storage");
+  Boot();
+  worker->End();
+  profiler->Merge(*worker);
+
+  // The phases of both are in start order, on the same timeline.
+  const auto &phases = profiler->Phases();
+  ASSERT_EQ(phases.size(), 4);
+  EXPECT_EQ(phases[0].name, "lvgl");
+  EXPECT_EQ(phases[1].name, "storage");
+  EXPECT_EQ(phases[1].start_us, 10);
+  EXPECT_EQ(phases[1].duration_us, 600);
+  EXPECT_EQ(phases[2].name, "sd_mount");
+  EXPECT_EQ(profiler->TotalUs(), 610);
+}
+
+TEST_F(BootProfilerTests, Begin_CutsLongNames) {
+  profiler->Begin("a_very_long_phase_name");
+  profiler->End();
+  EXPECT_EQ(profiler->Phases()[0].name, "a_very_long");
+}
+
+TEST_F(BootProfilerTests, Begin_FoldsPhasesPastTheLimit) {
+  for (std::size_t i = 0; i < BootProfiler::kMaxPhases + 4; ++i) {
+    profiler->Begin(std::to_string(i).c_str());
+    now_us += 10;
+  }
+  profiler->End();
+  ASSERT_EQ(profiler->Phases().size(), BootProfiler::kMaxPhases);
+  EXPECT_EQ(profiler->Phases().back().duration_us, 50);
+  EXPECT_EQ(profiler->TotalUs(), 10 * (BootProfiler::kMaxPhases + 4));
+}
+
+TEST_F(BootProfilerTests, Append_ReadsBack) {
+  Boot();
+  ASSERT_TRUE(profiler->Append(*volume, path, 1704067200));
+  ASSERT_TRUE(profiler->Append(*volume, path, 1704067260));
+  EXPECT_EQ(data.files[path].size(), 2 * (16 + 3 * 24 + 4));
+
+  auto reports = ReadBootReports(*volume, path);
+  ASSERT_EQ(reports.size(), 2);
+  EXPECT_EQ(reports[0].wall_time, 1704067200);
+  EXPECT_EQ(reports[1].wall_time, 1704067260);
+  EXPECT_EQ(reports[1].total_us, 600);
+  ASSERT_EQ(reports[1].phases.size(), 3);
+  EXPECT_EQ(reports[1].phases[1].name, "sd_mount");
+  EXPECT_EQ(reports[1].phases[1].start_us, 100);
+  EXPECT_EQ(reports[1].phases[1].duration_us, 200);
+  EXPECT_EQ(reports[1].phases[1].heap_delta, -50);
+}
+
+TEST_F(BootProfilerTests, ReadBootReports_SkipsTornRecords) {
+  Boot();
+  ASSERT_TRUE(profiler->Append(*volume, path, 1));
+  ASSERT_TRUE(profiler->Append(*volume, path, 2));
+  ASSERT_TRUE(profiler->Append(*volume, path, 3));
+  data.files[path][92 + 48] ^= 0xff; // Inside the second record's phases.
+
+  auto reports = ReadBootReports(*volume, path);
+  ASSERT_EQ(reports.size(), 2);
+  EXPECT_EQ(reports[0].wall_time, 1);
+  EXPECT_EQ(reports[1].wall_time, 3);
+
+  // A record cut short ends the file.
+  data.files[path].resize(data.files[path].size() - 1);
+  EXPECT_EQ(ReadBootReports(*volume, path).size(), 1);
+}
+
+TEST_F(BootProfilerTests, Append_StartsAfreshWhenFull) {
+  Boot();
+  constexpr std::size_t kRecordSize = 16 + 3 * 24 + 4;
+  const std::size_t fit = BootProfiler::kMaxReportBytes / kRecordSize;
+  for (std::size_t i = 0; i < fit; ++i) {
+    ASSERT_TRUE(profiler->Append(*volume, path, i));
+  }
+  EXPECT_EQ(ReadBootReports(*volume, path).size(), fit);
+
+  ASSERT_TRUE(profiler->Append(*volume, path, fit));
+  auto reports = ReadBootReports(*volume, path);
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_EQ(reports[0].wall_time, fit);
+}
+
+TEST_F(BootProfilerTests, ReadBootReports_Missing) {
+  EXPECT_TRUE(ReadBootReports(*volume, path).empty());
+}
+} // namespace
+} // namespace cdfw
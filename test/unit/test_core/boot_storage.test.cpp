@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/boot_storage.h"
+#include "cdfw/core/boot_profiler.h"
+#include "cdfw/core/dir_layout.h"
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/ram_volume.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace cdfw {
+namespace {
+class BootStorageTests : public ::testing::Test {
+protected:
+  std::shared_ptr<vfs::Volume> volume = vfs::RamVolume::CreateVolume();
+  std::unique_ptr<BootProfiler> profiler =
+      BootProfiler::Create([]() { return std::uint32_t{0}; },
+                           []() { return std::size_t{0}; });
+};
+
+TEST_F(BootStorageTests, LoadBootStorage_FreshCard) {
+  auto storage = LoadBootStorage(volume, *profiler);
+  EXPECT_TRUE(volume->Exists(DirLayout(volume->MountPoint()).data_dir));
+  ASSERT_EQ(storage.routine_store->List().size(), 1);
+  EXPECT_EQ(storage.run_log->Count(), 0);
+  EXPECT_TRUE(storage.run_stats->Totals().empty());
+
+  const auto &phases = profiler->Phases();
+  ASSERT_EQ(phases.size(), 5);
+  EXPECT_EQ(phases[0].name, "dirs");
+  EXPECT_EQ(phases[4].name, "run_stats");
+}
+
+TEST_F(BootStorageTests, SubmitBootStorage_LoadsOnTheWorker) {
+  auto worker = IoWorker::Create();
+  std::thread::id mount_thread;
+  bool ready = false;
+  ASSERT_TRUE(SubmitBootStorage(
+      *worker,
+      [&]() {
+        mount_thread = std::this_thread::get_id();
+        return volume;
+      },
+      *profiler, [&](const BootStorage &storage) {
+        ready = true;
+        EXPECT_EQ(storage.routine_store->List().size(), 1);
+        EXPECT_NE(storage.run_log, nullptr);
+        EXPECT_NE(storage.run_stats, nullptr);
+      }));
+
+  worker->Drain();
+  EXPECT_FALSE(ready);
+  EXPECT_EQ(worker->Poll(), 1);
+  EXPECT_TRUE(ready);
+  EXPECT_NE(mount_thread, std::this_thread::get_id());
+  EXPECT_EQ(profiler->Phases()[0].name, "sd_mount");
+  EXPECT_EQ(profiler->Phases().size(), 6);
+}
+} // namespace
+} // namespace cdfw
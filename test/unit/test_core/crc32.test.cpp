@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/crc32.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <cstring>
+
+namespace cdfw {
+namespace {
+TEST(Crc32Tests, Empty) { EXPECT_EQ(Crc32(nullptr, 0), 0u); }
+
+TEST(Crc32Tests, CheckValue) {
+  // Standard check value for CRC-32/ISO-HDLC.
+  const char *input = "123456789";
+  EXPECT_EQ(Crc32(input, std::strlen(input)), 0xCBF43926u);
+}
+
+TEST(Crc32Tests, Incremental) {
+  const char *input = "123456789";
+  std::uint32_t crc = Crc32(input, 4);
+  crc = Crc32(input + 4, 5, crc);
+  EXPECT_EQ(crc, 0xCBF43926u);
+}
+} // namespace
+} // namespace cdfw
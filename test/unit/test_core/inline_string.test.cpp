@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/inline_string.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace cdfw {
+namespace {
+typedef InlineString<8> String8;
+
+TEST(InlineStringTests, TriviallyCopyable) {
+  EXPECT_TRUE(std::is_trivially_copyable<String8>::value);
+  EXPECT_EQ(sizeof(String8), 9);
+}
+
+TEST(InlineStringTests, Default) {
+  String8 s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.size(), 0);
+  EXPECT_STREQ(s.c_str(), "");
+}
+
+TEST(InlineStringTests, Assign) {
+  String8 s = "abc";
+  EXPECT_EQ(s, "abc");
+  EXPECT_EQ(s.size(), 3);
+
+  s = std::string("defg");
+  EXPECT_EQ(s, std::string("defg"));
+
+  s.assign(static_cast<const char *>(nullptr));
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(InlineStringTests, Truncates) {
+  String8 s = "0123456789";
+  EXPECT_EQ(s, "01234567");
+  EXPECT_EQ(s.size(), String8::kCapacity);
+}
+
+TEST(InlineStringTests, Compare) {
+  String8 a = "abc";
+  String8 b = "abc";
+  String8 c = "abd";
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_NE(a, "ab");
+  EXPECT_EQ("abc", a);
+  EXPECT_EQ(std::string("abc"), a);
+}
+
+TEST(InlineStringTests, Memcpy) {
+  String8 a = "abc";
+  String8 b;
+  std::memcpy(&b, &a, sizeof(a));
+  EXPECT_EQ(b, "abc");
+}
+} // namespace
+} // namespace cdfw
@@ -0,0 +1,164 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/io_worker.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cdfw {
+namespace {
+// Holds the worker inside a job until released, so that tests can fill the
+// queue deterministically.
+class Gate {
+public:
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return open_; });
+  }
+
+  void Open() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = true;
+    }
+    cv_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool open_ = false;
+};
+
+TEST(IoWorkerTests, RunsJobsInOrderOffThread) {
+  auto worker = IoWorker::Create();
+  const auto ui_thread = std::this_thread::get_id();
+  std::vector<int> order;
+  std::vector<int> completed;
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(worker->Submit(
+        [&order, ui_thread, i]() {
+          EXPECT_NE(std::this_thread::get_id(), ui_thread);
+          order.push_back(i);
+          return true;
+        },
+        [&completed, ui_thread, i](bool ok, const IoLatency &) {
+          EXPECT_TRUE(ok);
+          EXPECT_EQ(std::this_thread::get_id(), ui_thread);
+          completed.push_back(i);
+        }));
+  }
+  worker->Drain();
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+
+  // Nothing is delivered until the UI loop polls.
+  EXPECT_TRUE(completed.empty());
+  EXPECT_EQ(worker->Poll(), 4u);
+  EXPECT_EQ(completed, (std::vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(worker->Pending(), 0u);
+}
+
+TEST(IoWorkerTests, ReportsFailure) {
+  auto worker = IoWorker::Create();
+  bool result = true;
+  ASSERT_TRUE(worker->Submit([]() { return false; },
+                             [&result](bool ok, const IoLatency &) {
+                               result = ok;
+                             }));
+  worker->Drain();
+  worker->Poll();
+  EXPECT_FALSE(result);
+}
+
+TEST(IoWorkerTests, QueueIsBounded) {
+  auto worker = IoWorker::Create(2);
+  Gate gate;
+  ASSERT_TRUE(worker->Submit([&gate]() {
+    gate.Wait();
+    return true;
+  }));
+  ASSERT_TRUE(worker->Submit([]() { return true; }));
+  EXPECT_FALSE(worker->Submit([]() { return true; }));
+  gate.Open();
+  worker->Drain();
+
+  // Finished requests hold their slot until their completion has run.
+  EXPECT_FALSE(worker->Submit([]() { return true; }));
+  EXPECT_EQ(worker->Poll(), 2u);
+  EXPECT_TRUE(worker->Submit([]() { return true; }));
+  worker->Drain();
+
+  auto stats = worker->GetStats();
+  EXPECT_EQ(stats.submitted, 3u);
+  EXPECT_EQ(stats.rejected, 2u);
+  EXPECT_EQ(stats.completed, 3u);
+}
+
+TEST(IoWorkerTests, MeasuresLatency) {
+  auto worker = IoWorker::Create();
+  Gate gate;
+  ASSERT_TRUE(worker->Submit([&gate]() {
+    gate.Wait();
+    return true;
+  }));
+  IoLatency latency = {};
+  ASSERT_TRUE(worker->Submit(
+      []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return true;
+      },
+      [&latency](bool, const IoLatency &l) { latency = l; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  gate.Open();
+  worker->Drain();
+  worker->Poll();
+
+  // The second job waited behind the first, then ran for at least 2 ms.
+  EXPECT_GE(latency.wait_us, 2000u);
+  EXPECT_GE(latency.run_us, 2000u);
+  auto stats = worker->GetStats();
+  EXPECT_GE(stats.max_run_us, latency.run_us);
+  EXPECT_GE(stats.total_wait_us, latency.wait_us);
+}
+
+TEST(IoWorkerTests, CompletionsMaySubmit) {
+  auto worker = IoWorker::Create(1);
+  int runs = 0;
+  ASSERT_TRUE(worker->Submit([&runs]() { return ++runs; },
+                             [&worker, &runs](bool, const IoLatency &) {
+                               EXPECT_TRUE(worker->Submit(
+                                   [&runs]() { return ++runs; }));
+                             }));
+  worker->Drain();
+  EXPECT_EQ(worker->Poll(), 1u);
+  worker->Drain();
+  EXPECT_EQ(runs, 2);
+  EXPECT_EQ(worker->Poll(), 1u);
+}
+
+TEST(IoWorkerTests, DestructorFinishesQueuedJobs) {
+  int runs = 0;
+  {
+    auto worker = IoWorker::Create();
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_TRUE(worker->Submit([&runs]() {
+        ++runs;
+        return true;
+      }));
+    }
+  }
+  EXPECT_EQ(runs, 3);
+}
+} // namespace
+} // namespace cdfw
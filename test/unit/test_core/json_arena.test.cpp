@@ -0,0 +1,125 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/json_arena.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace cdfw {
+namespace {
+TEST(JsonArenaTests, Allocate_Aligned) {
+  StaticJsonArena<256> arena;
+  for (std::size_t size : {1, 3, 8, 17}) {
+    void *ptr = arena.allocate(size);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) %
+                  alignof(std::max_align_t),
+              0);
+  }
+}
+
+TEST(JsonArenaTests, Allocate_UnalignedBuffer) {
+  alignas(std::max_align_t) std::uint8_t buf[128];
+  JsonArena arena(buf + 1, sizeof(buf) - 1);
+  EXPECT_LT(arena.Capacity(), sizeof(buf) - 1);
+
+  void *ptr = arena.allocate(4);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::max_align_t),
+            0);
+}
+
+TEST(JsonArenaTests, Allocate_Exhausted) {
+  StaticJsonArena<64> arena;
+  EXPECT_EQ(arena.allocate(1024), nullptr);
+  EXPECT_EQ(arena.Failures(), 1);
+  EXPECT_EQ(arena.Used(), 0);
+
+  // Smaller requests still succeed.
+  EXPECT_NE(arena.allocate(8), nullptr);
+}
+
+TEST(JsonArenaTests, Deallocate_LastBlockIsReclaimed) {
+  StaticJsonArena<256> arena;
+  void *a = arena.allocate(16);
+  std::size_t used = arena.Used();
+  void *b = arena.allocate(16);
+
+  arena.deallocate(b);
+  EXPECT_EQ(arena.Used(), used);
+
+  // Older blocks are only reclaimed by Reset().
+  arena.deallocate(a);
+  EXPECT_EQ(arena.Used(), used);
+}
+
+TEST(JsonArenaTests, Reallocate_LastBlockInPlace) {
+  StaticJsonArena<256> arena;
+  auto *ptr = static_cast<char *>(arena.allocate(8));
+  std::memcpy(ptr, "abcdefg", 8);
+
+  EXPECT_EQ(arena.reallocate(ptr, 64), ptr);
+  EXPECT_STREQ(ptr, "abcdefg");
+  std::size_t grown = arena.Used();
+
+  EXPECT_EQ(arena.reallocate(ptr, 8), ptr);
+  EXPECT_LT(arena.Used(), grown);
+}
+
+TEST(JsonArenaTests, Reallocate_OlderBlockMoves) {
+  StaticJsonArena<256> arena;
+  auto *a = static_cast<char *>(arena.allocate(8));
+  std::memcpy(a, "abcdefg", 8);
+  arena.allocate(8);
+
+  auto *moved = static_cast<char *>(arena.reallocate(a, 32));
+  ASSERT_NE(moved, nullptr);
+  EXPECT_NE(moved, a);
+  EXPECT_STREQ(moved, "abcdefg");
+}
+
+TEST(JsonArenaTests, Reallocate_ExhaustedKeepsBlock) {
+  StaticJsonArena<64> arena;
+  auto *ptr = static_cast<char *>(arena.allocate(8));
+  std::size_t used = arena.Used();
+
+  EXPECT_EQ(arena.reallocate(ptr, 1024), nullptr);
+  EXPECT_EQ(arena.Used(), used);
+  EXPECT_EQ(arena.Failures(), 1);
+}
+
+TEST(JsonArenaTests, Reset) {
+  StaticJsonArena<256> arena;
+  void *first = arena.allocate(32);
+  arena.allocate(32);
+  std::size_t high_water = arena.Used();
+
+  arena.Reset();
+  EXPECT_EQ(arena.Used(), 0);
+  EXPECT_EQ(arena.HighWater(), high_water);
+  EXPECT_EQ(arena.allocate(32), first);
+}
+
+TEST(JsonArenaTests, DocumentAllocator) {
+  StaticJsonArena<256> arena;
+  arena.allocate(32);
+
+  EXPECT_EQ(DocumentAllocator(&arena), &arena);
+  EXPECT_EQ(arena.Used(), 0);
+
+  ArduinoJson::Allocator *heap = DocumentAllocator(nullptr);
+  ASSERT_NE(heap, nullptr);
+  void *ptr = heap->allocate(16);
+  EXPECT_NE(ptr, nullptr);
+  heap->deallocate(ptr);
+}
+} // namespace
+} // namespace cdfw
@@ -0,0 +1,107 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/path_buf.h"
+#include "cdfw/core/vfs.h"
+#include "test/support/alloc_tracker.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <filesystem>
+#include <string>
+
+namespace cdfw {
+namespace vfs {
+namespace {
+TEST(PathViewTests, FromPathAndStrings) {
+  Path path("/sd/horolibre");
+  std::string s = "/sd/horolibre";
+  EXPECT_EQ(PathView(path), PathView("/sd/horolibre"));
+  EXPECT_EQ(PathView(s).native().data(), s.data());
+  EXPECT_EQ(PathView(path).native().data(), path.c_str());
+  EXPECT_TRUE(PathView().empty());
+}
+
+TEST(PathViewTests, Decomposition) {
+  PathView view("/sd/horolibre/index.bin");
+  EXPECT_EQ(view.filename(), "index.bin");
+  EXPECT_EQ(view.parent_path(), "/sd/horolibre");
+  EXPECT_EQ(PathView("/sd").parent_path(), "/");
+  EXPECT_EQ(PathView("name").filename(), "name");
+  EXPECT_TRUE(PathView("name").parent_path().empty());
+}
+
+TEST(PathViewTests, ExplicitConversions) {
+  PathView view("/sd/horolibre");
+  EXPECT_EQ(Path(view), Path("/sd/horolibre"));
+  EXPECT_EQ(std::filesystem::path(view), "/sd/horolibre");
+}
+
+TEST(PathBufTests, Join) {
+  PathBuf<> path(Path("/sd"));
+  path /= "horolibre";
+  path /= "routines";
+  EXPECT_TRUE(path.ok());
+  EXPECT_EQ(path.view(), "/sd/horolibre/routines");
+  EXPECT_STREQ(path.c_str(), "/sd/horolibre/routines");
+  EXPECT_EQ(path.size(), 22);
+}
+
+TEST(PathBufTests, Join_SingleSeparator) {
+  PathBuf<> path("/sd/");
+  path /= "a";
+  EXPECT_EQ(path.view(), "/sd/a");
+  path /= "/b";
+  EXPECT_EQ(path.view(), "/sd/a/b");
+
+  PathBuf<> relative;
+  relative /= "a";
+  EXPECT_EQ(relative.view(), "a");
+}
+
+TEST(PathBufTests, Append) {
+  PathBuf<> path("/sd/0000002a");
+  path += ".rt";
+  EXPECT_EQ(path.view(), "/sd/0000002a.rt");
+  EXPECT_EQ(path.view().filename(), "0000002a.rt");
+}
+
+TEST(PathBufTests, Overflow) {
+  PathBuf<8> path("/sd");
+  path /= "abcd";
+  EXPECT_TRUE(path.ok());
+  EXPECT_EQ(path.view(), "/sd/abcd");
+
+  // Fails as a whole, and stays failed.
+  path /= "e";
+  EXPECT_FALSE(path.ok());
+  EXPECT_TRUE(path.empty());
+  EXPECT_STREQ(path.c_str(), "");
+  path += "";
+  EXPECT_FALSE(path.ok());
+
+  path.clear();
+  path /= "x";
+  EXPECT_TRUE(path.ok());
+  EXPECT_EQ(path.view(), "x");
+}
+
+TEST(PathBufTests, DoesNotAllocate) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  Path dir("/sd/horolibre/routines");
+
+  test::AllocationCounter counter;
+  PathBuf<> path(dir);
+  path /= "0000002a.rt";
+  PathView view = path;
+  EXPECT_EQ(view.filename(), "0000002a.rt");
+  EXPECT_EQ(view.parent_path(), dir);
+  EXPECT_EQ(counter.Allocations(), 0);
+}
+} // namespace
+} // namespace vfs
+} // namespace cdfw
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/ram_volume.h"
+#include "cdfw/core/vfs.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+namespace vfs {
+namespace {
+TEST(RamVolumeTests, VolumeInfo) {
+  auto volume = RamVolume::Create("/mem/", 1000);
+  EXPECT_FALSE(volume->IsSD());
+  EXPECT_EQ(volume->MountPoint().native(), "/mem");
+  EXPECT_EQ(volume->Capacity(), 1000u);
+  EXPECT_EQ(volume->Available(), 1000u);
+  EXPECT_EQ(volume->Used(), 0u);
+  EXPECT_TRUE(volume->Exists("/mem"));
+}
+
+TEST(RamVolumeTests, RejectsPathsOffTheVolume) {
+  auto volume = RamVolume::Create();
+  EXPECT_FALSE(volume->CreateDirs("/sd/a"));
+  EXPECT_FALSE(volume->CreateDirs("/ramdisk"));
+  EXPECT_FALSE(volume->Exists("/ram/../sd"));
+  EXPECT_FALSE(volume->OpenWrite("/other").IsOpen());
+  EXPECT_FALSE(volume->RemoveAll("/ram"));
+}
+
+TEST(RamVolumeTests, OpenNeedsParent) {
+  auto volume = RamVolume::Create();
+  EXPECT_FALSE(volume->OpenWrite("/ram/a/f").IsOpen());
+  ASSERT_TRUE(volume->CreateDirs("/ram/a"));
+  EXPECT_TRUE(volume->OpenWrite("/ram/a/f").IsOpen());
+  // Dirs are not files, and files are not dirs.
+  EXPECT_FALSE(volume->OpenRead("/ram/a").IsOpen());
+  EXPECT_FALSE(volume->CreateDirs("/ram/a/f/g"));
+}
+
+TEST(RamVolumeTests, CapacityLimitsWrites) {
+  auto volume = RamVolume::Create("/ram", 100);
+  std::vector<std::uint8_t> bytes(80, 1);
+
+  auto file = volume->OpenWrite("/ram/a");
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), bytes.size())), 80u);
+  EXPECT_TRUE(file.Close());
+  EXPECT_EQ(volume->Used(), 80u);
+  EXPECT_EQ(volume->Available(), 20u);
+
+  // Only 20 bytes fit. Truncating gives them back.
+  file = volume->OpenWrite("/ram/b");
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), bytes.size())), 20u);
+  EXPECT_FALSE(file.Close()); // The short write is reported.
+  EXPECT_EQ(volume->Available(), 0u);
+  EXPECT_TRUE(volume->OpenWrite("/ram/b").Close());
+  EXPECT_EQ(volume->Available(), 20u);
+
+  EXPECT_TRUE(volume->Remove("/ram/a"));
+  EXPECT_EQ(volume->Used(), 0u);
+}
+
+TEST(RamVolumeTests, MappingKeepsContents) {
+  auto volume = RamVolume::Create();
+  const std::uint8_t old_bytes[] = {1, 2, 3};
+  const std::uint8_t new_bytes[] = {4, 5, 6, 7};
+  auto file = volume->OpenWrite("/ram/f");
+  EXPECT_EQ(file.Write(old_bytes), 3u);
+  EXPECT_TRUE(file.Close());
+
+  auto mapped = volume->Map("/ram/f");
+  ASSERT_TRUE(mapped.IsMapped());
+  auto view = mapped.View(0, 3);
+
+  // Neither an overwrite nor a truncation disturbs the mapping.
+  file = volume->OpenAppend("/ram/f");
+  ASSERT_TRUE(file.Seek(0));
+  EXPECT_EQ(file.Write(new_bytes), 4u);
+  EXPECT_TRUE(file.Close());
+  EXPECT_TRUE(volume->OpenWrite("/ram/f").Close());
+  EXPECT_EQ(view[0], 1);
+  EXPECT_EQ(view[2], 3);
+  EXPECT_EQ(volume->Used(), 0u);
+}
+
+TEST(RamVolumeTests, RenameMovesSubtree) {
+  auto volume = RamVolume::Create();
+  ASSERT_TRUE(volume->CreateDirs("/ram/a/b"));
+  EXPECT_TRUE(volume->OpenWrite("/ram/a/b/f").Close());
+  EXPECT_TRUE(volume->OpenWrite("/ram/file").Close());
+
+  EXPECT_FALSE(volume->Rename("/ram/a", "/ram/a/b/c"));
+  EXPECT_FALSE(volume->Rename("/ram/file", "/ram/a"));
+  EXPECT_TRUE(volume->Rename("/ram/a", "/ram/z"));
+  EXPECT_FALSE(volume->Exists("/ram/a/b/f"));
+  EXPECT_TRUE(volume->Exists("/ram/z/b/f"));
+
+  std::vector<DirEntry> entries;
+  ASSERT_TRUE(volume->List("/ram", entries));
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries[0].name, "file");
+  EXPECT_EQ(entries[1].name, "z");
+  EXPECT_TRUE(entries[1].is_dir);
+}
+
+TEST(RamVolumeTests, OpenFilesOutliveRemoval) {
+  auto volume = RamVolume::Create("/ram", 10);
+  auto file = volume->OpenWrite("/ram/f");
+  const std::uint8_t bytes[] = {1, 2, 3, 4};
+  EXPECT_EQ(file.Write(bytes), 4u);
+  EXPECT_TRUE(file.Flush());
+  EXPECT_TRUE(volume->Remove("/ram/f"));
+  EXPECT_EQ(volume->Used(), 0u);
+
+  // The orphan still reads and writes, but no longer counts.
+  EXPECT_EQ(file.Write(bytes), 4u);
+  EXPECT_TRUE(file.Close());
+  EXPECT_EQ(volume->Used(), 0u);
+}
+} // namespace
+} // namespace vfs
+} // namespace cdfw
@@ -4,13 +4,23 @@
 
 // Local Headers
 #include "cdfw/core/routine.h"
+#include "cdfw/core/crc32.h"
+#include "cdfw/core/json_arena.h"
 #include "cdfw/core/station.h"
+#include "test/support/alloc_tracker.h"
 
 // Third Party Headers
 #include <gtest/gtest.h>
 
 // C++ Standard Library Headers
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace cdfw {
 namespace {
@@ -19,6 +29,72 @@ protected:
   std::shared_ptr<RoutineSerializer> serializer = RoutineSerializer::Create();
 };
 
+class RoutineBinarySerializerTests : public ::testing::Test {
+protected:
+  std::shared_ptr<RoutineSerializer> serializer =
+      RoutineSerializer::Create(RoutineSerializer::Format::kBINARY);
+  std::shared_ptr<RoutineSerializer> json_serializer =
+      RoutineSerializer::Create(RoutineSerializer::Format::kJSON);
+
+  static Routine GetConfigured() {
+    return Routine::GetConfigured(
+        "routine_configured",
+        WetStation::GetConfigured("Clean", 20,
+                                  WetStation::AgitationLevel::kNONE),
+        WetStation::GetConfigured("Rinse 1", 40,
+                                  WetStation::AgitationLevel::kLOW),
+        WetStation::GetDisabled(),
+        WetStation::GetConfigured("Rinse 3", 80,
+                                  WetStation::AgitationLevel::kHIGH),
+        DryStation::GetConfigured("Dry", 100,
+                                  DryStation::SpinType::kBIDIRECTIONAL));
+  }
+
+  // Rewrites the record's checksum after its fields were changed.
+  static void Reseal(std::uint8_t (&buf)[RoutineRecord::kSize]) {
+    std::uint32_t crc = Crc32(buf, RoutineRecord::kSize - 4);
+    for (std::size_t i = 0; i < 4; ++i) {
+      buf[RoutineRecord::kSize - 4 + i] =
+          static_cast<std::uint8_t>(crc >> 8 * i);
+    }
+  }
+};
+
+void ExpectRoutineEq(const Routine &actual, const Routine &expected) {
+  EXPECT_EQ(actual.name, expected.name);
+  for (std::size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(actual.wet_stations[i].name, expected.wet_stations[i].name);
+    EXPECT_EQ(actual.wet_stations[i].enabled, expected.wet_stations[i].enabled);
+    EXPECT_EQ(actual.wet_stations[i].time, expected.wet_stations[i].time);
+    EXPECT_EQ(actual.wet_stations[i].agitation,
+              expected.wet_stations[i].agitation);
+  }
+  EXPECT_EQ(actual.dry_station.name, expected.dry_station.name);
+  EXPECT_EQ(actual.dry_station.enabled, expected.dry_station.enabled);
+  EXPECT_EQ(actual.dry_station.time, expected.dry_station.time);
+  EXPECT_EQ(actual.dry_station.spin, expected.dry_station.spin);
+}
+
+// Collects the output of DeserializeMany.
+struct BatchResult {
+  std::vector<std::pair<std::size_t, Routine>> routines;
+  std::vector<std::pair<std::size_t, RoutineError::Code>> errors;
+  std::size_t count = 0;
+
+  void Read(RoutineSerializer &serializer, const std::string &input,
+            RoutineSerializer::Layout layout) {
+    std::istringstream stream(input);
+    count = serializer.DeserializeMany(
+        stream, layout,
+        [&](std::size_t index, const Routine &routine) {
+          routines.emplace_back(index, routine);
+        },
+        [&](std::size_t index, const RoutineError &error) {
+          errors.emplace_back(index, error.code);
+        });
+  }
+};
+
 TEST(RoutineTests, Disabled) {
   Routine routine = Routine::GetDisabled();
 
@@ -261,5 +337,642 @@ TEST_F(RoutineSerializerTests, RoundTrip) {
   EXPECT_EQ(actual.dry_station.spin, expected.dry_station.spin);
 }
 
+TEST_F(RoutineSerializerTests, Deserialize_Stream) {
+  std::istringstream input(
+      "{\"name\":\"routine_configured\",\"author\":\"unused\","
+      "\"wet_stations\":[{\"name\":\"Clean\",\"enabled\":true,\"time\":20,"
+      "\"agitation\":0,\"notes\":\"unused\"},{\"name\":\"Rinse 1\","
+      "\"enabled\":true,\"time\":40,\"agitation\":1},{\"name\":\"Rinse 2\","
+      "\"enabled\":true,\"time\":60,\"agitation\":2},{\"name\":\"Rinse 3\","
+      "\"enabled\":true,\"time\":80,\"agitation\":3}],\"dry_station\":{"
+      "\"name\":\"Dry\",\"enabled\":true,\"time\":100,\"spin\":2},"
+      "\"history\":[1,2,3]}");
+  Routine routine = serializer->Deserialize(input);
+  Routine expected = Routine::GetConfigured(
+      "routine_configured",
+      WetStation::GetConfigured("Clean", 20, WetStation::AgitationLevel::kNONE),
+      WetStation::GetConfigured("Rinse 1", 40,
+                                WetStation::AgitationLevel::kLOW),
+      WetStation::GetConfigured("Rinse 2", 60,
+                                WetStation::AgitationLevel::kMEDIUM),
+      WetStation::GetConfigured("Rinse 3", 80,
+                                WetStation::AgitationLevel::kHIGH),
+      DryStation::GetConfigured("Dry", 100,
+                                DryStation::SpinType::kBIDIRECTIONAL));
+
+  ExpectRoutineEq(routine, expected);
+}
+
+TEST_F(RoutineSerializerTests, RoundTrip_Stream) {
+  Routine expected = Routine::GetDefault();
+  std::istringstream input(serializer->Serialize(expected));
+  ExpectRoutineEq(serializer->Deserialize(input), expected);
+}
+
+TEST_F(RoutineSerializerTests, RoundTrip_Arena) {
+  auto arena =
+      std::make_shared<StaticJsonArena<RoutineJsonCodec::kArenaSize>>();
+  serializer =
+      RoutineSerializer::Create(RoutineSerializer::Format::kJSON, arena);
+
+  Routine expected = Routine::GetDefault();
+  std::string json = serializer->Serialize(expected);
+  EXPECT_EQ(json, RoutineSerializer::Create()->Serialize(expected));
+
+  std::istringstream input(json);
+  ExpectRoutineEq(serializer->Deserialize(input), expected);
+  EXPECT_GT(arena->HighWater(), 0);
+  EXPECT_EQ(arena->Failures(), 0);
+}
+
+TEST(RoutineJsonCodecTests, RoundTrip) {
+  StaticJsonArena<RoutineJsonCodec::kArenaSize> arena;
+  RoutineJsonCodec codec(arena);
+
+  Routine expected = Routine::GetDefault();
+  char buf[512];
+  std::size_t size = codec.Write(expected, buf, sizeof(buf));
+  ASSERT_GT(size, 0);
+  EXPECT_EQ(std::string(buf, size),
+            RoutineSerializer::Create()->Serialize(expected));
+
+  Routine actual = Routine::GetDisabled();
+  RoutineError error{};
+  ASSERT_TRUE(codec.Read(actual, error, buf, size));
+  ExpectRoutineEq(actual, expected);
+
+  // The arena is reused, not grown, across documents.
+  std::size_t high_water = arena.HighWater();
+  for (int i = 0; i < 10; ++i) {
+    std::istringstream input(std::string(buf, size));
+    ASSERT_TRUE(codec.Read(actual, error, input));
+  }
+  EXPECT_EQ(arena.HighWater(), high_water);
+}
+
+TEST(RoutineJsonCodecTests, Allocations) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  StaticJsonArena<RoutineJsonCodec::kArenaSize> arena;
+  RoutineJsonCodec codec(arena);
+  char buf[512];
+  std::size_t size = codec.Write(Routine::GetDefault(), buf, sizeof(buf));
+
+  // The first read builds the key filter.
+  Routine routine = Routine::GetDisabled();
+  RoutineError error{};
+  ASSERT_TRUE(codec.Read(routine, error, static_cast<const char *>(buf), size));
+
+  test::AllocationCounter counter;
+  for (int i = 0; i < 10; ++i) {
+    codec.Write(routine, buf, sizeof(buf));
+    codec.Read(routine, error, static_cast<const char *>(buf), size);
+  }
+  EXPECT_EQ(counter.Allocations(), 0);
+}
+
+TEST_F(RoutineSerializerTests, Deserialize_AllocationBudget) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  std::string json = serializer->Serialize(Routine::GetDefault());
+  std::istringstream warm_up(json);
+  serializer->Deserialize(warm_up);
+
+  // On the general heap a routine costs one slot pool plus one block per
+  // distinct string (13 for the default routine).
+  std::istringstream input(json);
+  test::AllocationCounter counter;
+  serializer->Deserialize(input);
+  EXPECT_LE(counter.Allocations(), 24);
+
+  // In an arena it costs nothing.
+  serializer = RoutineSerializer::Create(
+      RoutineSerializer::Format::kJSON,
+      std::make_shared<StaticJsonArena<RoutineJsonCodec::kArenaSize>>());
+  input.clear();
+  input.seekg(0);
+  counter.Reset();
+  serializer->Deserialize(input);
+  EXPECT_EQ(counter.Allocations(), 0);
+}
+
+TEST(RoutineJsonCodecTests, Read_Malformed) {
+  StaticJsonArena<RoutineJsonCodec::kArenaSize> arena;
+  RoutineJsonCodec codec(arena);
+
+  Routine routine = Routine::GetDefault();
+  RoutineError error{};
+  EXPECT_FALSE(codec.Read(routine, error, "{\"name\":"));
+  EXPECT_EQ(error.code, RoutineError::Code::kTRUNCATED);
+  EXPECT_EQ(routine.name, "Default");
+}
+
+TEST(RoutineJsonCodecTests, ArenaTooSmall) {
+  StaticJsonArena<64> arena;
+  RoutineJsonCodec codec(arena);
+
+  char buf[512];
+  EXPECT_EQ(codec.Write(Routine::GetDefault(), buf, sizeof(buf)), 0);
+
+  std::string json = RoutineSerializer::Create()->Serialize(
+      Routine::GetDefault());
+  Routine routine = Routine::GetDisabled();
+  RoutineError error{};
+  EXPECT_FALSE(codec.Read(routine, error, json));
+  EXPECT_EQ(error.code, RoutineError::Code::kTOO_LARGE);
+  EXPECT_EQ(routine.name, "Disabled");
+  EXPECT_GT(arena.Failures(), 0);
+}
+
+// A valid routine in which every field appears once, so that each test can
+// break exactly one field by substitution.
+constexpr char kValidRoutine[] =
+    R"({"name":"R","wet_stations":[)"
+    R"({"name":"Clean","enabled":true,"time":20,"agitation":0},)"
+    R"({"name":"Rinse 1","enabled":true,"time":40,"agitation":1},)"
+    R"({"name":"Rinse 2","enabled":false,"time":0,"agitation":0},)"
+    R"({"name":"Rinse 3","enabled":true,"time":80,"agitation":3}],)"
+    R"("dry_station":{"name":"Dry","enabled":true,"time":100,"spin":2}})";
+
+class RoutineValidationTests : public RoutineSerializerTests {
+protected:
+  // Parses kValidRoutine with `from` replaced by `to` and returns the error.
+  RoutineError Parse(const std::string &from, const std::string &to) {
+    std::string json = kValidRoutine;
+    auto pos = json.find(from);
+    EXPECT_NE(pos, std::string::npos) << from;
+    if (pos != std::string::npos) {
+      json.replace(pos, from.size(), to);
+    }
+
+    std::istringstream input(json);
+    Routine routine = Routine::GetDefault();
+    RoutineError error{};
+    if (!serializer->Deserialize(input, routine, error)) {
+      // Rejected routines are left untouched.
+      EXPECT_EQ(routine.name, "Default");
+    }
+    return error;
+  }
+
+  static void ExpectError(const RoutineError &error, RoutineError::Code code,
+                          const std::string &path) {
+    EXPECT_EQ(error.code, code);
+    EXPECT_EQ(error.path, path);
+  }
+};
+
+TEST_F(RoutineValidationTests, Valid) {
+  std::istringstream input(kValidRoutine);
+  Routine routine = Routine::GetDisabled();
+  RoutineError error{};
+  ASSERT_TRUE(serializer->Deserialize(input, routine, error));
+  EXPECT_EQ(routine.name, "R");
+  EXPECT_EQ(routine.wet_stations[1].agitation,
+            WetStation::AgitationLevel::kLOW);
+  EXPECT_FALSE(routine.wet_stations[2].enabled);
+  EXPECT_EQ(routine.dry_station.spin, DryStation::SpinType::kBIDIRECTIONAL);
+}
+
+TEST_F(RoutineValidationTests, Name) {
+  using Code = RoutineError::Code;
+  ExpectError(Parse(R"("name":"R",)", ""), Code::kMISSING, "name");
+  ExpectError(Parse(R"("name":"R")", R"("name":7)"), Code::kWRONG_TYPE,
+              "name");
+  ExpectError(Parse(R"("name":"R")",
+                    "\"name\":\"" + std::string(32, 'x') + "\""),
+              Code::kTOO_LONG, "name");
+  ExpectError(Parse(R"("name":"Dry")", R"("name":null)"), Code::kMISSING,
+              "dry_station.name");
+}
+
+TEST_F(RoutineValidationTests, StationLayout) {
+  using Code = RoutineError::Code;
+  ExpectError(
+      Parse(R"(,{"name":"Rinse 3","enabled":true,"time":80,"agitation":3})",
+            ""),
+      Code::kWRONG_COUNT, "wet_stations");
+  ExpectError(Parse(R"("wet_stations":[)", R"("wet_stations":{},"x":[)"),
+              Code::kWRONG_TYPE, "wet_stations");
+  ExpectError(Parse(R"("dry_station":{)", R"("dry_station":5,"x":{)"),
+              Code::kWRONG_TYPE, "dry_station");
+  ExpectError(Parse(R"("dry_station":{)", R"("x":{)"), Code::kMISSING,
+              "dry_station");
+
+  // A dry station in a wet position, and vice versa.
+  ExpectError(Parse(R"("agitation":3})", R"("agitation":3,"spin":0})"),
+              Code::kWRONG_STATION, "wet_stations[3]");
+  ExpectError(Parse(R"("spin":2})", R"("spin":2,"agitation":1})"),
+              Code::kWRONG_STATION, "dry_station");
+}
+
+TEST_F(RoutineValidationTests, Bounds) {
+  using Code = RoutineError::Code;
+  ExpectError(Parse(R"("agitation":1)", R"("agitation":4)"),
+              Code::kOUT_OF_RANGE, "wet_stations[1].agitation");
+  ExpectError(Parse(R"("spin":2)", R"("spin":3)"), Code::kOUT_OF_RANGE,
+              "dry_station.spin");
+  ExpectError(Parse(R"("time":100)", R"("time":3601)"), Code::kOUT_OF_RANGE,
+              "dry_station.time");
+  ExpectError(Parse(R"("time":80)", R"("time":-5)"), Code::kOUT_OF_RANGE,
+              "wet_stations[3].time");
+  ExpectError(Parse(R"("time":40)", R"("time":"40")"), Code::kWRONG_TYPE,
+              "wet_stations[1].time");
+
+  // Enabled stations must run; disabled ones may not.
+  ExpectError(Parse(R"("time":20)", R"("time":0)"), Code::kOUT_OF_RANGE,
+              "wet_stations[0].time");
+  EXPECT_EQ(Parse(R"("enabled":false,"time":0)",
+                  R"("enabled":false,"time":10)")
+                .code,
+            Code::kNONE);
+}
+
+TEST_F(RoutineValidationTests, ReportsFirstBadField) {
+  std::string json = kValidRoutine;
+  json.replace(json.find(R"("agitation":1)"), 13, R"("agitation":9)");
+  json.replace(json.find(R"("time":100)"), 10, R"("time":9999)");
+
+  std::istringstream input(json);
+  Routine routine = Routine::GetDisabled();
+  RoutineError error{};
+  EXPECT_FALSE(serializer->Deserialize(input, routine, error));
+  ExpectError(error, RoutineError::Code::kOUT_OF_RANGE,
+              "wet_stations[1].agitation");
+}
+
+TEST_F(RoutineValidationTests, Nesting) {
+  // Unknown keys are skipped, but only to a bounded depth.
+  EXPECT_EQ(Parse(R"("name":"R")", R"("name":"R","x":[[1]])").code,
+            RoutineError::Code::kNONE);
+  ExpectError(Parse(R"("name":"R")", R"("name":"R","x":[[[[[1]]]]])"),
+              RoutineError::Code::kTOO_DEEP, "");
+}
+
+TEST_F(RoutineValidationTests, Deserialize_InvalidIsDisabled) {
+  std::string json = kValidRoutine;
+  json.replace(json.find(R"("spin":2)"), 8, R"("spin":7)");
+  Routine routine = serializer->Deserialize(json);
+  EXPECT_EQ(routine.name, "Disabled");
+  EXPECT_FALSE(routine.dry_station.enabled);
+}
+
+TEST_F(RoutineValidationTests, DeserializeMany_ReportsPath) {
+  std::string bad = kValidRoutine;
+  bad.replace(bad.find(R"("time":40)"), 9, R"("time":0)");
+  BatchResult result;
+  result.Read(*serializer,
+              std::string(kValidRoutine) + "\n" + bad + "\n" + kValidRoutine,
+              RoutineSerializer::Layout::kNDJSON);
+
+  EXPECT_EQ(result.count, 2);
+  ASSERT_EQ(result.errors.size(), 1);
+  EXPECT_EQ(result.errors[0].first, 1);
+  EXPECT_EQ(result.errors[0].second, RoutineError::Code::kOUT_OF_RANGE);
+}
+
+TEST_F(RoutineSerializerTests, SerializeMany_Array) {
+  Routine a = Routine::GetDefault();
+  Routine b = Routine::GetDisabled();
+  std::ostringstream output;
+  EXPECT_EQ(serializer->SerializeMany({a, b},
+                                      RoutineSerializer::Layout::kARRAY,
+                                      output),
+            2);
+  EXPECT_EQ(output.str(), "[" + serializer->Serialize(a) + "," +
+                              serializer->Serialize(b) + "]");
+}
+
+TEST_F(RoutineSerializerTests, SerializeMany_NDJSON) {
+  Routine a = Routine::GetDefault();
+  Routine b = Routine::GetDisabled();
+  std::ostringstream output;
+  EXPECT_EQ(serializer->SerializeMany({a, b},
+                                      RoutineSerializer::Layout::kNDJSON,
+                                      output),
+            2);
+  EXPECT_EQ(output.str(), serializer->Serialize(a) + "\n" +
+                              serializer->Serialize(b) + "\n");
+}
+
+TEST_F(RoutineSerializerTests, SerializeMany_Empty) {
+  std::ostringstream output;
+  EXPECT_EQ(serializer->SerializeMany(std::vector<Routine>(),
+                                      RoutineSerializer::Layout::kARRAY,
+                                      output),
+            0);
+  EXPECT_EQ(output.str(), "[]");
+}
+
+TEST_F(RoutineSerializerTests, RoundTripMany) {
+  std::vector<Routine> expected;
+  for (int i = 0; i < 500; ++i) {
+    Routine routine = Routine::GetDefault();
+    routine.name = "Routine " + std::to_string(i);
+    routine.wet_stations[i % 4].time = i + 1;
+    expected.push_back(routine);
+  }
+
+  for (auto layout : {RoutineSerializer::Layout::kARRAY,
+                      RoutineSerializer::Layout::kNDJSON}) {
+    std::ostringstream output;
+    ASSERT_EQ(serializer->SerializeMany(expected, layout, output), 500);
+
+    BatchResult result;
+    result.Read(*serializer, output.str(), layout);
+    EXPECT_EQ(result.count, 500);
+    EXPECT_TRUE(result.errors.empty());
+    ASSERT_EQ(result.routines.size(), 500);
+    for (std::size_t i = 0; i < 500; ++i) {
+      EXPECT_EQ(result.routines[i].first, i);
+      ExpectRoutineEq(result.routines[i].second, expected[i]);
+    }
+  }
+}
+
+TEST_F(RoutineSerializerTests, DeserializeMany_NDJSON_ErrorsDoNotAbort) {
+  std::string good = serializer->Serialize(Routine::GetDefault());
+  std::string input = good + "\n" +             // 0
+                      "{\"name\":\n" +          // 1: truncated
+                      "\n" +                     // skipped
+                      "42\n" +                   // 2: not an object
+                      "{\"name\" \"x\"}\n" +    // 3: syntax
+                      std::string(4096, ' ') + "{}\n" + // 4: too long
+                      good;                      // 5
+  BatchResult result;
+  result.Read(*serializer, input, RoutineSerializer::Layout::kNDJSON);
+
+  EXPECT_EQ(result.count, 2);
+  ASSERT_EQ(result.routines.size(), 2);
+  EXPECT_EQ(result.routines[0].first, 0);
+  EXPECT_EQ(result.routines[1].first, 5);
+  ExpectRoutineEq(result.routines[1].second, Routine::GetDefault());
+
+  using Code = RoutineError::Code;
+  std::vector<std::pair<std::size_t, Code>> expected_errors = {
+      {1, Code::kTRUNCATED},
+      {2, Code::kNOT_OBJECT},
+      {3, Code::kSYNTAX},
+      {4, Code::kTOO_LARGE}};
+  EXPECT_EQ(result.errors, expected_errors);
+}
+
+TEST_F(RoutineSerializerTests, DeserializeMany_Array_NotObjectContinues) {
+  std::string good = serializer->Serialize(Routine::GetDefault());
+  BatchResult result;
+  result.Read(*serializer, " [ \"oops\" , " + good + " ] ",
+              RoutineSerializer::Layout::kARRAY);
+
+  EXPECT_EQ(result.count, 1);
+  ASSERT_EQ(result.routines.size(), 1);
+  EXPECT_EQ(result.routines[0].first, 1);
+  ASSERT_EQ(result.errors.size(), 1);
+  EXPECT_EQ(result.errors[0].first, 0);
+  EXPECT_EQ(result.errors[0].second, RoutineError::Code::kNOT_OBJECT);
+}
+
+TEST_F(RoutineSerializerTests, DeserializeMany_Array_SyntaxErrorEndsBatch) {
+  std::string good = serializer->Serialize(Routine::GetDefault());
+  BatchResult result;
+  result.Read(*serializer, "[" + good + ",{\"name\" 1}," + good + "]",
+              RoutineSerializer::Layout::kARRAY);
+
+  EXPECT_EQ(result.count, 1);
+  ASSERT_EQ(result.errors.size(), 1);
+  EXPECT_EQ(result.errors[0].first, 1);
+  EXPECT_EQ(result.errors[0].second, RoutineError::Code::kSYNTAX);
+}
+
+TEST_F(RoutineSerializerTests, DeserializeMany_Array_Unterminated) {
+  std::string good = serializer->Serialize(Routine::GetDefault());
+  BatchResult result;
+  result.Read(*serializer, "[" + good, RoutineSerializer::Layout::kARRAY);
+
+  EXPECT_EQ(result.count, 1);
+  ASSERT_EQ(result.errors.size(), 1);
+  EXPECT_EQ(result.errors[0].first, 1);
+  EXPECT_EQ(result.errors[0].second, RoutineError::Code::kTRUNCATED);
+}
+
+TEST_F(RoutineSerializerTests, DeserializeMany_Array_NotAnArray) {
+  BatchResult result;
+  result.Read(*serializer, "{}", RoutineSerializer::Layout::kARRAY);
+  EXPECT_EQ(result.count, 0);
+  ASSERT_EQ(result.errors.size(), 1);
+  EXPECT_EQ(result.errors[0].second, RoutineError::Code::kSYNTAX);
+
+  result = BatchResult();
+  result.Read(*serializer, "[]", RoutineSerializer::Layout::kARRAY);
+  EXPECT_EQ(result.count, 0);
+  EXPECT_TRUE(result.errors.empty());
+}
+
+TEST_F(RoutineBinarySerializerTests, RoundTrip_Stream) {
+  // Two consecutive records, as stored in a routine library.
+  Routine first = GetConfigured();
+  Routine second = Routine::GetDefault();
+  std::istringstream input(serializer->Serialize(first) +
+                           serializer->Serialize(second));
+
+  ExpectRoutineEq(serializer->Deserialize(input), first);
+  ExpectRoutineEq(serializer->Deserialize(input), second);
+  ExpectRoutineEq(serializer->Deserialize(input), Routine::GetDisabled());
+}
+
+TEST_F(RoutineBinarySerializerTests, RoundTripMany) {
+  std::vector<Routine> expected = {GetConfigured(), Routine::GetDefault(),
+                                   Routine::GetDisabled()};
+  std::ostringstream output;
+  ASSERT_EQ(serializer->SerializeMany(
+                expected, RoutineSerializer::Layout::kARRAY, output),
+            3);
+  EXPECT_EQ(output.str().size(), 3 * RoutineRecord::kSize);
+
+  BatchResult result;
+  result.Read(*serializer, output.str(), RoutineSerializer::Layout::kARRAY);
+  EXPECT_EQ(result.count, 3);
+  EXPECT_TRUE(result.errors.empty());
+  ASSERT_EQ(result.routines.size(), 3);
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(result.routines[i].first, i);
+    ExpectRoutineEq(result.routines[i].second, expected[i]);
+  }
+}
+
+TEST_F(RoutineBinarySerializerTests, DeserializeMany_ErrorsDoNotAbort) {
+  std::ostringstream output;
+  serializer->SerializeMany({GetConfigured(), GetConfigured(),
+                             Routine::GetDefault()},
+                            RoutineSerializer::Layout::kARRAY, output);
+  std::string input = output.str();
+  input[RoutineRecord::kSize + 20] ^= 0xFF;
+  input += "partial";
+
+  BatchResult result;
+  result.Read(*serializer, input, RoutineSerializer::Layout::kARRAY);
+  EXPECT_EQ(result.count, 2);
+  ASSERT_EQ(result.routines.size(), 2);
+  EXPECT_EQ(result.routines[0].first, 0);
+  EXPECT_EQ(result.routines[1].first, 2);
+  ExpectRoutineEq(result.routines[1].second, Routine::GetDefault());
+
+  using Code = RoutineError::Code;
+  std::vector<std::pair<std::size_t, Code>> expected_errors = {
+      {1, Code::kCORRUPT}, {3, Code::kTRUNCATED}};
+  EXPECT_EQ(result.errors, expected_errors);
+}
+
+TEST_F(RoutineBinarySerializerTests, Deserialize_ReportsError) {
+  std::string record = serializer->Serialize(GetConfigured());
+  Routine routine = Routine::GetDefault();
+  RoutineError error{};
+
+  std::istringstream truncated(record.substr(0, 100));
+  EXPECT_FALSE(serializer->Deserialize(truncated, routine, error));
+  EXPECT_EQ(error.code, RoutineError::Code::kTRUNCATED);
+
+  record[40] ^= 0xFF;
+  std::istringstream corrupt(record);
+  EXPECT_FALSE(serializer->Deserialize(corrupt, routine, error));
+  EXPECT_EQ(error.code, RoutineError::Code::kCORRUPT);
+  EXPECT_EQ(routine.name, "Default");
+}
+
+TEST_F(RoutineBinarySerializerTests, Allocations) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  Routine routine = GetConfigured();
+  std::string record = serializer->Serialize(routine);
+  std::istringstream input(record);
+
+  test::AllocationCounter counter;
+  Routine parsed = Routine::GetDisabled();
+  RoutineError error{};
+  EXPECT_TRUE(serializer->Deserialize(input, parsed, error));
+  EXPECT_EQ(counter.Allocations(), 0);
+
+  // Only the returned string.
+  counter.Reset();
+  serializer->Serialize(routine);
+  EXPECT_EQ(counter.Allocations(), 1);
+}
+
+TEST_F(RoutineBinarySerializerTests, Serialize_Size) {
+  EXPECT_EQ(serializer->Serialize(Routine::GetDisabled()).size(),
+            RoutineRecord::kSize);
+  EXPECT_EQ(serializer->Serialize(GetConfigured()).size(),
+            RoutineRecord::kSize);
+}
+
+TEST_F(RoutineBinarySerializerTests, RoundTrip) {
+  Routine expected = GetConfigured();
+  ExpectRoutineEq(serializer->Deserialize(serializer->Serialize(expected)),
+                  expected);
+}
+
+TEST_F(RoutineBinarySerializerTests, RoundTrip_MatchesJSON) {
+  Routine routines[] = {Routine::GetDisabled(), Routine::GetDefault(),
+                        GetConfigured()};
+  for (const auto &routine : routines) {
+    ExpectRoutineEq(
+        serializer->Deserialize(serializer->Serialize(routine)),
+        json_serializer->Deserialize(json_serializer->Serialize(routine)));
+  }
+}
+
+TEST_F(RoutineBinarySerializerTests, Deserialize_WrongSize) {
+  std::string record = serializer->Serialize(GetConfigured());
+  record.pop_back();
+  ExpectRoutineEq(serializer->Deserialize(record), Routine::GetDisabled());
+}
+
+TEST_F(RoutineBinarySerializerTests, Deserialize_BadChecksum) {
+  std::string record = serializer->Serialize(GetConfigured());
+  record[10] ^= 0x01; // Corrupt the routine name.
+  ExpectRoutineEq(serializer->Deserialize(record), Routine::GetDisabled());
+}
+
+TEST_F(RoutineBinarySerializerTests, Decode_BadVersion) {
+  std::uint8_t buf[RoutineRecord::kSize];
+  RoutineRecord::Encode(GetConfigured(), buf);
+
+  // Bump the version and re-seal the record so only the version is wrong.
+  buf[4] = RoutineRecord::kVersion + 1;
+  Reseal(buf);
+
+  Routine routine = Routine::GetDefault();
+  EXPECT_FALSE(RoutineRecord::Decode(buf, routine));
+  ExpectRoutineEq(routine, Routine::GetDefault());
+}
+
+TEST_F(RoutineBinarySerializerTests, Decode_BadMode) {
+  // Wet station 2's agitation, then the dry station's spin, one past the
+  // last enumerator.
+  const std::pair<std::size_t, std::uint8_t> modes[] = {{40 + 40 + 37, 4},
+                                                         {200 + 37, 3}};
+  for (const auto &mode : modes) {
+    std::uint8_t buf[RoutineRecord::kSize];
+    RoutineRecord::Encode(GetConfigured(), buf);
+    buf[mode.first] = mode.second;
+    Reseal(buf);
+
+    Routine routine = Routine::GetDefault();
+    EXPECT_FALSE(RoutineRecord::Decode(buf, routine));
+    ExpectRoutineEq(routine, Routine::GetDefault());
+  }
+}
+
+TEST_F(RoutineBinarySerializerTests, Decode_BadTime) {
+  std::uint8_t buf[RoutineRecord::kSize];
+  RoutineRecord::Encode(GetConfigured(), buf);
+  // Wet station 1's time, one second over the limit.
+  const std::uint32_t time = Station::kMaxTime + 1;
+  for (std::size_t i = 0; i < 4; ++i) {
+    buf[40 + 32 + i] = static_cast<std::uint8_t>(time >> 8 * i);
+  }
+  Reseal(buf);
+
+  Routine routine = Routine::GetDefault();
+  EXPECT_FALSE(RoutineRecord::Decode(buf, routine));
+  ExpectRoutineEq(routine, Routine::GetDefault());
+}
+
+TEST_F(RoutineBinarySerializerTests, Encode_TruncatesLongName) {
+  Routine routine = GetConfigured();
+  routine.name = std::string(RoutineRecord::kMaxNameLength + 10, 'x');
+  Routine actual = serializer->Deserialize(serializer->Serialize(routine));
+
+  EXPECT_EQ(actual.name, std::string(RoutineRecord::kMaxNameLength, 'x'));
+}
+
+// Reports the size and speed of the binary codec relative to JSON. Timings are
+// informational only (see the recorded properties); only size is asserted.
+TEST_F(RoutineBinarySerializerTests, SizeAndSpeedComparison) {
+  constexpr int kIterations = 1000;
+  Routine routine = Routine::GetDefault();
+  std::string json = json_serializer->Serialize(routine);
+  std::string binary = serializer->Serialize(routine);
+  EXPECT_LT(binary.size(), json.size());
+
+  auto time_round_trips = [&](RoutineSerializer &s) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+      Routine r = s.Deserialize(s.Serialize(routine));
+      EXPECT_EQ(r.name, routine.name);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+               .count() /
+           kIterations;
+  };
+  auto json_ns = time_round_trips(*json_serializer);
+  auto binary_ns = time_round_trips(*serializer);
+
+  RecordProperty("json_bytes", static_cast<int>(json.size()));
+  RecordProperty("binary_bytes", static_cast<int>(binary.size()));
+  RecordProperty("json_round_trip_ns", static_cast<int>(json_ns));
+  RecordProperty("binary_round_trip_ns", static_cast<int>(binary_ns));
+  std::cout << "json: " << json.size() << " bytes, " << json_ns
+            << " ns/round-trip; binary: " << binary.size() << " bytes, "
+            << binary_ns << " ns/round-trip" << std::endl;
+}
+
 } // namespace
 } // namespace cdfw
\ No newline at end of file
@@ -0,0 +1,313 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/routine_store.h"
+#include "cdfw/core/routine.h"
+#include "cdfw/core/station.h"
+#include "test/mocks/routine_store.h"
+#include "test/mocks/vfs.h"
+#include "test/support/alloc_tracker.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cdfw {
+namespace {
+class RoutineStoreTests : public ::testing::Test {
+protected:
+  MockRoutineStoreFiles::Data data;
+  vfs::Path dir = "/mp/horolibre/routines";
+  std::unique_ptr<RoutineStore> store = CreateStore();
+
+  std::unique_ptr<RoutineStore> CreateStore(std::size_t cache_capacity = 2) {
+    return RoutineStore::Create(
+        dir, std::make_shared<MockRoutineStoreFiles>(data), cache_capacity);
+  }
+
+  static Routine GetNamed(const std::string &name) {
+    Routine routine = Routine::GetDefault();
+    routine.name = name;
+    return routine;
+  }
+};
+
+TEST_F(RoutineStoreTests, Load_Empty) {
+  store->Load();
+  EXPECT_TRUE(store->List().empty());
+  EXPECT_EQ(data.files.count(dir / "index.bin"), 1);
+}
+
+TEST_F(RoutineStoreTests, Put_And_Get) {
+  store->Load();
+  RoutineId id = store->Put(GetNamed("Routine A"));
+  ASSERT_NE(id, RoutineStore::kInvalidId);
+
+  ASSERT_EQ(store->List().size(), 1);
+  EXPECT_EQ(store->List()[0].id, id);
+  EXPECT_EQ(store->List()[0].name, "Routine A");
+
+  Routine routine = Routine::GetDisabled();
+  EXPECT_TRUE(store->Get(id, routine));
+  EXPECT_EQ(routine.name, "Routine A");
+  EXPECT_EQ(routine.dry_station.time, 360);
+}
+
+TEST_F(RoutineStoreTests, Put_CommitsRecordWithIndex) {
+  store->Load();
+  data.Reset();
+  RoutineId id = store->Put(GetNamed("Routine A"));
+  EXPECT_EQ(data.commits, 1);
+  EXPECT_EQ(data.writes, 2);
+
+  EXPECT_TRUE(store->Put(id, GetNamed("Routine B")));
+  EXPECT_EQ(data.commits, 2);
+  EXPECT_EQ(data.writes, 4);
+}
+
+TEST_F(RoutineStoreTests, Get_UnknownId) {
+  store->Load();
+  Routine routine = Routine::GetDisabled();
+  EXPECT_FALSE(store->Get(42, routine));
+  EXPECT_EQ(routine.name, "Disabled");
+}
+
+TEST_F(RoutineStoreTests, Put_Replace) {
+  store->Load();
+  RoutineId id = store->Put(GetNamed("Routine A"));
+  auto hash = store->List()[0].hash;
+
+  EXPECT_TRUE(store->Put(id, GetNamed("Routine B")));
+  ASSERT_EQ(store->List().size(), 1);
+  EXPECT_EQ(store->List()[0].name, "Routine B");
+  EXPECT_NE(store->List()[0].hash, hash);
+
+  Routine routine = Routine::GetDisabled();
+  EXPECT_TRUE(store->Get(id, routine));
+  EXPECT_EQ(routine.name, "Routine B");
+
+  EXPECT_FALSE(store->Put(id + 1, GetNamed("Routine C")));
+}
+
+TEST_F(RoutineStoreTests, Delete) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  RoutineId b = store->Put(GetNamed("Routine B"));
+
+  EXPECT_TRUE(store->Delete(a));
+  EXPECT_FALSE(store->Delete(a));
+  ASSERT_EQ(store->List().size(), 1);
+  EXPECT_EQ(store->List()[0].id, b);
+
+  Routine routine = Routine::GetDisabled();
+  EXPECT_FALSE(store->Get(a, routine));
+  EXPECT_TRUE(store->Get(b, routine));
+}
+
+TEST_F(RoutineStoreTests, Delete_KeepsRecordIfIndexWriteFails) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  RoutineId b = store->Put(GetNamed("Routine B"));
+  const auto files = data.files;
+
+  data.fail_writes = true;
+  EXPECT_FALSE(store->Delete(a));
+  EXPECT_EQ(data.files, files);
+  ASSERT_EQ(store->List().size(), 2);
+  EXPECT_EQ(store->List()[0].id, a);
+  EXPECT_EQ(store->List()[1].id, b);
+
+  data.fail_writes = false;
+  EXPECT_TRUE(store->Delete(a));
+  ASSERT_EQ(store->List().size(), 1);
+}
+
+TEST_F(RoutineStoreTests, Put_FailedWriteChangesNothing) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  const auto files = data.files;
+
+  data.fail_writes = true;
+  EXPECT_EQ(store->Put(GetNamed("Routine B")), RoutineStore::kInvalidId);
+  EXPECT_FALSE(store->Put(a, GetNamed("Routine C")));
+  EXPECT_EQ(data.files, files);
+  ASSERT_EQ(store->List().size(), 1);
+  EXPECT_EQ(store->List()[0].name, "Routine A");
+  Routine routine = Routine::GetDisabled();
+  EXPECT_TRUE(store->Get(a, routine));
+  EXPECT_EQ(routine.name, "Routine A");
+
+  // The id of the failed Put() is handed out again.
+  data.fail_writes = false;
+  EXPECT_EQ(store->Put(GetNamed("Routine B")), a + 1);
+}
+
+TEST_F(RoutineStoreTests, Ids_NotReused) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  store->Delete(a);
+  RoutineId b = store->Put(GetNamed("Routine B"));
+  EXPECT_NE(a, b);
+
+  // Also holds across a reboot.
+  store = CreateStore();
+  store->Load();
+  store->Delete(b);
+  EXPECT_GT(store->Put(GetNamed("Routine C")), b);
+}
+
+TEST_F(RoutineStoreTests, Load_ReadsOnlyIndex) {
+  store->Load();
+  for (int i = 0; i < 10; ++i) {
+    store->Put(GetNamed("Routine " + std::to_string(i)));
+  }
+
+  data.reads = 0;
+  store = CreateStore();
+  store->Load();
+
+  // Reads for the header, the size check and the entries; no record is
+  // opened.
+  EXPECT_EQ(data.reads, 3);
+  ASSERT_EQ(store->List().size(), 10);
+  EXPECT_EQ(store->List()[3].name, "Routine 3");
+}
+
+TEST_F(RoutineStoreTests, Load_RebuildsMissingIndex) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  RoutineId b = store->Put(GetNamed("Routine B"));
+  data.files.erase(dir / "index.bin");
+
+  store = CreateStore();
+  store->Load();
+  ASSERT_EQ(store->List().size(), 2);
+  EXPECT_EQ(store->List()[0].id, a);
+  EXPECT_EQ(store->List()[1].id, b);
+  EXPECT_EQ(store->List()[1].name, "Routine B");
+  EXPECT_EQ(data.files.count(dir / "index.bin"), 1);
+}
+
+TEST_F(RoutineStoreTests, Load_RebuildsCorruptIndex) {
+  store->Load();
+  store->Put(GetNamed("Routine A"));
+  data.files[dir / "index.bin"][20] ^= 0xFF;
+
+  store = CreateStore();
+  store->Load();
+  ASSERT_EQ(store->List().size(), 1);
+  EXPECT_EQ(store->List()[0].name, "Routine A");
+}
+
+TEST_F(RoutineStoreTests, Load_RebuildsIndexWithBadCount) {
+  store->Load();
+  store->Put(GetNamed("Routine A"));
+  const auto index = data.files[dir / "index.bin"];
+
+  // Counts far past the file's end, beyond the cap, or short of the file are
+  // all rebuilt from the records.
+  for (std::uint32_t count : {0xFFFFFFFFu, 0x10001u, 0u}) {
+    auto corrupt = index;
+    for (std::size_t i = 0; i < 4; ++i) {
+      corrupt[8 + i] = static_cast<std::uint8_t>(count >> (8 * i));
+    }
+    data.files[dir / "index.bin"] = corrupt;
+
+    store = CreateStore();
+    store->Load();
+    ASSERT_EQ(store->List().size(), 1) << count;
+    EXPECT_EQ(store->List()[0].name, "Routine A");
+  }
+}
+
+TEST_F(RoutineStoreTests, Rebuild_SkipsForeignAndCorruptFiles) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  RoutineId b = store->Put(GetNamed("Routine B"));
+  data.files[dir / "notes.txt"] = {1, 2, 3};
+  data.files[dir / "zzzzzzzz.rt"] = {1, 2, 3};
+  ASSERT_EQ(b, 2);
+  data.files[dir / "00000002.rt"][12] ^= 0xFF;
+
+  store->Rebuild();
+  ASSERT_EQ(store->List().size(), 1);
+  EXPECT_EQ(store->List()[0].id, a);
+}
+
+TEST_F(RoutineStoreTests, Get_CachesRoutines) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  RoutineId b = store->Put(GetNamed("Routine B"));
+
+  // Fresh store, empty cache.
+  store = CreateStore();
+  store->Load();
+  data.reads = 0;
+
+  Routine routine = Routine::GetDisabled();
+  EXPECT_TRUE(store->Get(a, routine));
+  EXPECT_TRUE(store->Get(a, routine));
+  EXPECT_TRUE(store->Get(b, routine));
+  EXPECT_TRUE(store->Get(b, routine));
+  EXPECT_EQ(data.reads, 2);
+}
+
+TEST_F(RoutineStoreTests, Get_CachedDoesNotAllocate) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  store->Load();
+  RoutineId id = store->Put(GetNamed("Routine A"));
+
+  Routine routine = Routine::GetDisabled();
+  test::AllocationCounter counter;
+  EXPECT_TRUE(store->Get(id, routine));
+  EXPECT_EQ(counter.Allocations(), 0);
+}
+
+TEST_F(RoutineStoreTests, Get_EvictsLeastRecentlyUsed) {
+  store->Load();
+  RoutineId a = store->Put(GetNamed("Routine A"));
+  RoutineId b = store->Put(GetNamed("Routine B"));
+  RoutineId c = store->Put(GetNamed("Routine C"));
+
+  // Capacity is two; `c` and `b` are cached. Touch `b` then load `a`, which
+  // should evict `c`.
+  Routine routine = Routine::GetDisabled();
+  data.reads = 0;
+  EXPECT_TRUE(store->Get(b, routine));
+  EXPECT_EQ(data.reads, 0);
+  EXPECT_TRUE(store->Get(a, routine));
+  EXPECT_EQ(data.reads, 1);
+  EXPECT_TRUE(store->Get(b, routine));
+  EXPECT_EQ(data.reads, 1);
+  EXPECT_TRUE(store->Get(c, routine));
+  EXPECT_EQ(data.reads, 2);
+  EXPECT_EQ(routine.name, "Routine C");
+}
+
+TEST(RoutineStoreFilesTests, WritesAtomically) {
+  vfs::MockVolume::Data data;
+  auto files = RoutineStoreFiles::Create(
+      vfs::Volume::Create(std::make_unique<vfs::MockVolume>(data)));
+  vfs::Path dir = "/mp/routines";
+  data.paths.insert(dir);
+
+  std::uint8_t a[] = {1, 2, 3};
+  std::uint8_t b[] = {4, 5};
+  EXPECT_TRUE(files->Write({{dir / "a", a}, {dir / "b", b}}));
+  EXPECT_EQ(data.syncs, 3); // One batch.
+
+  std::uint8_t out[4] = {};
+  EXPECT_EQ(files->Read(dir / "a", 1, out, sizeof(out)), 2);
+  EXPECT_EQ(out[1], 3);
+  EXPECT_EQ(files->List(dir).size(), 2);
+  EXPECT_TRUE(files->Remove(dir / "b"));
+  EXPECT_FALSE(data.paths.count(dir / "b"));
+}
+} // namespace
+} // namespace cdfw
@@ -0,0 +1,220 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/run_log.h"
+#include "test/mocks/vfs.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+namespace {
+constexpr std::size_t kRecordsPerSegment = 16;
+
+class RunLogTests : public ::testing::Test {
+protected:
+  vfs::MockVolume::Data data;
+  std::shared_ptr<vfs::Volume> volume =
+      std::make_shared<vfs::MockVolume>(data);
+  vfs::Path dir = "/mp/horolibre/data/runs";
+  RunRetentionPolicy policy;
+  std::unique_ptr<RunLog> log = CreateLog();
+
+  void SetUp() override final {
+    volume->CreateDirs("/mp/horolibre/data");
+    ASSERT_TRUE(log->Load());
+  }
+
+  std::unique_ptr<RunLog> CreateLog() {
+    return RunLog::Create(volume, dir, policy, kRecordsPerSegment);
+  }
+
+  static RunRecord GetRun(std::uint32_t start_time) {
+    RunRecord run{};
+    run.routine_id = 7;
+    run.start_time = start_time;
+    run.end_time = start_time + 900;
+    for (std::size_t i = 0; i < RunRecord::kStations; ++i) {
+      run.station_durations[i] = 60 * (i + 1);
+    }
+    run.abort_reason = RunAbortReason::kNONE;
+    return run;
+  }
+
+  // Appends runs starting every 100 seconds from `start_time`.
+  void AppendRuns(std::size_t n, std::uint32_t start_time = 1000) {
+    for (std::size_t i = 0; i < n; ++i) {
+      RunRecord run = GetRun(start_time + 100 * static_cast<std::uint32_t>(i));
+      ASSERT_TRUE(log->Append(run));
+    }
+  }
+};
+
+TEST_F(RunLogTests, Load_Empty) {
+  EXPECT_EQ(log->Count(), 0);
+  EXPECT_TRUE(data.paths.count(dir));
+
+  std::vector<RunRecord> runs;
+  EXPECT_EQ(log->Last(5, runs), 0);
+  EXPECT_TRUE(runs.empty());
+}
+
+TEST_F(RunLogTests, Append_SingleWrite) {
+  RunRecord run = GetRun(1000);
+  run.abort_reason = RunAbortReason::kUSER;
+  data.writes = 0;
+  data.syncs = 0;
+  ASSERT_TRUE(log->Append(run));
+  EXPECT_EQ(run.sequence, 1);
+  EXPECT_EQ(data.writes, 1);
+  EXPECT_EQ(data.syncs, 1);
+  EXPECT_EQ(data.files[dir / "00000001.log"].size(), RunLog::kRecordSize);
+
+  std::vector<RunRecord> runs;
+  ASSERT_EQ(log->Last(1, runs), 1);
+  EXPECT_EQ(runs[0].sequence, 1);
+  EXPECT_EQ(runs[0].routine_id, 7);
+  EXPECT_EQ(runs[0].start_time, 1000);
+  EXPECT_EQ(runs[0].end_time, 1900);
+  EXPECT_EQ(runs[0].station_durations[4], 300);
+  EXPECT_EQ(runs[0].abort_reason, RunAbortReason::kUSER);
+}
+
+TEST_F(RunLogTests, Append_RollsOverAndSealsSegments) {
+  AppendRuns(2 * kRecordsPerSegment + 1);
+  EXPECT_EQ(log->Count(), 2 * kRecordsPerSegment + 1);
+  EXPECT_TRUE(data.files.count(dir / "00000001.log"));
+  EXPECT_TRUE(data.files.count(dir / "00000001.idx"));
+  EXPECT_TRUE(data.files.count(dir / "00000011.log"));
+  EXPECT_TRUE(data.files.count(dir / "00000011.idx"));
+  EXPECT_TRUE(data.files.count(dir / "00000021.log"));
+  EXPECT_FALSE(data.files.count(dir / "00000021.idx"));
+}
+
+TEST_F(RunLogTests, Last_NewestFirstFromTheTail) {
+  AppendRuns(2 * kRecordsPerSegment + 4);
+
+  data.reads = 0;
+  std::vector<RunRecord> runs;
+  ASSERT_EQ(log->Last(3, runs), 3);
+  EXPECT_EQ(runs[0].sequence, 36);
+  EXPECT_EQ(runs[1].sequence, 35);
+  EXPECT_EQ(runs[2].sequence, 34);
+  EXPECT_EQ(data.reads, 1);
+
+  // Reaching past the tail reads the segments before it.
+  ASSERT_EQ(log->Last(6, runs), 6);
+  EXPECT_EQ(runs[5].sequence, 31);
+  ASSERT_EQ(log->Last(100, runs), 36);
+  EXPECT_EQ(runs.back().sequence, 1);
+}
+
+TEST_F(RunLogTests, Load_Reopens) {
+  AppendRuns(kRecordsPerSegment + 3);
+
+  log = CreateLog();
+  ASSERT_TRUE(log->Load());
+  EXPECT_EQ(log->Count(), kRecordsPerSegment + 3);
+  RunRecord run = GetRun(9000);
+  ASSERT_TRUE(log->Append(run));
+  EXPECT_EQ(run.sequence, kRecordsPerSegment + 4);
+}
+
+TEST_F(RunLogTests, Load_DropsTornRecord) {
+  AppendRuns(3);
+  auto &segment = data.files[dir / "00000001.log"];
+  segment[2 * RunLog::kRecordSize + 10] ^= 0xff;
+
+  log = CreateLog();
+  ASSERT_TRUE(log->Load());
+  EXPECT_EQ(log->Count(), 2);
+
+  // The next append takes the torn record's place.
+  RunRecord run = GetRun(9000);
+  ASSERT_TRUE(log->Append(run));
+  EXPECT_EQ(run.sequence, 3);
+  EXPECT_EQ(segment.size(), 3 * RunLog::kRecordSize);
+  std::vector<RunRecord> runs;
+  ASSERT_EQ(log->Last(1, runs), 1);
+  EXPECT_EQ(runs[0].start_time, 9000);
+}
+
+TEST_F(RunLogTests, Between_ReadsMatchingSectors) {
+  // Runs start at 1000, 1100, ..., 4100.
+  AppendRuns(2 * kRecordsPerSegment);
+  log = CreateLog();
+  ASSERT_TRUE(log->Load());
+
+  data.reads = 0;
+  std::vector<RunRecord> runs;
+  ASSERT_EQ(log->Between(1250, 1550, runs), 3);
+  EXPECT_EQ(runs[0].start_time, 1300);
+  EXPECT_EQ(runs[2].start_time, 1500);
+  // The first segment's index, then its first sector.
+  EXPECT_EQ(data.reads, 2);
+
+  data.reads = 0;
+  ASSERT_EQ(log->Between(3900, 5000, runs), 3);
+  EXPECT_EQ(runs[0].sequence, 30);
+  EXPECT_EQ(data.reads, 1); // The tail's index is in RAM.
+
+  EXPECT_EQ(log->Between(5000, 6000, runs), 0);
+  EXPECT_EQ(log->Between(2000, 1000, runs), 0);
+}
+
+TEST_F(RunLogTests, Load_RebuildsCorruptIndex) {
+  AppendRuns(kRecordsPerSegment + 1);
+  auto &index = data.files[dir / "00000001.idx"];
+  index[8] ^= 0xff;
+
+  log = CreateLog();
+  ASSERT_TRUE(log->Load());
+  EXPECT_EQ(log->Count(), kRecordsPerSegment + 1);
+  std::vector<RunRecord> runs;
+  EXPECT_EQ(log->Between(1000, 1400, runs), 5);
+
+  // The rebuilt index was written back.
+  log = CreateLog();
+  data.writes = 0;
+  ASSERT_TRUE(log->Load());
+  EXPECT_EQ(data.writes, 0);
+}
+
+TEST_F(RunLogTests, Compact_MaxSegments) {
+  policy.max_segments = 1;
+  log = CreateLog();
+  ASSERT_TRUE(log->Load());
+  AppendRuns(3 * kRecordsPerSegment + 1);
+
+  EXPECT_EQ(log->Compact(0), 2);
+  EXPECT_EQ(log->Count(), kRecordsPerSegment + 1);
+  EXPECT_FALSE(data.files.count(dir / "00000001.log"));
+  EXPECT_FALSE(data.files.count(dir / "00000001.idx"));
+  EXPECT_FALSE(data.files.count(dir / "00000011.log"));
+  EXPECT_TRUE(data.files.count(dir / "00000021.log"));
+  EXPECT_EQ(log->Compact(0), 0);
+}
+
+TEST_F(RunLogTests, Compact_MaxAge) {
+  policy.max_age_s = 1000;
+  log = CreateLog();
+  ASSERT_TRUE(log->Load());
+  // Segments start at 1000, 2600 and 4200.
+  AppendRuns(2 * kRecordsPerSegment + 1);
+
+  EXPECT_EQ(log->Compact(3000), 0);
+  EXPECT_EQ(log->Compact(3600), 1);
+  // The tail stays, however old.
+  EXPECT_EQ(log->Compact(100000), 1);
+  EXPECT_EQ(log->Count(), 1);
+}
+} // namespace
+} // namespace cdfw
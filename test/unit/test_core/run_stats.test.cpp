@@ -0,0 +1,183 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/run_stats.h"
+#include "cdfw/core/run_log.h"
+#include "test/mocks/vfs.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cdfw {
+namespace {
+constexpr std::uint32_t kDay = 24 * 60 * 60;
+// 2024-01-01T00:00:00Z.
+constexpr std::uint32_t kJan1 = 1704067200;
+
+RunRecord GetRun(RoutineId routine_id, std::uint32_t start_time,
+                 std::uint32_t cycle_s,
+                 RunAbortReason abort_reason = RunAbortReason::kNONE) {
+  RunRecord run{};
+  run.routine_id = routine_id;
+  run.start_time = start_time;
+  run.end_time = start_time + cycle_s;
+  run.abort_reason = abort_reason;
+  return run;
+}
+
+TEST(RunAggregateTests, Add) {
+  RunAggregate aggregate{};
+  aggregate.Add(GetRun(1, kJan1, 600));
+  aggregate.Add(GetRun(1, kJan1, 1200));
+  aggregate.Add(GetRun(1, kJan1, 30, RunAbortReason::kUSER));
+  aggregate.Add(GetRun(1, kJan1, 900));
+
+  EXPECT_EQ(aggregate.runs, 4);
+  EXPECT_EQ(aggregate.aborts, 1);
+  EXPECT_EQ(aggregate.Completed(), 3);
+  EXPECT_DOUBLE_EQ(aggregate.AbortRate(), 0.25);
+  EXPECT_DOUBLE_EQ(aggregate.MeanCycleS(), 900.0);
+  EXPECT_EQ(aggregate.min_cycle_s, 600);
+  EXPECT_EQ(aggregate.max_cycle_s, 1200);
+  EXPECT_EQ(aggregate.PercentileCycleS(0), 600);
+  EXPECT_EQ(aggregate.PercentileCycleS(100), 1200);
+}
+
+TEST(RunAggregateTests, Empty) {
+  RunAggregate aggregate{};
+  EXPECT_DOUBLE_EQ(aggregate.AbortRate(), 0.0);
+  EXPECT_DOUBLE_EQ(aggregate.MeanCycleS(), 0.0);
+  EXPECT_EQ(aggregate.PercentileCycleS(50), 0);
+}
+
+TEST(RunAggregateTests, PercentileWithinABucket) {
+  RunAggregate aggregate{};
+  for (std::uint32_t i = 1; i <= 100; ++i) {
+    aggregate.Add(GetRun(1, kJan1, 10 * i));
+  }
+
+  // Each estimate is within a bucket of the true value.
+  for (double percent : {10.0, 50.0, 90.0, 99.0}) {
+    double actual = 10.0 * percent;
+    std::size_t bucket = 0;
+    while (actual > RunAggregate::BucketLimit(bucket)) {
+      ++bucket;
+    }
+    double lower = bucket == 0 ? 0 : RunAggregate::BucketLimit(bucket - 1);
+    double upper = RunAggregate::BucketLimit(bucket);
+    EXPECT_GE(aggregate.PercentileCycleS(percent), lower) << percent;
+    EXPECT_LE(aggregate.PercentileCycleS(percent), upper) << percent;
+  }
+}
+
+class RunStatsTests : public ::testing::Test {
+protected:
+  vfs::MockVolume::Data data;
+  std::shared_ptr<vfs::Volume> volume =
+      std::make_shared<vfs::MockVolume>(data);
+  vfs::Path dir = "/mp/horolibre/data/stats";
+  std::unique_ptr<RunStats> stats = RunStats::Create(volume, dir);
+
+  void SetUp() override final {
+    volume->CreateDirs("/mp/horolibre/data");
+    ASSERT_TRUE(stats->Load());
+  }
+
+  std::string ReadFile(const vfs::Path &path) {
+    const auto &bytes = data.files[path];
+    return std::string(bytes.begin(), bytes.end());
+  }
+};
+
+TEST_F(RunStatsTests, Load_Empty) {
+  EXPECT_TRUE(data.paths.count(dir));
+  EXPECT_TRUE(stats->Totals().empty());
+}
+
+TEST_F(RunStatsTests, Record_TwoRowWrites) {
+  ASSERT_TRUE(stats->Record(GetRun(3, kJan1, 600)));
+  for (std::uint32_t i = 1; i <= 50; ++i) {
+    data.writes = 0;
+    ASSERT_TRUE(stats->Record(GetRun(3, kJan1 + 60 * i, 600)));
+    EXPECT_EQ(data.writes, 2);
+  }
+  EXPECT_EQ(data.files[dir / "totals.bin"].size(), 128);
+  EXPECT_EQ(data.files[dir / "days.bin"].size(), 128);
+
+  auto totals = stats->Totals();
+  ASSERT_EQ(totals.size(), 1);
+  EXPECT_EQ(totals[0].routine_id, 3);
+  EXPECT_EQ(totals[0].day, RunAggregate::kAllTime);
+  EXPECT_EQ(totals[0].runs, 51);
+}
+
+TEST_F(RunStatsTests, Record_NewDayAppendsARow) {
+  ASSERT_TRUE(stats->Record(GetRun(1, kJan1, 600)));
+  ASSERT_TRUE(stats->Record(GetRun(2, kJan1 + 60, 600)));
+  ASSERT_TRUE(stats->Record(GetRun(1, kJan1 + kDay, 600)));
+  EXPECT_EQ(data.files[dir / "totals.bin"].size(), 2 * 128);
+  EXPECT_EQ(data.files[dir / "days.bin"].size(), 3 * 128);
+}
+
+TEST_F(RunStatsTests, Load_Reopens) {
+  ASSERT_TRUE(stats->Record(GetRun(2, kJan1, 600)));
+  ASSERT_TRUE(stats->Record(GetRun(1, kJan1, 900, RunAbortReason::kPOWER)));
+  ASSERT_TRUE(stats->Record(GetRun(2, kJan1 + 60, 1200)));
+
+  stats = RunStats::Create(volume, dir);
+  ASSERT_TRUE(stats->Load());
+  auto totals = stats->Totals();
+  ASSERT_EQ(totals.size(), 2);
+  EXPECT_EQ(totals[0].routine_id, 1);
+  EXPECT_EQ(totals[0].aborts, 1);
+  EXPECT_EQ(totals[1].routine_id, 2);
+  EXPECT_EQ(totals[1].runs, 2);
+  EXPECT_EQ(totals[1].total_cycle_s, 1800);
+
+  // The day rows carry on where they left off.
+  ASSERT_TRUE(stats->Record(GetRun(2, kJan1 + 120, 600)));
+  EXPECT_EQ(data.files[dir / "days.bin"].size(), 2 * 128);
+}
+
+TEST_F(RunStatsTests, Load_OverwritesOrphanedDayRow) {
+  ASSERT_TRUE(stats->Record(GetRun(1, kJan1, 600)));
+  // A power cut after a new day's row was written, before the totals were.
+  auto &days = data.files[dir / "days.bin"];
+  days.resize(2 * 128, 0xee);
+
+  stats = RunStats::Create(volume, dir);
+  ASSERT_TRUE(stats->Load());
+  ASSERT_TRUE(stats->Record(GetRun(1, kJan1 + kDay, 600)));
+  EXPECT_EQ(days.size(), 2 * 128);
+  EXPECT_EQ(stats->Totals()[0].runs, 2);
+}
+
+TEST_F(RunStatsTests, ExportCsv) {
+  ASSERT_TRUE(stats->Record(GetRun(1, kJan1, 600)));
+  ASSERT_TRUE(
+      stats->Record(GetRun(1, kJan1 + 60, 600, RunAbortReason::kUSER)));
+  ASSERT_TRUE(
+      stats->Record(GetRun(2, kJan1 + kDay, 30, RunAbortReason::kERROR)));
+  ASSERT_TRUE(stats->Record(GetRun(1, kJan1 + 59 * kDay, 1200)));
+
+  ASSERT_TRUE(stats->ExportCsv("/mp/export.csv"));
+  EXPECT_EQ(ReadFile("/mp/export.csv"),
+            "routine_id,date,runs,aborts,abort_rate,mean_cycle_s,p50_cycle_s,"
+            "p90_cycle_s,min_cycle_s,max_cycle_s\n"
+            "1,all,3,1,0.3333,900.0,600,1200,600,1200\n"
+            "2,all,1,1,1.0000,,,,,\n"
+            "1,2024-01-01,2,1,0.5000,600.0,600,600,600,600\n"
+            "2,2024-01-02,1,1,1.0000,,,,,\n"
+            "1,2024-02-29,1,0,0.0000,1200.0,1200,1200,1200,1200\n");
+}
+} // namespace
+} // namespace cdfw
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 // C++ Standard Library Headers
+#include <sstream>
 #include <string>
 
 namespace cdfw {
@@ -16,6 +17,7 @@ namespace {
 class StationSerializerTests : public ::testing::Test {
 protected:
   std::shared_ptr<StationSerializer> serializer = StationSerializer::Create();
+  RoutineError error{};
 };
 
 TEST(WetStationTests, Disabled) {
@@ -107,7 +109,7 @@ TEST_F(StationSerializerTests, Serialize_DryStation) {
 TEST_F(StationSerializerTests, Deserialize_WetStation_Disabled) {
   std::string input =
       R"({"name":"wet_configured","enabled":false,"time":1000,"agitation":3})";
-  auto station = serializer->DeserializeWet(input);
+  auto station = serializer->DeserializeWet(input, error);
 
   EXPECT_EQ(station.name, "Disabled");
   EXPECT_FALSE(station.enabled);
@@ -119,7 +121,7 @@ TEST_F(StationSerializerTests, Deserialize_WetStation_Configured) {
   // WetStation::AgitationLevel::kNONE
   std::string input =
       R"({"name":"wet_agg_none","enabled":true,"time":10,"agitation":0})";
-  auto station = serializer->DeserializeWet(input);
+  auto station = serializer->DeserializeWet(input, error);
 
   EXPECT_EQ(station.name, "wet_agg_none");
   EXPECT_TRUE(station.enabled);
@@ -128,7 +130,7 @@ TEST_F(StationSerializerTests, Deserialize_WetStation_Configured) {
 
   // WetStation::AgitationLevel::kLOW
   input = R"({"name":"wet_agg_low","enabled":true,"time":20,"agitation":1})";
-  station = serializer->DeserializeWet(input);
+  station = serializer->DeserializeWet(input, error);
 
   EXPECT_EQ(station.name, "wet_agg_low");
   EXPECT_TRUE(station.enabled);
@@ -137,7 +139,7 @@ TEST_F(StationSerializerTests, Deserialize_WetStation_Configured) {
 
   // WetStation::AgitationLevel::kMEDIUM
   input = R"({"name":"wet_agg_med","enabled":true,"time":30,"agitation":2})";
-  station = serializer->DeserializeWet(input);
+  station = serializer->DeserializeWet(input, error);
 
   EXPECT_EQ(station.name, "wet_agg_med");
   EXPECT_TRUE(station.enabled);
@@ -146,7 +148,7 @@ TEST_F(StationSerializerTests, Deserialize_WetStation_Configured) {
 
   // WetStation::AgitationLevel::kHIGH
   input = R"({"name":"wet_agg_high","enabled":true,"time":40,"agitation":3})";
-  station = serializer->DeserializeWet(input);
+  station = serializer->DeserializeWet(input, error);
 
   EXPECT_EQ(station.name, "wet_agg_high");
   EXPECT_TRUE(station.enabled);
@@ -157,7 +159,7 @@ TEST_F(StationSerializerTests, Deserialize_WetStation_Configured) {
 TEST_F(StationSerializerTests, Deserialize_DryStation_Disabled) {
   std::string input =
       R"({"name":"dry_configured","enabled":false,"time":1000,"spin":1})";
-  auto station = serializer->DeserializeDry(input);
+  auto station = serializer->DeserializeDry(input, error);
 
   EXPECT_EQ(station.name, "Disabled");
   EXPECT_FALSE(station.enabled);
@@ -169,7 +171,7 @@ TEST_F(StationSerializerTests, Deserialize_DryStation_Configured) {
   // DryStation::SpinType::kNONE
   std::string input =
       R"({"name":"dry_spin_none","enabled":true,"time":20,"spin":0})";
-  auto station = serializer->DeserializeDry(input);
+  auto station = serializer->DeserializeDry(input, error);
 
   EXPECT_EQ(station.name, "dry_spin_none");
   EXPECT_TRUE(station.enabled);
@@ -178,7 +180,7 @@ TEST_F(StationSerializerTests, Deserialize_DryStation_Configured) {
 
   // DryStation::SpinType::kUNIDIRECTIONAL
   input = R"({"name":"dry_spin_uni","enabled":true,"time":40,"spin":1})";
-  station = serializer->DeserializeDry(input);
+  station = serializer->DeserializeDry(input, error);
 
   EXPECT_EQ(station.name, "dry_spin_uni");
   EXPECT_TRUE(station.enabled);
@@ -187,7 +189,7 @@ TEST_F(StationSerializerTests, Deserialize_DryStation_Configured) {
 
   // DryStation::SpinType::kBIDIRECTIONAL
   input = R"({"name":"dry_spin_bi","enabled":true,"time":60,"spin":2})";
-  station = serializer->DeserializeDry(input);
+  station = serializer->DeserializeDry(input, error);
 
   EXPECT_EQ(station.name, "dry_spin_bi");
   EXPECT_TRUE(station.enabled);
@@ -195,10 +197,34 @@ TEST_F(StationSerializerTests, Deserialize_DryStation_Configured) {
   EXPECT_EQ(station.spin, DryStation::SpinType::kBIDIRECTIONAL);
 }
 
+TEST_F(StationSerializerTests, Deserialize_WetStation_Stream) {
+  std::istringstream input(
+      R"({"name":"wet_stream","notes":"unused","enabled":true,"time":30,)"
+      R"("agitation":2,"extra":{"a":[1,2,3]}})");
+  auto station = serializer->DeserializeWet(input, error);
+
+  EXPECT_EQ(station.name, "wet_stream");
+  EXPECT_TRUE(station.enabled);
+  EXPECT_EQ(station.time, 30);
+  EXPECT_EQ(station.agitation, WetStation::AgitationLevel::kMEDIUM);
+}
+
+TEST_F(StationSerializerTests, Deserialize_DryStation_Stream) {
+  std::istringstream input(
+      R"({"name":"dry_stream","enabled":true,"time":60,"spin":1,"x":"y"})");
+  auto station = serializer->DeserializeDry(input, error);
+
+  EXPECT_EQ(station.name, "dry_stream");
+  EXPECT_TRUE(station.enabled);
+  EXPECT_EQ(station.time, 60);
+  EXPECT_EQ(station.spin, DryStation::SpinType::kUNIDIRECTIONAL);
+}
+
 TEST_F(StationSerializerTests, RoundTrip_WetStation) {
   auto expected = WetStation::GetConfigured("Clean", 123,
                                             WetStation::AgitationLevel::kHIGH);
-  auto actual = serializer->DeserializeWet(serializer->Serialize(expected));
+  auto actual =
+      serializer->DeserializeWet(serializer->Serialize(expected), error);
 
   EXPECT_EQ(actual.name, expected.name);
   EXPECT_EQ(actual.enabled, expected.enabled);
@@ -209,7 +235,8 @@ TEST_F(StationSerializerTests, RoundTrip_WetStation) {
 TEST_F(StationSerializerTests, RoundTrip_DryStation) {
   auto expected = DryStation::GetConfigured(
       "Dry", 123, DryStation::SpinType::kUNIDIRECTIONAL);
-  auto actual = serializer->DeserializeDry(serializer->Serialize(expected));
+  auto actual =
+      serializer->DeserializeDry(serializer->Serialize(expected), error);
 
   EXPECT_EQ(actual.name, expected.name);
   EXPECT_EQ(actual.enabled, expected.enabled);
@@ -217,5 +244,44 @@ TEST_F(StationSerializerTests, RoundTrip_DryStation) {
   EXPECT_EQ(actual.spin, expected.spin);
 }
 
+TEST_F(StationSerializerTests, Deserialize_RejectsInvalid) {
+  struct Case {
+    const char *json;
+    RoutineError::Code code;
+    const char *path;
+  };
+  const Case cases[] = {
+      {R"({"name":"w","enabled":true,"time":10,"agitation":4})",
+       RoutineError::Code::kOUT_OF_RANGE, "agitation"},
+      {R"({"enabled":true,"time":10,"agitation":1})",
+       RoutineError::Code::kMISSING, "name"},
+      {R"({"name":"w","enabled":true,"agitation":1})",
+       RoutineError::Code::kMISSING, "time"},
+      {R"({"name":"w","enabled":true,"time":3601,"agitation":1})",
+       RoutineError::Code::kOUT_OF_RANGE, "time"},
+      {R"({"name":"w","enabled":true,"time":10,"spin":1})",
+       RoutineError::Code::kWRONG_STATION, ""},
+      {R"({"name":"w","enabled":true,)", RoutineError::Code::kTRUNCATED, ""},
+  };
+  for (const auto &c : cases) {
+    error = RoutineError{};
+    auto station = serializer->DeserializeWet(std::string(c.json), error);
+    EXPECT_FALSE(station.enabled) << c.json;
+    EXPECT_EQ(error.code, c.code) << c.json;
+    EXPECT_EQ(error.path, c.path) << c.json;
+  }
+}
+
+TEST_F(StationSerializerTests, Deserialize_DryStation_RejectsInvalid) {
+  std::istringstream input(
+      R"({"name":"d","enabled":true,"time":10,"spin":3})");
+  auto station = serializer->DeserializeDry(input, error);
+
+  EXPECT_FALSE(station.enabled);
+  EXPECT_EQ(station.spin, DryStation::SpinType::kNONE);
+  EXPECT_EQ(error.code, RoutineError::Code::kOUT_OF_RANGE);
+  EXPECT_EQ(error.path, "spin");
+}
+
 } // namespace
 } // namespace cdfw
\ No newline at end of file
@@ -3,7 +3,9 @@
 // the LICENSE file.
 
 // Local Headers
+#include "cdfw/core/path_buf.h"
 #include "test/mocks/vfs.h"
+#include "test/support/alloc_tracker.h"
 
 // Third Party Headers
 #include <gtest/gtest.h>
@@ -11,6 +13,10 @@
 // C++ Standard Library Headers
 #include <cstdint>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace cdfw {
 namespace vfs {
@@ -28,6 +34,10 @@ TEST(VFSVolumeTests, VolumeInfo) {
   EXPECT_EQ(volume->Capacity(), capacity);
   EXPECT_EQ(volume->Used(), used);
   EXPECT_EQ(volume->Available(), capacity - used);
+  auto stats = volume->Stats();
+  EXPECT_EQ(stats.capacity, capacity);
+  EXPECT_EQ(stats.available, capacity - used);
+  EXPECT_EQ(stats.used, used);
   EXPECT_EQ(volume->MountPoint().native(), "/mp");
   EXPECT_EQ(volume->TempDir().native(), "/mp/tmp");
 
@@ -35,6 +45,17 @@ TEST(VFSVolumeTests, VolumeInfo) {
   EXPECT_TRUE(volume->IsSD());
 }
 
+TEST(VFSVolumeTests, GenerationCountsChanges) {
+  MockVolume::Data data;
+  auto volume = Volume::Create(std::make_unique<MockVolume>(data));
+  const auto start = volume->Generation();
+
+  volume->Exists("/mp/a");
+  EXPECT_EQ(volume->Generation(), start);
+  volume->CreateDirs("/mp/a");
+  EXPECT_NE(volume->Generation(), start);
+}
+
 TEST(VFSVolumeTests, Exists) {
   MockVolume::Data data;
   Path path_exists = "/foo/bar";
@@ -96,6 +117,529 @@ TEST(VFSVolumeTests, RemoveAll) {
   EXPECT_FALSE(volume->Exists(path));
   EXPECT_FALSE(volume->Exists(path_child));
 }
+
+class VFSCacheTests : public ::testing::Test {
+protected:
+  MockVolume::Data data;
+  std::shared_ptr<Volume> volume =
+      Volume::Create(std::make_unique<MockVolume>(data));
+  Path dir = "/mp/dir";
+
+  void SetUp() override final {
+    volume->CreateDirs(dir / "sub");
+    volume->CreateDirs("/mp/other");
+  }
+
+  std::size_t ListSize(const Path &path) {
+    std::vector<DirEntry> entries;
+    EXPECT_TRUE(volume->List(path, entries));
+    return entries.size();
+  }
+};
+
+TEST_F(VFSCacheTests, Exists_Cached) {
+  EXPECT_TRUE(volume->Exists(dir));
+  EXPECT_TRUE(volume->Exists(dir));
+  EXPECT_FALSE(volume->Exists(dir / "missing"));
+  EXPECT_FALSE(volume->Exists(dir / "missing"));
+  EXPECT_EQ(data.exists_calls, 2);
+
+  auto stats = volume->CacheStats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 2);
+}
+
+TEST_F(VFSCacheTests, Exists_CachedDoesNotAllocate) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  PathBuf<> path(dir);
+  path /= "sub";
+  EXPECT_TRUE(volume->Exists(path));
+
+  test::AllocationCounter counter;
+  EXPECT_TRUE(volume->Exists(path));
+  EXPECT_EQ(counter.Allocations(), 0);
+}
+
+TEST_F(VFSCacheTests, Exists_InvalidatedByCreateAndRemove) {
+  EXPECT_FALSE(volume->Exists(dir / "a"));
+  EXPECT_FALSE(volume->Exists(dir / "a" / "b"));
+  volume->CreateDirs(dir / "a" / "b");
+  EXPECT_TRUE(volume->Exists(dir / "a"));
+  EXPECT_TRUE(volume->Exists(dir / "a" / "b"));
+
+  volume->RemoveAll(dir / "a");
+  EXPECT_FALSE(volume->Exists(dir / "a"));
+  EXPECT_FALSE(volume->Exists(dir / "a" / "b"));
+}
+
+TEST_F(VFSCacheTests, List) {
+  std::vector<DirEntry> entries;
+  EXPECT_FALSE(volume->List(dir / "missing", entries));
+  ASSERT_TRUE(volume->List(dir, entries));
+  ASSERT_EQ(entries.size(), 1);
+  EXPECT_EQ(entries[0].name, "sub");
+  EXPECT_TRUE(entries[0].is_dir);
+
+  data.list_calls = 0;
+  EXPECT_EQ(ListSize(dir), 1);
+  EXPECT_EQ(data.list_calls, 0);
+
+  // Listing a dir also answers whether it exists.
+  data.exists_calls = 0;
+  EXPECT_TRUE(volume->Exists(dir));
+  EXPECT_EQ(data.exists_calls, 0);
+}
+
+TEST_F(VFSCacheTests, List_InvalidatedByWrites) {
+  EXPECT_EQ(ListSize(dir), 1);
+  EXPECT_EQ(ListSize("/mp/other"), 0);
+
+  EXPECT_TRUE(volume->OpenWrite(dir / "file").Close());
+  EXPECT_EQ(ListSize(dir), 2);
+  EXPECT_TRUE(volume->WriteAtomic(dir / "atomic", ConstByteSpan()));
+  EXPECT_EQ(ListSize(dir), 3);
+  EXPECT_TRUE(volume->Rename(dir / "atomic", dir / "sub" / "atomic"));
+  EXPECT_EQ(ListSize(dir), 2);
+  EXPECT_EQ(ListSize(dir / "sub"), 1);
+  EXPECT_TRUE(volume->Remove(dir / "file"));
+  EXPECT_EQ(ListSize(dir), 1);
+
+  // Unrelated listings survive; reading does not invalidate.
+  data.list_calls = 0;
+  EXPECT_TRUE(volume->OpenRead(dir / "sub" / "atomic").IsOpen());
+  EXPECT_EQ(ListSize("/mp/other"), 0);
+  EXPECT_EQ(ListSize(dir / "sub"), 1);
+  EXPECT_EQ(data.list_calls, 0);
+  EXPECT_GT(volume->CacheStats().invalidations, 0);
+}
+
+TEST_F(VFSCacheTests, LookupDuringChangeNotCached) {
+  const Path file = dir / "file";
+  EXPECT_TRUE(volume->OpenWrite(file).Close());
+
+  // The lookups miss, as Remove() has already invalidated, and fetch the
+  // state from before the file is gone.
+  data.on_remove = [&] {
+    EXPECT_TRUE(volume->Exists(file));
+    EXPECT_EQ(ListSize(dir), 2);
+  };
+  EXPECT_TRUE(volume->Remove(file));
+  data.on_remove = nullptr;
+
+  EXPECT_FALSE(volume->Exists(file));
+  EXPECT_EQ(ListSize(dir), 1);
+}
+
+TEST_F(VFSCacheTests, SiblingPrefixNotInvalidated) {
+  volume->CreateDirs("/mp/dirt");
+  EXPECT_TRUE(volume->Exists("/mp/dirt"));
+  data.exists_calls = 0;
+  volume->CreateDirs(dir / "x");
+  EXPECT_TRUE(volume->Exists("/mp/dirt"));
+  EXPECT_EQ(data.exists_calls, 0);
+}
+
+class VFSFileTests : public ::testing::Test {
+protected:
+  MockVolume::Data data;
+  std::shared_ptr<Volume> volume =
+      Volume::Create(std::make_unique<MockVolume>(data));
+  Path path = "/mp/file.bin";
+  std::uint8_t buffer[File::kSectorSize * 2];
+
+  static std::vector<std::uint8_t> Pattern(std::size_t size) {
+    std::vector<std::uint8_t> bytes(size);
+    std::iota(bytes.begin(), bytes.end(), 0);
+    return bytes;
+  }
+};
+
+TEST_F(VFSFileTests, OpenRead_Missing) {
+  auto file = volume->OpenRead(path);
+  EXPECT_FALSE(file.IsOpen());
+  std::uint8_t byte;
+  EXPECT_EQ(file.Read(ByteSpan(&byte, 1)), 0);
+  EXPECT_FALSE(file.Close());
+}
+
+TEST_F(VFSFileTests, OpenWrite_NoParentDir) {
+  EXPECT_FALSE(volume->OpenWrite("/mp/missing/file.bin").IsOpen());
+  EXPECT_FALSE(volume->Exists("/mp/missing/file.bin"));
+}
+
+TEST_F(VFSFileTests, RoundTrip) {
+  auto bytes = Pattern(3000);
+  auto file = volume->OpenWrite(path, buffer);
+  ASSERT_TRUE(file.IsOpen());
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), 1000)), 1000);
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data() + 1000, 2000)), 2000);
+  EXPECT_EQ(file.Size(), 3000);
+  EXPECT_TRUE(file.Close());
+  EXPECT_TRUE(volume->Exists(path));
+  EXPECT_EQ(data.files[path], bytes);
+
+  std::vector<std::uint8_t> out(bytes.size());
+  file = volume->OpenRead(path, buffer);
+  EXPECT_EQ(file.Size(), 3000);
+  EXPECT_EQ(file.Read(ByteSpan(out.data(), 10)), 10);
+  EXPECT_EQ(file.Read(ByteSpan(out.data() + 10, out.size() - 10)),
+            out.size() - 10);
+  EXPECT_EQ(out, bytes);
+  EXPECT_EQ(file.Read(ByteSpan(out.data(), 1)), 0);
+}
+
+TEST_F(VFSFileTests, Read_SmallReadsShareSectors) {
+  data.files[path] = Pattern(File::kSectorSize * 4);
+  data.paths.insert(path);
+  auto file = volume->OpenRead(path, buffer);
+
+  // Each refill reads a whole buffer, so 64 single byte reads across the first
+  // sector cost one backend call.
+  std::uint8_t byte;
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_EQ(file.Read(ByteSpan(&byte, 1)), 1);
+    EXPECT_EQ(byte, i);
+  }
+  EXPECT_EQ(data.reads, 1);
+
+  // Refills start on a sector boundary.
+  data.reads = 0;
+  ASSERT_TRUE(file.Seek(File::kSectorSize * 3 + 7));
+  ASSERT_EQ(file.Read(ByteSpan(&byte, 1)), 1);
+  EXPECT_EQ(byte, static_cast<std::uint8_t>(File::kSectorSize * 3 + 7));
+  ASSERT_TRUE(file.Seek(File::kSectorSize * 3));
+  ASSERT_EQ(file.Read(ByteSpan(&byte, 1)), 1);
+  EXPECT_EQ(data.reads, 1);
+}
+
+TEST_F(VFSFileTests, Read_LargeReadsBypassBuffer) {
+  data.files[path] = Pattern(File::kSectorSize * 8);
+  data.paths.insert(path);
+  auto file = volume->OpenRead(path, buffer);
+
+  std::vector<std::uint8_t> out(File::kSectorSize * 4);
+  EXPECT_EQ(file.Read(ByteSpan(out.data(), out.size())), out.size());
+  EXPECT_EQ(data.reads, 1);
+  EXPECT_EQ(out[1], 1);
+}
+
+TEST_F(VFSFileTests, Write_FlushesWholeSectors) {
+  auto file = volume->OpenWrite(path, buffer);
+  ASSERT_TRUE(file.Seek(100));
+
+  // The first flush is cut short so that later ones start on a sector.
+  std::uint8_t chunk[100] = {};
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_EQ(file.Write(chunk), sizeof(chunk));
+  }
+  EXPECT_EQ(data.writes, 2);
+  EXPECT_EQ(data.files[path].size(), sizeof(buffer) * 2);
+  EXPECT_TRUE(file.Flush());
+  EXPECT_EQ(data.writes, 3);
+  EXPECT_EQ(data.files[path].size(), 2100);
+  EXPECT_TRUE(file.Close());
+  EXPECT_EQ(data.writes, 3);
+}
+
+TEST_F(VFSFileTests, Write_Unbuffered) {
+  auto file = volume->OpenWrite(path);
+  std::uint8_t byte = 1;
+  EXPECT_EQ(file.Write(ConstByteSpan(&byte, 1)), 1);
+  EXPECT_EQ(file.Write(ConstByteSpan(&byte, 1)), 1);
+  EXPECT_EQ(data.writes, 2);
+  EXPECT_EQ(data.files[path].size(), 2);
+}
+
+TEST_F(VFSFileTests, ReadBackPendingWrites) {
+  auto file = volume->OpenWrite(path, buffer);
+  auto bytes = Pattern(10);
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), bytes.size())), 10);
+  EXPECT_EQ(file.Size(), 10);
+
+  std::uint8_t out[10] = {};
+  ASSERT_TRUE(file.Seek(0));
+  EXPECT_EQ(file.Read(out), sizeof(out));
+  EXPECT_EQ(out[9], 9);
+}
+
+TEST_F(VFSFileTests, OpenAppend) {
+  data.files[path] = Pattern(10);
+  data.paths.insert(path);
+  auto file = volume->OpenAppend(path, buffer);
+  EXPECT_EQ(file.Position(), 10);
+
+  std::uint8_t byte = 42;
+  EXPECT_EQ(file.Write(ConstByteSpan(&byte, 1)), 1);
+  EXPECT_TRUE(file.Sync());
+  EXPECT_EQ(data.syncs, 1);
+  ASSERT_EQ(data.files[path].size(), 11);
+  EXPECT_EQ(data.files[path][9], 9);
+  EXPECT_EQ(data.files[path][10], 42);
+}
+
+TEST_F(VFSFileTests, OpenWrite_Truncates) {
+  data.files[path] = Pattern(10);
+  data.paths.insert(path);
+  EXPECT_TRUE(volume->OpenWrite(path).Close());
+  EXPECT_TRUE(data.files[path].empty());
+}
+
+TEST_F(VFSFileTests, Move_FlushesOnce) {
+  std::uint8_t byte = 1;
+  {
+    auto file = volume->OpenWrite(path, buffer);
+    file.Write(ConstByteSpan(&byte, 1));
+    File moved(std::move(file));
+    EXPECT_FALSE(file.IsOpen());
+  }
+  EXPECT_EQ(data.writes, 1);
+  EXPECT_EQ(data.files[path].size(), 1);
+}
+
+TEST_F(VFSFileTests, Remove_DropsContents) {
+  EXPECT_TRUE(volume->OpenWrite(path).Close());
+  EXPECT_TRUE(volume->Remove(path));
+  EXPECT_FALSE(volume->OpenRead(path).IsOpen());
+}
+
+class VFSMappedFileTests : public VFSFileTests {
+protected:
+  void SetUp() override final {
+    data.files[path] = Pattern(File::kSectorSize * 8);
+    data.paths.insert(path);
+  }
+
+  // Walks the whole file in `step` byte views.
+  std::vector<std::uint8_t> Walk(MappedFile &file, std::size_t step) {
+    std::vector<std::uint8_t> out;
+    std::uint64_t offset = 0;
+    while (true) {
+      auto view = file.View(offset, step);
+      if (view.empty()) {
+        break;
+      }
+      out.insert(out.end(), view.begin(), view.end());
+      offset += view.size();
+    }
+    return out;
+  }
+};
+
+TEST_F(VFSMappedFileTests, Missing) {
+  EXPECT_FALSE(volume->Map("/mp/missing.bin", buffer).IsOpen());
+  data.mappable = true;
+  EXPECT_FALSE(volume->Map("/mp/missing.bin", buffer).IsOpen());
+}
+
+TEST_F(VFSMappedFileTests, Mapped) {
+  data.mappable = true;
+  auto file = volume->Map(path);
+  ASSERT_TRUE(file.IsMapped());
+  EXPECT_EQ(file.Size(), data.files[path].size());
+
+  auto view = file.View(10, 3000);
+  EXPECT_EQ(view.data(), data.files[path].data() + 10);
+  EXPECT_EQ(view.size(), 3000);
+  EXPECT_EQ(file.View(file.Size() - 1, 5).size(), 1);
+  EXPECT_TRUE(file.View(file.Size(), 5).empty());
+  EXPECT_EQ(Walk(file, 100), data.files[path]);
+  EXPECT_EQ(data.reads, 0);
+}
+
+TEST_F(VFSMappedFileTests, Paged_NoCache) {
+  EXPECT_FALSE(volume->Map(path).IsOpen());
+}
+
+TEST_F(VFSMappedFileTests, Paged_Walk) {
+  auto file = volume->Map(path, buffer, 2);
+  ASSERT_TRUE(file.IsOpen());
+  EXPECT_FALSE(file.IsMapped());
+  EXPECT_EQ(file.Size(), data.files[path].size());
+
+  // 100 byte views over 512 byte pages: one read per sector.
+  data.reads = 0;
+  EXPECT_EQ(Walk(file, 100), data.files[path]);
+  EXPECT_EQ(data.reads, 8);
+
+  // Views longer than a page are cut short.
+  EXPECT_EQ(file.View(0, 5000).size(), File::kSectorSize);
+  EXPECT_EQ(file.View(10, 5000).size(), File::kSectorSize - 10);
+}
+
+TEST_F(VFSMappedFileTests, Paged_ViewsPointIntoCache) {
+  auto file = volume->Map(path, buffer, 2);
+  auto a = file.View(5, 10);
+  auto b = file.View(File::kSectorSize * 4 + 5, 10);
+  EXPECT_GE(a.data(), buffer);
+  EXPECT_LT(b.data() + b.size(), buffer + sizeof(buffer));
+
+  // With two pages the previous view survives the next call.
+  EXPECT_EQ(a[0], 5);
+  EXPECT_EQ(b[0], static_cast<std::uint8_t>(File::kSectorSize * 4 + 5));
+
+  // Both pages are cached.
+  data.reads = 0;
+  EXPECT_EQ(file.View(6, 4).data(), a.data() + 1);
+  EXPECT_EQ(file.View(File::kSectorSize * 4, 1).data(), b.data() - 5);
+  EXPECT_EQ(data.reads, 0);
+}
+
+class VFSAtomicTests : public ::testing::Test {
+protected:
+  MockVolume::Data data;
+  std::shared_ptr<Volume> volume =
+      Volume::Create(std::make_unique<MockVolume>(data));
+  Path dir = "/mp/dir";
+  Path staging_dir = "/mp/tmp/atomic";
+
+  void SetUp() override final { volume->CreateDirs(dir); }
+
+  static ConstByteSpan Bytes(const char *s) {
+    return ConstByteSpan(reinterpret_cast<const std::uint8_t *>(s),
+                         std::char_traits<char>::length(s));
+  }
+
+  static std::vector<std::uint8_t> Vector(const char *s) {
+    auto bytes = Bytes(s);
+    return std::vector<std::uint8_t>(bytes.begin(), bytes.end());
+  }
+
+  std::size_t StagedFiles() const {
+    std::size_t n = 0;
+    for (const auto &file : data.files) {
+      n += file.first.native().find(staging_dir.native()) == 0;
+    }
+    return n;
+  }
+};
+
+TEST_F(VFSAtomicTests, WriteAtomic) {
+  data.files[dir / "a"] = Vector("old");
+  data.paths.insert(dir / "a");
+  EXPECT_TRUE(volume->WriteAtomic(dir / "a", Bytes("new")));
+  EXPECT_EQ(data.files[dir / "a"], Vector("new"));
+  EXPECT_EQ(StagedFiles(), 0);
+
+  EXPECT_TRUE(volume->WriteAtomic(dir / "b", Bytes("b")));
+  EXPECT_TRUE(volume->Exists(dir / "b"));
+}
+
+TEST_F(VFSAtomicTests, Commit_ThreeFlushesPerBatch) {
+  AtomicBatch batch(*volume);
+  EXPECT_TRUE(batch.Stage(dir / "a", Bytes("a")));
+  EXPECT_TRUE(batch.Stage(dir / "b", Bytes("b")));
+  EXPECT_TRUE(batch.Stage(dir / "c", Bytes("c")));
+  EXPECT_FALSE(volume->Exists(dir / "a"));
+  EXPECT_EQ(data.syncs, 0);
+
+  EXPECT_TRUE(batch.Commit());
+  // Staged files, the manifest, then the renames.
+  EXPECT_EQ(data.syncs, 3);
+  EXPECT_EQ(data.renames, 3);
+  EXPECT_EQ(data.files[dir / "a"], Vector("a"));
+  EXPECT_EQ(data.files[dir / "c"], Vector("c"));
+  EXPECT_EQ(StagedFiles(), 0);
+}
+
+TEST_F(VFSAtomicTests, Abort_LeavesTargets) {
+  data.files[dir / "a"] = Vector("old");
+  data.paths.insert(dir / "a");
+  {
+    AtomicBatch batch(*volume);
+    EXPECT_TRUE(batch.Stage(dir / "a", Bytes("new")));
+    EXPECT_TRUE(batch.Stage(dir / "b", Bytes("new")));
+  }
+  EXPECT_EQ(data.files[dir / "a"], Vector("old"));
+  EXPECT_FALSE(volume->Exists(dir / "b"));
+  EXPECT_EQ(StagedFiles(), 0);
+}
+
+TEST_F(VFSAtomicTests, Recover_DiscardsUncommitted) {
+  data.files[dir / "a"] = Vector("old");
+  data.paths.insert(dir / "a");
+
+  // Power cut after staging, before the commit point.
+  MockVolume::Data crashed;
+  {
+    AtomicBatch batch(*volume);
+    EXPECT_TRUE(batch.Stage(dir / "a", Bytes("new")));
+    crashed = data;
+  }
+
+  auto rebooted = Volume::Create(std::make_unique<MockVolume>(crashed));
+  EXPECT_EQ(rebooted->RecoverAtomicWrites(), 0);
+  EXPECT_EQ(crashed.files[dir / "a"], Vector("old"));
+  EXPECT_FALSE(rebooted->Exists(staging_dir));
+}
+
+TEST_F(VFSAtomicTests, Recover_FinishesCommitted) {
+  // The renames into the missing dir fail after the commit point, which
+  // leaves the card as a power cut would.
+  Path missing = "/mp/missing";
+  AtomicBatch batch(*volume);
+  EXPECT_TRUE(batch.Stage(missing / "a", Bytes("a")));
+  EXPECT_TRUE(batch.Stage(missing / "b", Bytes("b")));
+  EXPECT_FALSE(batch.Commit());
+  EXPECT_EQ(StagedFiles(), 3); // Two files and the manifest.
+
+  MockVolume::Data crashed = data;
+  crashed.files[staging_dir / "1.tmp"][0] ^= 0xFF;
+  auto rebooted = Volume::Create(std::make_unique<MockVolume>(crashed));
+  rebooted->CreateDirs(missing);
+  EXPECT_EQ(rebooted->RecoverAtomicWrites(), 1);
+  EXPECT_EQ(crashed.files[missing / "a"], Vector("a"));
+  // The corrupt staged file is dropped, not renamed.
+  EXPECT_FALSE(rebooted->Exists(missing / "b"));
+  EXPECT_FALSE(rebooted->Exists(staging_dir));
+
+  // The next batch finishes a committed one before reusing the dir.
+  volume->CreateDirs(missing);
+  EXPECT_TRUE(volume->WriteAtomic(dir / "c", Bytes("c")));
+  EXPECT_EQ(data.files[missing / "b"], Vector("b"));
+}
+
+TEST_F(VFSAtomicTests, Commit_KeepsManifestUntilRenamesAreDurable) {
+  AtomicBatch batch(*volume);
+  EXPECT_TRUE(batch.Stage(dir / "a", Bytes("a")));
+  data.volume_syncs_left = 1; // The sync after the renames fails.
+  EXPECT_FALSE(batch.Commit());
+  EXPECT_EQ(data.files[dir / "a"], Vector("a"));
+  EXPECT_TRUE(volume->Exists(staging_dir / "commit.bin"));
+}
+
+TEST_F(VFSAtomicTests, Stage_OneOpenBatchPerVolume) {
+  AtomicBatch first(*volume);
+  EXPECT_TRUE(first.Stage(dir / "a", Bytes("a")));
+
+  // The second batch would share the first one's scratch dir.
+  {
+    AtomicBatch second(*volume);
+    EXPECT_FALSE(second.Stage(dir / "b", Bytes("b")));
+    EXPECT_FALSE(second.Commit());
+  }
+  EXPECT_FALSE(volume->WriteAtomic(dir / "c", Bytes("c")));
+
+  EXPECT_TRUE(first.Stage(dir / "d", Bytes("d")));
+  EXPECT_TRUE(first.Commit());
+  EXPECT_EQ(data.files[dir / "a"], Vector("a"));
+  EXPECT_EQ(data.files[dir / "d"], Vector("d"));
+  EXPECT_FALSE(volume->Exists(dir / "b"));
+  EXPECT_FALSE(volume->Exists(dir / "c"));
+
+  // Committing or aborting closes the batch.
+  EXPECT_TRUE(volume->WriteAtomic(dir / "c", Bytes("c")));
+  {
+    AtomicBatch aborted(*volume);
+    EXPECT_TRUE(aborted.Stage(dir / "e", Bytes("e")));
+    aborted.Abort();
+    EXPECT_TRUE(volume->WriteAtomic(dir / "f", Bytes("f")));
+  }
+  EXPECT_TRUE(volume->WriteAtomic(dir / "g", Bytes("g")));
+}
+
+TEST_F(VFSAtomicTests, Recover_Nothing) {
+  EXPECT_EQ(volume->RecoverAtomicWrites(), 0);
+}
 } // namespace
 } // namespace vfs
 } // namespace cdfw
\ No newline at end of file
@@ -0,0 +1,154 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/volume_stats.h"
+#include "cdfw/core/io_worker.h"
+#include "test/mocks/vfs.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+namespace {
+class Subscriber : public VolumeStatsSubscriber {
+public:
+  virtual void FreeSpaceChanged(const vfs::VolumeStats &stats,
+                                std::size_t level) override final {
+    levels.push_back(level);
+    last = stats;
+  }
+
+  std::vector<std::size_t> levels;
+  vfs::VolumeStats last = {};
+};
+
+class VolumeStatsTests : public testing::Test {
+protected:
+  VolumeStatsTests()
+      : volume(vfs::Volume::Create(std::make_unique<vfs::MockVolume>(data))),
+        worker(IoWorker::Create()),
+        sampler(VolumeStatsSampler::Create(volume, worker, 1000, 100)) {
+    data.capacity = 1000;
+    data.used = 100;
+    sampler->RegisterSubscriber(&subscriber);
+  }
+
+  // Runs a queued refresh to completion, as the UI loop would.
+  void Settle() {
+    worker->Drain();
+    worker->Poll();
+  }
+
+  vfs::MockVolume::Data data;
+  std::shared_ptr<vfs::Volume> volume;
+  std::shared_ptr<IoWorker> worker;
+  std::unique_ptr<VolumeStatsSampler> sampler;
+  Subscriber subscriber;
+};
+
+TEST_F(VolumeStatsTests, FirstTickSamples) {
+  EXPECT_EQ(sampler->Get().capacity, 0u);
+  EXPECT_TRUE(sampler->Tick(0));
+  Settle();
+
+  auto stats = sampler->Get();
+  EXPECT_EQ(stats.capacity, 1000u);
+  EXPECT_EQ(stats.available, 900u);
+  EXPECT_EQ(stats.used, 100u);
+  EXPECT_EQ(subscriber.levels, std::vector<std::size_t>{0});
+}
+
+TEST_F(VolumeStatsTests, ReadsNeverReachTheCard) {
+  sampler->Tick(0);
+  Settle();
+  const auto calls = data.stats_calls;
+  for (int i = 0; i < 100; ++i) {
+    sampler->Get();
+  }
+  EXPECT_EQ(data.stats_calls, calls);
+}
+
+TEST_F(VolumeStatsTests, RefreshesOnInterval) {
+  sampler->Tick(0);
+  Settle();
+  data.used = 200;
+
+  EXPECT_FALSE(sampler->Tick(999));
+  EXPECT_EQ(sampler->Get().used, 100u);
+  EXPECT_TRUE(sampler->Tick(1000));
+  Settle();
+  EXPECT_EQ(sampler->Get().used, 200u);
+}
+
+TEST_F(VolumeStatsTests, RefreshesAfterWrites) {
+  sampler->Tick(0);
+  Settle();
+  EXPECT_FALSE(sampler->Tick(100));
+
+  ASSERT_TRUE(volume->CreateDirs("/mp/dir"));
+  EXPECT_TRUE(sampler->Tick(100));
+  Settle();
+
+  sampler->Invalidate();
+  EXPECT_TRUE(sampler->Tick(101));
+  Settle();
+}
+
+TEST_F(VolumeStatsTests, WriteRefreshesSpacedOut) {
+  sampler->Tick(0);
+  Settle();
+
+  // Writes inside the minimum interval are taken in by one later refresh.
+  ASSERT_TRUE(volume->CreateDirs("/mp/a"));
+  EXPECT_FALSE(sampler->Tick(50));
+  ASSERT_TRUE(volume->CreateDirs("/mp/b"));
+  EXPECT_FALSE(sampler->Tick(99));
+  EXPECT_TRUE(sampler->Tick(100));
+  Settle();
+  EXPECT_FALSE(sampler->Tick(150));
+  EXPECT_FALSE(sampler->Tick(200));
+  EXPECT_EQ(data.stats_calls, 2u);
+}
+
+TEST_F(VolumeStatsTests, OneRefreshInFlight) {
+  EXPECT_TRUE(sampler->Tick(0));
+  EXPECT_FALSE(sampler->Tick(5000));
+  Settle();
+  EXPECT_TRUE(sampler->Tick(5000));
+  Settle();
+}
+
+TEST_F(VolumeStatsTests, NotifiesOnThresholdCrossings) {
+  sampler->SetThresholds({5, 20});
+  sampler->Tick(0);
+  Settle();
+
+  // Still above 20% free: no change.
+  data.used = 750;
+  sampler->Tick(1000);
+  Settle();
+  // Below 20%.
+  data.used = 850;
+  sampler->Tick(2000);
+  Settle();
+  // Below 5%.
+  data.used = 990;
+  sampler->Tick(3000);
+  Settle();
+  // Space freed up again.
+  data.used = 0;
+  sampler->Tick(4000);
+  Settle();
+
+  EXPECT_EQ(subscriber.levels, (std::vector<std::size_t>{0, 1, 2, 0}));
+  EXPECT_EQ(subscriber.last.available, 1000u);
+}
+} // namespace
+} // namespace cdfw
@@ -0,0 +1,218 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/write_back_volume.h"
+#include "cdfw/core/ram_volume.h"
+#include "cdfw/core/vfs.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cdfw {
+namespace vfs {
+namespace {
+class WriteBackVolumeTests : public ::testing::Test {
+protected:
+  void SetUp() override final {
+    ram = RamVolume::Create();
+    ASSERT_TRUE(ram->CreateDirs("/ram/d"));
+    Reset(WriteBackPolicy());
+  }
+
+  void Reset(const WriteBackPolicy &policy) {
+    volume = WriteBackVolume::Create(ram, policy, [this]() { return now; });
+  }
+
+  // Contents of `path` on the wrapped volume.
+  std::vector<std::uint8_t> Backing(const Path &path) {
+    std::vector<std::uint8_t> bytes;
+    auto file = ram->OpenRead(path);
+    bytes.resize(file.Size());
+    file.Read(ByteSpan(bytes.data(), bytes.size()));
+    return bytes;
+  }
+
+  std::vector<std::uint8_t> Read(const Path &path) {
+    std::vector<std::uint8_t> bytes;
+    auto file = volume->OpenRead(path);
+    bytes.resize(file.Size());
+    file.Read(ByteSpan(bytes.data(), bytes.size()));
+    return bytes;
+  }
+
+  std::shared_ptr<Volume> ram;
+  std::shared_ptr<WriteBackVolume> volume;
+  std::uint32_t now = 0;
+};
+
+TEST_F(WriteBackVolumeTests, CoalescesAppends) {
+  std::vector<std::uint8_t> expected;
+  for (std::uint8_t i = 0; i < 100; ++i) {
+    const std::uint8_t bytes[] = {i, i};
+    auto file = volume->OpenAppend("/ram/d/log");
+    EXPECT_EQ(file.Write(bytes), 2u);
+    EXPECT_TRUE(file.Close());
+    expected.insert(expected.end(), bytes, bytes + 2);
+  }
+
+  // The file exists, but nothing has been written to it yet.
+  EXPECT_TRUE(ram->Exists("/ram/d/log"));
+  EXPECT_TRUE(Backing("/ram/d/log").empty());
+  EXPECT_EQ(Read("/ram/d/log"), expected);
+
+  EXPECT_TRUE(volume->Sync());
+  EXPECT_EQ(Backing("/ram/d/log"), expected);
+  auto stats = volume->GetStats();
+  EXPECT_EQ(stats.absorbed, 200u);
+  EXPECT_EQ(stats.written, 200u);
+  EXPECT_EQ(stats.writes, 100u);
+  EXPECT_EQ(stats.flushes, 1u);
+  EXPECT_EQ(stats.dirty, 0u);
+}
+
+TEST_F(WriteBackVolumeTests, OverwritesMerge) {
+  for (std::uint8_t i = 0; i < 50; ++i) {
+    const std::uint8_t bytes[] = {i, i, i, i};
+    auto file = volume->OpenWrite("/ram/d/setting");
+    EXPECT_EQ(file.Write(bytes), 4u);
+    EXPECT_TRUE(file.Close());
+  }
+  EXPECT_TRUE(volume->Flush());
+  EXPECT_EQ(Backing("/ram/d/setting"),
+            (std::vector<std::uint8_t>{49, 49, 49, 49}));
+  auto stats = volume->GetStats();
+  EXPECT_EQ(stats.absorbed, 200u);
+  EXPECT_EQ(stats.written, 4u);
+}
+
+TEST_F(WriteBackVolumeTests, ReadsOverlayDirtyRanges) {
+  const std::uint8_t base[] = {1, 2, 3, 4, 5, 6};
+  ASSERT_TRUE(ram->WriteAtomic("/ram/d/f", base));
+
+  const std::uint8_t patch[] = {9, 9};
+  auto file = volume->OpenAppend("/ram/d/f");
+  ASSERT_TRUE(file.Seek(2));
+  EXPECT_EQ(file.Write(patch), 2u);
+  ASSERT_TRUE(file.Seek(7));
+  EXPECT_EQ(file.Write(patch), 2u);
+  EXPECT_TRUE(file.Close());
+
+  const std::vector<std::uint8_t> expected = {1, 2, 9, 9, 5, 6, 0, 9, 9};
+  EXPECT_EQ(Read("/ram/d/f"), expected);
+  EXPECT_TRUE(volume->Sync());
+  EXPECT_EQ(Backing("/ram/d/f"), expected);
+}
+
+TEST_F(WriteBackVolumeTests, TruncationIsDeferred) {
+  const std::uint8_t base[] = {1, 2, 3, 4, 5, 6};
+  ASSERT_TRUE(ram->WriteAtomic("/ram/d/f", base));
+
+  const std::uint8_t bytes[] = {7};
+  auto file = volume->OpenWrite("/ram/d/f");
+  EXPECT_EQ(file.Size(), 0u);
+  EXPECT_EQ(file.Write(bytes), 1u);
+  EXPECT_TRUE(file.Close());
+  EXPECT_EQ(Backing("/ram/d/f").size(), 6u);
+  EXPECT_EQ(Read("/ram/d/f"), std::vector<std::uint8_t>{7});
+
+  EXPECT_TRUE(volume->Sync());
+  EXPECT_EQ(Backing("/ram/d/f"), std::vector<std::uint8_t>{7});
+}
+
+TEST_F(WriteBackVolumeTests, FlushesOnSize) {
+  WriteBackPolicy policy;
+  policy.max_dirty_bytes = 64;
+  Reset(policy);
+
+  std::vector<std::uint8_t> bytes(40, 1);
+  auto file = volume->OpenWrite("/ram/d/a");
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), bytes.size())), 40u);
+  EXPECT_TRUE(file.Flush());
+  EXPECT_EQ(volume->GetStats().written, 0u);
+  EXPECT_EQ(file.Write(ConstByteSpan(bytes.data(), bytes.size())), 40u);
+  EXPECT_TRUE(file.Flush());
+  EXPECT_EQ(volume->GetStats().written, 80u);
+  EXPECT_EQ(volume->GetStats().dirty, 0u);
+}
+
+TEST_F(WriteBackVolumeTests, FlushesOnAge) {
+  const std::uint8_t bytes[] = {1};
+  EXPECT_TRUE(volume->WriteAtomic("/ram/d/a", bytes));
+  auto file = volume->OpenAppend("/ram/d/a");
+  EXPECT_EQ(file.Write(bytes), 1u);
+  EXPECT_TRUE(file.Close());
+  EXPECT_FALSE(volume->FlushDue());
+
+  now = WriteBackPolicy().max_age_ms;
+  EXPECT_TRUE(volume->FlushDue());
+  EXPECT_TRUE(volume->Flush());
+  EXPECT_FALSE(volume->FlushDue());
+  EXPECT_EQ(Backing("/ram/d/a"), (std::vector<std::uint8_t>{1, 1}));
+}
+
+TEST_F(WriteBackVolumeTests, FileSyncWritesOut) {
+  const std::uint8_t bytes[] = {1, 2};
+  auto other = volume->OpenWrite("/ram/d/other");
+  EXPECT_EQ(other.Write(bytes), 2u);
+  EXPECT_TRUE(other.Close());
+
+  auto file = volume->OpenWrite("/ram/d/a");
+  EXPECT_EQ(file.Write(bytes), 2u);
+  EXPECT_TRUE(file.Sync());
+  EXPECT_EQ(Backing("/ram/d/a").size(), 2u);
+  EXPECT_TRUE(Backing("/ram/d/other").empty());
+}
+
+TEST_F(WriteBackVolumeTests, RemoveDiscards) {
+  const std::uint8_t bytes[] = {1, 2};
+  auto file = volume->OpenWrite("/ram/d/a");
+  EXPECT_EQ(file.Write(bytes), 2u);
+  EXPECT_TRUE(file.Close());
+
+  EXPECT_TRUE(volume->RemoveAll("/ram/d"));
+  EXPECT_EQ(volume->GetStats().dirty, 0u);
+  EXPECT_TRUE(volume->Sync());
+  EXPECT_EQ(volume->GetStats().written, 0u);
+  EXPECT_FALSE(ram->Exists("/ram/d"));
+}
+
+TEST_F(WriteBackVolumeTests, RenameWritesOut) {
+  const std::uint8_t bytes[] = {1, 2};
+  auto file = volume->OpenWrite("/ram/d/a");
+  EXPECT_EQ(file.Write(bytes), 2u);
+  EXPECT_TRUE(file.Close());
+
+  EXPECT_TRUE(volume->Rename("/ram/d/a", "/ram/d/b"));
+  EXPECT_EQ(Backing("/ram/d/b"), (std::vector<std::uint8_t>{1, 2}));
+  EXPECT_EQ(Read("/ram/d/b"), (std::vector<std::uint8_t>{1, 2}));
+}
+
+TEST_F(WriteBackVolumeTests, HandleOnRenamedFileFails) {
+  const std::uint8_t bytes[] = {1, 2};
+  auto file = volume->OpenWrite("/ram/d/a");
+  EXPECT_EQ(file.Write(bytes), 2u);
+
+  EXPECT_TRUE(volume->Rename("/ram/d/a", "/ram/d/b"));
+  EXPECT_EQ(file.Write(bytes), 0u);
+  EXPECT_FALSE(file.Sync());
+  EXPECT_EQ(volume->GetStats().dirty, 0u);
+  EXPECT_EQ(Backing("/ram/d/b"), (std::vector<std::uint8_t>{1, 2}));
+}
+
+TEST_F(WriteBackVolumeTests, AtomicWrites) {
+  ASSERT_TRUE(volume->CreateDirs(volume->TempDir()));
+  const std::uint8_t bytes[] = {1, 2, 3};
+  EXPECT_TRUE(volume->WriteAtomic("/ram/d/a", bytes));
+  EXPECT_EQ(Backing("/ram/d/a"), (std::vector<std::uint8_t>{1, 2, 3}));
+  EXPECT_EQ(volume->GetStats().dirty, 0u);
+}
+} // namespace
+} // namespace vfs
+} // namespace cdfw
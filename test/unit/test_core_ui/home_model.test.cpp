@@ -5,6 +5,7 @@
 // Local Headers
 #include "cdfw/core/ui/home_model.h"
 #include "cdfw/core/ui/settings_model.h"
+#include "test/support/alloc_tracker.h"
 
 // Third Party Headers
 #include <gtest/gtest.h>
@@ -13,6 +14,12 @@ namespace cdfw {
 namespace core {
 namespace ui {
 namespace {
+class CountingSubscriber : public HomeModelSubscriber {
+public:
+  int notifications = 0;
+  virtual void WifiStateChanged() override final { ++notifications; }
+};
+
 TEST(HomeModelTests, DefaultState) {
   auto settings_model = SettingsModel::Create();
   auto home_model = HomeModel::Create(settings_model);
@@ -32,6 +39,21 @@ TEST(HomeModelTests, ReflectsSettingsState) {
   settings_model->SetWifiState(WifiState::DISABLED_);
   EXPECT_EQ(home_model->GetWifiState(), WifiState::DISABLED_);
 }
+
+TEST(HomeModelTests, WifiStateChanged_DoesNotAllocate) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  auto settings_model = SettingsModel::Create();
+  auto home_model = HomeModel::Create(settings_model);
+  home_model->Init();
+  CountingSubscriber subscriber;
+  home_model->RegisterSubscriber(&subscriber);
+
+  test::AllocationCounter counter;
+  settings_model->SetWifiState(WifiState::CONNECTED);
+  home_model->WifiStateChanged();
+  EXPECT_EQ(counter.Allocations(), 0);
+  EXPECT_EQ(subscriber.notifications, 2);
+}
 } // namespace
 } // namespace ui
 } // namespace core
@@ -66,8 +66,8 @@ class MockHomeView : public HomePresenterView {
 public:
   struct Data {
     bool init_called;
+    bool destroy_called;
     bool show_called;
-    bool delayed_show_called;
     bool set_wifi_color_called;
     bool set_wifi_visible_called;
     bool wifi_visible;
@@ -77,8 +77,8 @@ public:
 
     void Reset() {
       init_called = false;
+      destroy_called = false;
       show_called = false;
-      delayed_show_called = false;
       set_wifi_color_called = false;
       set_wifi_visible_called = false;
       wifi_visible = true;
@@ -92,10 +92,8 @@ public:
   virtual void Init(HomePresenter *presenter) override final {
     data_.init_called = true;
   }
+  virtual void Destroy() override final { data_.destroy_called = true; }
   virtual void Show() override final { data_.show_called = true; }
-  virtual void DelayedShow() override final {
-    data_.delayed_show_called = true;
-  }
   virtual void SetWifiColor(const lv_color_t &color) override final {
     data_.set_wifi_color_called = true;
     data_.wifi_color = color;
@@ -115,7 +113,6 @@ public:
 
   virtual void Init() override final {}
   virtual void ShowHome() override final {}
-  virtual void ShowHomeDelayed() override final {}
   virtual void ShowClean() override final {}
   virtual void ShowRoutines() override final {}
   virtual void ShowSettings() override final {}
@@ -148,7 +145,6 @@ TEST_F(HomePresenterTests, InitNotCalled) {
   // Assertions for the view.
   EXPECT_FALSE(view_data.init_called);
   EXPECT_FALSE(view_data.show_called);
-  EXPECT_FALSE(view_data.delayed_show_called);
   EXPECT_FALSE(view_data.set_wifi_color_called);
   EXPECT_FALSE(view_data.set_wifi_visible_called);
   EXPECT_TRUE(view_data.wifi_visible);
@@ -169,7 +165,6 @@ TEST_F(HomePresenterTests, InitCalled) {
   // Assertions for the view.
   EXPECT_TRUE(view_data.init_called);
   EXPECT_FALSE(view_data.show_called);
-  EXPECT_FALSE(view_data.delayed_show_called);
   EXPECT_TRUE(view_data.set_wifi_color_called);
   EXPECT_TRUE(view_data.set_wifi_visible_called);
   EXPECT_TRUE(view_data.wifi_visible);
@@ -248,6 +243,28 @@ TEST_F(HomePresenterTests, UpdateWifiIcon) {
   EXPECT_TRUE(view_data.wifi_visible);
   EXPECT_EQ(lv_color_to_u16(view_data.wifi_color), wifi_colors.disconnected);
 }
+
+TEST_F(HomePresenterTests, DestroyAndRebuild) {
+  presenter->Init(app_presenter.get());
+  presenter->Destroy();
+  EXPECT_TRUE(view_data.destroy_called);
+
+  // A destroyed view is left alone.
+  view_data.Reset();
+  model_data.wifi_state = WifiState::CONNECTED;
+  model_data.subscriber->WifiStateChanged();
+  EXPECT_FALSE(view_data.set_wifi_color_called);
+  EXPECT_FALSE(view_data.set_wifi_visible_called);
+
+  // Rebuilding brings the view up to date, without setting up the model again.
+  model_data.init_called = false;
+  model_data.register_subscriber_called = false;
+  presenter->Init(app_presenter.get());
+  EXPECT_TRUE(view_data.init_called);
+  EXPECT_EQ(lv_color_to_u16(view_data.wifi_color), wifi_colors.connected);
+  EXPECT_FALSE(model_data.init_called);
+  EXPECT_FALSE(model_data.register_subscriber_called);
+}
 } // namespace
 } // namespace ui
 } // namespace core
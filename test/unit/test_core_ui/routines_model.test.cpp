@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/ui/routines_model.h"
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/routine.h"
+#include "cdfw/core/routine_store.h"
+#include "test/mocks/routine_store.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cdfw {
+namespace core {
+namespace ui {
+namespace {
+class Subscriber : public RoutinesModelSubscriber {
+public:
+  virtual void RoutinesChanged() override final { ++notifications; }
+  int notifications = 0;
+};
+
+TEST(RoutinesModelTests, Empty) {
+  MockRoutineStoreFiles::Data data;
+  std::shared_ptr<RoutineStore> store = RoutineStore::Create(
+      "/routines", std::make_shared<MockRoutineStoreFiles>(data));
+  store->Load();
+  std::shared_ptr<IoWorker> worker = IoWorker::Create();
+  auto model = RoutinesModel::Create(store, worker);
+
+  EXPECT_TRUE(model->GetRoutineNames().empty());
+}
+
+TEST(RoutinesModelTests, ReflectsStore) {
+  MockRoutineStoreFiles::Data data;
+  std::shared_ptr<RoutineStore> store = RoutineStore::Create(
+      "/routines", std::make_shared<MockRoutineStoreFiles>(data));
+  store->Load();
+  Routine routine = Routine::GetDefault();
+  store->Put(routine);
+  routine.name = "Custom";
+  store->Put(routine);
+
+  std::shared_ptr<IoWorker> worker = IoWorker::Create();
+  auto model = RoutinesModel::Create(store, worker);
+  EXPECT_EQ(model->GetRoutineNames(),
+            (std::vector<std::string>{"Default", "Custom"}));
+}
+
+TEST(RoutinesModelTests, SaveRoutine) {
+  MockRoutineStoreFiles::Data data;
+  std::shared_ptr<RoutineStore> store = RoutineStore::Create(
+      "/routines", std::make_shared<MockRoutineStoreFiles>(data));
+  store->Load();
+  std::shared_ptr<IoWorker> worker = IoWorker::Create();
+  auto model = RoutinesModel::Create(store, worker);
+  Subscriber subscriber;
+  model->RegisterSubscriber(&subscriber);
+
+  const auto commits = data.commits;
+  ASSERT_TRUE(model->SaveRoutine(Routine::GetDefault()));
+  worker->Drain();
+  EXPECT_EQ(data.commits, commits + 1);
+
+  // The names change on the UI loop, when the completion is polled.
+  EXPECT_TRUE(model->GetRoutineNames().empty());
+  EXPECT_EQ(subscriber.notifications, 0);
+  worker->Poll();
+  EXPECT_EQ(model->GetRoutineNames(), std::vector<std::string>{"Default"});
+  EXPECT_EQ(subscriber.notifications, 1);
+}
+} // namespace
+} // namespace ui
+} // namespace core
+} // namespace cdfw
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/ui/run_stats_model.h"
+#include "cdfw/core/io_worker.h"
+#include "cdfw/core/run_log.h"
+#include "cdfw/core/run_stats.h"
+#include "test/mocks/vfs.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <memory>
+
+namespace cdfw {
+namespace core {
+namespace ui {
+namespace {
+class Subscriber : public RunStatsModelSubscriber {
+public:
+  virtual void RunStatsChanged() override final { ++notifications; }
+  virtual void CsvExported(bool ok) override final { exported = ok; }
+  int notifications = 0;
+  bool exported = false;
+};
+
+class RunStatsModelTests : public ::testing::Test {
+protected:
+  vfs::MockVolume::Data data;
+  std::shared_ptr<vfs::Volume> volume =
+      std::make_shared<vfs::MockVolume>(data);
+  std::shared_ptr<RunLog> log = RunLog::Create(volume, vfs::Path("/runs"));
+  std::shared_ptr<RunStats> stats = RunStats::Create(volume, "/stats");
+  std::shared_ptr<IoWorker> worker = IoWorker::Create();
+
+  void SetUp() override final {
+    ASSERT_TRUE(log->Load());
+    ASSERT_TRUE(stats->Load());
+  }
+};
+
+TEST_F(RunStatsModelTests, Empty) {
+  auto model = RunStatsModel::Create(log, stats, worker);
+  EXPECT_TRUE(model->GetRoutineStats().empty());
+}
+
+TEST_F(RunStatsModelTests, RecordRun) {
+  auto model = RunStatsModel::Create(log, stats, worker);
+  Subscriber subscriber;
+  model->RegisterSubscriber(&subscriber);
+
+  RunRecord run{};
+  run.routine_id = 4;
+  run.start_time = 1000;
+  run.end_time = 1600;
+  ASSERT_TRUE(model->RecordRun(run));
+  worker->Drain();
+  EXPECT_EQ(log->Count(), 1);
+
+  // The stats change on the UI loop, when the completion is polled.
+  EXPECT_TRUE(model->GetRoutineStats().empty());
+  EXPECT_EQ(subscriber.notifications, 0);
+  worker->Poll();
+  auto routines = model->GetRoutineStats();
+  ASSERT_EQ(routines.size(), 1);
+  EXPECT_EQ(routines[0].routine_id, 4);
+  EXPECT_EQ(routines[0].runs, 1);
+  EXPECT_EQ(subscriber.notifications, 1);
+}
+
+TEST_F(RunStatsModelTests, ExportCsv) {
+  auto model = RunStatsModel::Create(log, stats, worker);
+  Subscriber subscriber;
+  model->RegisterSubscriber(&subscriber);
+
+  ASSERT_TRUE(model->ExportCsv("/stats/export.csv"));
+  worker->Drain();
+  worker->Poll();
+  EXPECT_TRUE(subscriber.exported);
+  EXPECT_TRUE(data.files.count("/stats/export.csv"));
+}
+} // namespace
+} // namespace ui
+} // namespace core
+} // namespace cdfw
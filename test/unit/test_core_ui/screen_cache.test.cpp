@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "cdfw/core/ui/screen_cache.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <memory>
+
+namespace cdfw {
+namespace core {
+namespace ui {
+namespace {
+// A screen that takes `size` bytes of a fake heap while it is built.
+class FakeScreen : public CachedScreen {
+public:
+  FakeScreen(std::size_t &heap, std::size_t size) : heap_(heap), size_(size) {}
+
+  virtual void Build() override final {
+    heap_ += size_;
+    ++builds;
+  }
+  virtual void Destroy() override final {
+    heap_ -= size_;
+    ++destroys;
+  }
+
+  int builds = 0;
+  int destroys = 0;
+
+private:
+  std::size_t &heap_;
+  const std::size_t size_;
+};
+
+class ScreenCacheTests : public ::testing::Test {
+protected:
+  std::size_t heap = 1000;
+  std::unique_ptr<ScreenCache> cache =
+      ScreenCache::Create(100, [this]() { return heap; });
+  FakeScreen a{heap, 40};
+  FakeScreen b{heap, 40};
+  FakeScreen c{heap, 40};
+};
+
+TEST_F(ScreenCacheTests, Use_BuildsOnce) {
+  EXPECT_FALSE(cache->IsBuilt(&a));
+  cache->Use(&a);
+  cache->Use(&a);
+  EXPECT_TRUE(cache->IsBuilt(&a));
+  EXPECT_EQ(a.builds, 1);
+  EXPECT_EQ(cache->Bytes(), 40);
+}
+
+TEST_F(ScreenCacheTests, Trim_DestroysLeastRecentlyUsed) {
+  cache->Use(&a);
+  cache->Use(&b);
+  cache->Use(&a);
+  cache->Use(&c);
+  cache->Trim();
+
+  EXPECT_EQ(b.destroys, 1);
+  EXPECT_FALSE(cache->IsBuilt(&b));
+  EXPECT_TRUE(cache->IsBuilt(&a));
+  EXPECT_TRUE(cache->IsBuilt(&c));
+  EXPECT_EQ(cache->Bytes(), 80);
+  EXPECT_EQ(heap, 1080);
+
+  // A destroyed screen is rebuilt when used again.
+  cache->Use(&b);
+  EXPECT_EQ(b.builds, 2);
+}
+
+TEST_F(ScreenCacheTests, Trim_KeepsTheMostRecentlyUsed) {
+  FakeScreen big(heap, 500);
+  cache->Use(&a);
+  cache->Use(&big);
+  cache->Trim();
+
+  EXPECT_EQ(a.destroys, 1);
+  EXPECT_TRUE(cache->IsBuilt(&big));
+  EXPECT_EQ(cache->Bytes(), 500);
+}
+} // namespace
+} // namespace ui
+} // namespace core
+} // namespace cdfw
@@ -63,6 +63,7 @@ class MockSettingsView : public SettingsPresenterView {
 public:
   struct Data {
     bool init_called = false;
+    bool destroy_called = false;
     bool show_called = false;
     bool set_wifi_enabled_called = false;
     bool set_wifi_credentials_called = false;
@@ -79,6 +80,8 @@ public:
     data_.init_called = true;
   }
 
+  virtual void Destroy() override final { data_.destroy_called = true; }
+
   virtual void Show() override final { data_.show_called = true; }
 
   virtual void SetWifiEnabled(bool enabled) override final {
@@ -107,7 +110,6 @@ public:
 
   virtual void Init() override final {}
   virtual void ShowHome() override final {}
-  virtual void ShowHomeDelayed() override final {}
   virtual void ShowClean() override final {}
   virtual void ShowRoutines() override final {}
   virtual void ShowSettings() override final {}
@@ -247,6 +249,25 @@ TEST_F(SettingsPresenterTests, ShowCalled) {
 
   EXPECT_TRUE(view_data.show_called);
 }
+
+TEST_F(SettingsPresenterTests, DestroyAndRebuild) {
+  presenter->Init(app_presenter.get());
+  presenter->Destroy();
+  EXPECT_TRUE(view_data.destroy_called);
+
+  // A destroyed view is left alone, and brought up to date when rebuilt.
+  view_data = MockSettingsView::Data();
+  model->SetWifiState(WifiState::CONNECTED);
+  EXPECT_FALSE(view_data.set_wifi_status_called);
+  presenter->Init(app_presenter.get());
+  EXPECT_TRUE(view_data.init_called);
+  EXPECT_EQ(view_data.wifi_status, "Connected");
+
+  // Rebuilding does not subscribe twice.
+  view_data = MockSettingsView::Data();
+  model->SetWifiState(WifiState::DISABLED_);
+  EXPECT_EQ(view_data.wifi_status, "Disabled");
+}
 } // namespace
 } // namespace ui
 } // namespace core
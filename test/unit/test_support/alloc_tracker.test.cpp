@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Ian Dinwoodie. All rights reserved.
+// Use of this source code is governed by a GPLv3 license that can be found in
+// the LICENSE file.
+
+// Local Headers
+#include "test/support/alloc_tracker.h"
+
+// Third Party Headers
+#include <gtest/gtest.h>
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace cdfw {
+namespace test {
+namespace {
+TEST(AllocationCounterTests, CountsNewAndDelete) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  AllocationCounter counter;
+  EXPECT_EQ(counter.Allocations(), 0);
+
+  auto value = std::make_unique<int>(1);
+  EXPECT_EQ(counter.Allocations(), 1);
+  EXPECT_GE(counter.Bytes(), sizeof(int));
+  EXPECT_EQ(counter.Frees(), 0);
+
+  value.reset();
+  EXPECT_EQ(counter.Frees(), 1);
+
+  counter.Reset();
+  EXPECT_EQ(counter.Allocations(), 0);
+  EXPECT_EQ(counter.Frees(), 0);
+}
+
+TEST(AllocationCounterTests, Nested) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  AllocationCounter outer;
+  std::vector<int> values(4);
+  {
+    AllocationCounter inner;
+    auto value = std::make_unique<int>(1);
+    EXPECT_EQ(inner.Allocations(), 1);
+  }
+  EXPECT_EQ(outer.Allocations(), 2);
+}
+
+TEST(AllocationCounterTests, IgnoresOtherThreads) {
+  SKIP_WITHOUT_ALLOC_TRACKING();
+  // Start the thread before counting; creating it allocates on this thread.
+  std::unique_ptr<int> value;
+  std::atomic<bool> go(false);
+  std::thread thread([&] {
+    while (!go) {
+      std::this_thread::yield();
+    }
+    value = std::make_unique<int>(1);
+  });
+
+  AllocationCounter counter;
+  go = true;
+  thread.join();
+  EXPECT_NE(value, nullptr);
+  EXPECT_EQ(counter.Allocations(), 0);
+}
+} // namespace
+} // namespace test
+} // namespace cdfw